@@ -221,7 +221,7 @@ void Channel::setPreset(Preset* p)
       {
       if (_preset != p) {
             if (p)
-                  p->loadSamples();
+                  p->loadSamples(!synth->realtime());
             _preset = p;
             }
       }
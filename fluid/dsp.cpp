@@ -46,16 +46,18 @@ namespace FluidS {
  * - dsp_buf: Output buffer of floating point values (FLUID_BUFSIZE in length)
  */
 
-inline bool Voice::updateAmpInc(unsigned int &nextNewAmpInc, std::map<int, qreal>::iterator &curSample2AmpInc, qreal &dsp_amp_incr, unsigned int &dsp_i)
+inline bool Voice::updateAmpInc(float dsp_amp, unsigned int &nextNewAmpInc, AmpIncs::iterator &curSample2AmpInc, qreal &dsp_amp_incr, unsigned int &dsp_i)
       {
       if (positionToTurnOff > 0 && dsp_i >= (unsigned int) positionToTurnOff)
             return false;
 
       // if volume is zero skip all phases that do not change that!
-      if (amp == 0.0f) {
+      if (dsp_amp == 0.0f) {
             while (dsp_amp_incr == 0.0f && curSample2AmpInc != Sample2AmpInc.end()) {
                   dsp_i = curSample2AmpInc->first;
                   curSample2AmpInc++;
+                  if (curSample2AmpInc == Sample2AmpInc.end())
+                        return false;
                   nextNewAmpInc = curSample2AmpInc->first;
                   dsp_amp_incr = curSample2AmpInc->second;
                   }
@@ -65,6 +67,8 @@ inline bool Voice::updateAmpInc(unsigned int &nextNewAmpInc, std::map<int, qreal
 
       if (dsp_i >= nextNewAmpInc) {
             curSample2AmpInc++;
+            if (curSample2AmpInc == Sample2AmpInc.end())
+                  return false;
             nextNewAmpInc = curSample2AmpInc->first;
             dsp_amp_incr = curSample2AmpInc->second;
             }
@@ -150,6 +154,8 @@ int Voice::dsp_float_interpolate_none(unsigned n)
       qreal dsp_amp_incr = curSample2AmpInc->second;
       unsigned int nextNewAmpInc = curSample2AmpInc->first;
       unsigned int dsp_i = 0;
+      float dsp_amp = amp;
+      float* buf = dsp_buf.data();
       unsigned int dsp_phase_index;
       unsigned int end_index;
       int looping;
@@ -169,14 +175,16 @@ int Voice::dsp_float_interpolate_none(unsigned n)
 
             /* interpolate sequence of sample points */
             for ( ; dsp_i < n && dsp_phase_index <= end_index; dsp_i++) {
-                  dsp_buf[dsp_i] = amp * dsp_data[dsp_phase_index];
+                  buf[dsp_i] = dsp_amp * dsp_data[dsp_phase_index];
 
                   /* increment phase and amplitude */
                   dsp_phase += dsp_phase_incr;
                   dsp_phase_index = dsp_phase.index_round();	/* round to nearest point */
-                  if (!updateAmpInc(nextNewAmpInc, curSample2AmpInc, dsp_amp_incr, dsp_i))
+                  if (!updateAmpInc(dsp_amp, nextNewAmpInc, curSample2AmpInc, dsp_amp_incr, dsp_i)) {
+                        amp = dsp_amp;
                         return dsp_i;
-                  amp += dsp_amp_incr;
+                        }
+                  dsp_amp += dsp_amp_incr;
                   }
 
             /* break out if not looping (buffer may not be full) */
@@ -195,6 +203,7 @@ int Voice::dsp_float_interpolate_none(unsigned n)
             }
 
       voice->phase = dsp_phase;
+      amp = dsp_amp;
       return dsp_i;
       }
 
@@ -215,6 +224,8 @@ int Voice::dsp_float_interpolate_linear(unsigned n)
       qreal dsp_amp_incr = curSample2AmpInc->second;
       unsigned int nextNewAmpInc = curSample2AmpInc->first;
       unsigned int dsp_i = 0;
+      float dsp_amp = amp;
+      float* buf = dsp_buf.data();
       unsigned int dsp_phase_index;
       unsigned int end_index;
       short int point;
@@ -244,15 +255,17 @@ int Voice::dsp_float_interpolate_linear(unsigned n)
             /* interpolate the sequence of sample points */
             for ( ; dsp_i < n && dsp_phase_index <= end_index; dsp_i++) {
                   coeffs = interp_coeff_linear[fluid_phase_fract_to_tablerow (dsp_phase)];
-                  dsp_buf[dsp_i] = amp * (coeffs[0] * dsp_data[dsp_phase_index]
+                  buf[dsp_i] = dsp_amp * (coeffs[0] * dsp_data[dsp_phase_index]
 				  + coeffs[1] * dsp_data[dsp_phase_index+1]);
 
                   /* increment phase and amplitude */
                   dsp_phase += dsp_phase_incr;
                   dsp_phase_index = dsp_phase.index();
-                  if (!updateAmpInc(nextNewAmpInc, curSample2AmpInc, dsp_amp_incr, dsp_i))
+                  if (!updateAmpInc(dsp_amp, nextNewAmpInc, curSample2AmpInc, dsp_amp_incr, dsp_i)) {
+                        amp = dsp_amp;
                         return dsp_i;
-                  amp += dsp_amp_incr;
+                        }
+                  dsp_amp += dsp_amp_incr;
                   }
 
             /* break out if buffer filled */
@@ -264,15 +277,17 @@ int Voice::dsp_float_interpolate_linear(unsigned n)
             /* interpolate within last point */
             for (; dsp_phase_index <= end_index && dsp_i < n; dsp_i++) {
                   coeffs = interp_coeff_linear[fluid_phase_fract_to_tablerow (dsp_phase)];
-                  dsp_buf[dsp_i] = amp * (coeffs[0] * dsp_data[dsp_phase_index]
+                  buf[dsp_i] = dsp_amp * (coeffs[0] * dsp_data[dsp_phase_index]
                      + coeffs[1] * point);
 
                   /* increment phase and amplitude */
                   dsp_phase += dsp_phase_incr;
                   dsp_phase_index = dsp_phase.index();
-                  if (!updateAmpInc(nextNewAmpInc, curSample2AmpInc, dsp_amp_incr, dsp_i))
+                  if (!updateAmpInc(dsp_amp, nextNewAmpInc, curSample2AmpInc, dsp_amp_incr, dsp_i)) {
+                        amp = dsp_amp;
                         return dsp_i;
-                  amp += dsp_amp_incr;	/* increment amplitude */
+                        }
+                  dsp_amp += dsp_amp_incr;	/* increment amplitude */
                   }
 
             if (!looping)
@@ -291,6 +306,7 @@ int Voice::dsp_float_interpolate_linear(unsigned n)
             }
 
       voice->phase = dsp_phase;
+      amp = dsp_amp;
       return dsp_i;
       }
 
@@ -303,12 +319,15 @@ int Voice::dsp_float_interpolate_linear(unsigned n)
 
 int Voice::dsp_float_interpolate_4th_order(unsigned n)
       {
+      Phase dsp_phase = phase;
       Phase dsp_phase_incr; // end_phase;
       short int* dsp_data = sample->data;
       auto curSample2AmpInc = Sample2AmpInc.begin();
       qreal dsp_amp_incr = curSample2AmpInc->second;
       unsigned int nextNewAmpInc = curSample2AmpInc->first;
       unsigned int dsp_i  = 0;
+      float dsp_amp = amp;
+      float* buf = dsp_buf.data();
       unsigned int dsp_phase_index;
       unsigned int start_index;
       short int start_point, end_point1, end_point2;
@@ -345,40 +364,46 @@ int Voice::dsp_float_interpolate_4th_order(unsigned n)
             }
 
       while (1) {
-            dsp_phase_index = phase.index();
+            dsp_phase_index = dsp_phase.index();
 
             /* interpolate first sample point (start or loop start) if needed */
             for ( ; dsp_phase_index == start_index && dsp_i < n; dsp_i++) {
-                  coeffs = interp_coeff[fluid_phase_fract_to_tablerow (phase)];
-                  auto val = amp * (coeffs[0] * start_point
+                  coeffs = interp_coeff[fluid_phase_fract_to_tablerow (dsp_phase)];
+                  auto val = dsp_amp * (coeffs[0] * start_point
                                     + coeffs[1] * dsp_data[dsp_phase_index]
                                     + coeffs[2] * dsp_data[dsp_phase_index+1]
                                     + coeffs[3] * dsp_data[dsp_phase_index+2]);
-                  dsp_buf[dsp_i] = val;
+                  buf[dsp_i] = val;
 
                   /* increment phase and amplitude */
-                  phase += dsp_phase_incr;
-                  dsp_phase_index = phase.index();
-                  if (!updateAmpInc(nextNewAmpInc, curSample2AmpInc, dsp_amp_incr, dsp_i))
+                  dsp_phase += dsp_phase_incr;
+                  dsp_phase_index = dsp_phase.index();
+                  if (!updateAmpInc(dsp_amp, nextNewAmpInc, curSample2AmpInc, dsp_amp_incr, dsp_i)) {
+                        phase = dsp_phase;
+                        amp   = dsp_amp;
                         return dsp_i;
-                  amp += dsp_amp_incr;
+                        }
+                  dsp_amp += dsp_amp_incr;
                   }
 
             /* interpolate the sequence of sample points */
             for ( ; dsp_i < n && dsp_phase_index <= end_index; dsp_i++) {
-                  coeffs = interp_coeff[fluid_phase_fract_to_tablerow (phase)];
-                  auto val = amp * (coeffs[0] * dsp_data[dsp_phase_index-1]
+                  coeffs = interp_coeff[fluid_phase_fract_to_tablerow (dsp_phase)];
+                  auto val = dsp_amp * (coeffs[0] * dsp_data[dsp_phase_index-1]
                                    + coeffs[1] * dsp_data[dsp_phase_index]
                                    + coeffs[2] * dsp_data[dsp_phase_index+1]
                                    + coeffs[3] * dsp_data[dsp_phase_index+2]);
-                  dsp_buf[dsp_i] = val;
+                  buf[dsp_i] = val;
 
                   /* increment phase and amplitude */
-                  phase += dsp_phase_incr;
-                  dsp_phase_index = phase.index();
-                  if (!updateAmpInc(nextNewAmpInc, curSample2AmpInc, dsp_amp_incr, dsp_i))
+                  dsp_phase += dsp_phase_incr;
+                  dsp_phase_index = dsp_phase.index();
+                  if (!updateAmpInc(dsp_amp, nextNewAmpInc, curSample2AmpInc, dsp_amp_incr, dsp_i)) {
+                        phase = dsp_phase;
+                        amp   = dsp_amp;
                         return dsp_i;
-                  amp += dsp_amp_incr;
+                        }
+                  dsp_amp += dsp_amp_incr;
                   }
 
             /* break out if buffer filled */
@@ -389,38 +414,44 @@ int Voice::dsp_float_interpolate_4th_order(unsigned n)
 
             /* interpolate within 2nd to last point */
             for (; dsp_phase_index <= end_index && dsp_i < n; dsp_i++) {
-                  coeffs = interp_coeff[fluid_phase_fract_to_tablerow (phase)];
-                  auto val = amp * (coeffs[0] * dsp_data[dsp_phase_index-1]
+                  coeffs = interp_coeff[fluid_phase_fract_to_tablerow (dsp_phase)];
+                  auto val = dsp_amp * (coeffs[0] * dsp_data[dsp_phase_index-1]
                                    + coeffs[1] * dsp_data[dsp_phase_index]
                                    + coeffs[2] * dsp_data[dsp_phase_index+1]
                                    + coeffs[3] * end_point1);
-                  dsp_buf[dsp_i] = val;
+                  buf[dsp_i] = val;
 
                   /* increment phase and amplitude */
-                  phase += dsp_phase_incr;
-                  dsp_phase_index = phase.index();
-                  if (!updateAmpInc(nextNewAmpInc, curSample2AmpInc, dsp_amp_incr, dsp_i))
+                  dsp_phase += dsp_phase_incr;
+                  dsp_phase_index = dsp_phase.index();
+                  if (!updateAmpInc(dsp_amp, nextNewAmpInc, curSample2AmpInc, dsp_amp_incr, dsp_i)) {
+                        phase = dsp_phase;
+                        amp   = dsp_amp;
                         return dsp_i;
-                  amp += dsp_amp_incr;
+                        }
+                  dsp_amp += dsp_amp_incr;
                   }
 
             end_index++;	/* we're now interpolating the last point */
 
             /* interpolate within the last point */
             for (; dsp_phase_index <= end_index && dsp_i < n; dsp_i++) {
-                  coeffs = interp_coeff[fluid_phase_fract_to_tablerow (phase)];
-                  auto val = amp * (coeffs[0] * dsp_data[dsp_phase_index-1]
+                  coeffs = interp_coeff[fluid_phase_fract_to_tablerow (dsp_phase)];
+                  auto val = dsp_amp * (coeffs[0] * dsp_data[dsp_phase_index-1]
                                     + coeffs[1] * dsp_data[dsp_phase_index]
                                     + coeffs[2] * end_point1
                                     + coeffs[3] * end_point2);
-                  dsp_buf[dsp_i] = val;
+                  buf[dsp_i] = val;
 
                   /* increment phase and amplitude */
-                  phase += dsp_phase_incr;
-                  dsp_phase_index = phase.index();
-                  if (!updateAmpInc(nextNewAmpInc, curSample2AmpInc, dsp_amp_incr, dsp_i))
+                  dsp_phase += dsp_phase_incr;
+                  dsp_phase_index = dsp_phase.index();
+                  if (!updateAmpInc(dsp_amp, nextNewAmpInc, curSample2AmpInc, dsp_amp_incr, dsp_i)) {
+                        phase = dsp_phase;
+                        amp   = dsp_amp;
                         return dsp_i;
-                  amp += dsp_amp_incr;
+                        }
+                  dsp_amp += dsp_amp_incr;
                   }
 
             if (!looping)
@@ -428,7 +459,7 @@ int Voice::dsp_float_interpolate_4th_order(unsigned n)
 
             /* go back to loop start */
             if (dsp_phase_index > end_index) {
-                  phase -= (loopend - loopstart);
+                  dsp_phase -= (loopend - loopstart);
                   if (!has_looped) {
                         has_looped = true;
                         start_index = loopstart;
@@ -440,6 +471,8 @@ int Voice::dsp_float_interpolate_4th_order(unsigned n)
                   break;
             end_index -= 2;	/* set end back to third to last sample point */
             }
+      phase = dsp_phase;
+      amp   = dsp_amp;
       return dsp_i;
       }
 
@@ -461,6 +494,8 @@ int Voice::dsp_float_interpolate_7th_order(unsigned n)
       qreal dsp_amp_incr = curSample2AmpInc->second;
       unsigned int nextNewAmpInc = curSample2AmpInc->first;
       unsigned int dsp_i = 0;
+      float dsp_amp = amp;
+      float* buf = dsp_buf.data();
       unsigned int dsp_phase_index;
       unsigned int start_index, end_index;
       short int start_points[3];
@@ -515,7 +550,7 @@ int Voice::dsp_float_interpolate_7th_order(unsigned n)
             for ( ; dsp_phase_index == start_index && dsp_i < n; dsp_i++) {
                   coeffs = sinc_table7[fluid_phase_fract_to_tablerow (dsp_phase)];
 
-                  dsp_buf[dsp_i] = amp * (coeffs[0] * (float)start_points[2]
+                  buf[dsp_i] = dsp_amp * (coeffs[0] * (float)start_points[2]
                         + coeffs[1] * (float)start_points[1]
 	                  + coeffs[2] * (float)start_points[0]
                         + coeffs[3] * (float)dsp_data[dsp_phase_index]
@@ -526,9 +561,11 @@ int Voice::dsp_float_interpolate_7th_order(unsigned n)
                   /* increment phase and amplitude */
                   dsp_phase += dsp_phase_incr;
                   dsp_phase_index = dsp_phase.index();
-                  if (!updateAmpInc(nextNewAmpInc, curSample2AmpInc, dsp_amp_incr, dsp_i))
+                  if (!updateAmpInc(dsp_amp, nextNewAmpInc, curSample2AmpInc, dsp_amp_incr, dsp_i)) {
+                        amp = dsp_amp;
                         return dsp_i;
-                  amp += dsp_amp_incr;
+                        }
+                  dsp_amp += dsp_amp_incr;
                   }
 
             start_index++;
@@ -537,7 +574,7 @@ int Voice::dsp_float_interpolate_7th_order(unsigned n)
             for ( ; dsp_phase_index == start_index && dsp_i < n; dsp_i++) {
                   coeffs = sinc_table7[fluid_phase_fract_to_tablerow (dsp_phase)];
 
-                  dsp_buf[dsp_i] = amp * (coeffs[0] * (float)start_points[1]
+                  buf[dsp_i] = dsp_amp * (coeffs[0] * (float)start_points[1]
         	            + coeffs[1] * (float)start_points[0]
         	            + coeffs[2] * (float)dsp_data[dsp_phase_index-1]
         	            + coeffs[3] * (float)dsp_data[dsp_phase_index]
@@ -548,9 +585,11 @@ int Voice::dsp_float_interpolate_7th_order(unsigned n)
                   /* increment phase and amplitude */
                   dsp_phase += dsp_phase_incr;
                   dsp_phase_index = dsp_phase.index();
-                  if (!updateAmpInc(nextNewAmpInc, curSample2AmpInc, dsp_amp_incr, dsp_i))
+                  if (!updateAmpInc(dsp_amp, nextNewAmpInc, curSample2AmpInc, dsp_amp_incr, dsp_i)) {
+                        amp = dsp_amp;
                         return dsp_i;
-                  amp += dsp_amp_incr;
+                        }
+                  dsp_amp += dsp_amp_incr;
                   }
 
             start_index++;
@@ -559,7 +598,7 @@ int Voice::dsp_float_interpolate_7th_order(unsigned n)
             for ( ; dsp_phase_index == start_index && dsp_i < n; dsp_i++) {
                   coeffs = sinc_table7[fluid_phase_fract_to_tablerow (dsp_phase)];
 
-                  dsp_buf[dsp_i] = amp * (coeffs[0] * (float)start_points[0]
+                  buf[dsp_i] = dsp_amp * (coeffs[0] * (float)start_points[0]
                      + coeffs[1] * (float)dsp_data[dsp_phase_index-2]
                      + coeffs[2] * (float)dsp_data[dsp_phase_index-1]
                      + coeffs[3] * (float)dsp_data[dsp_phase_index]
@@ -570,9 +609,11 @@ int Voice::dsp_float_interpolate_7th_order(unsigned n)
                   /* increment phase and amplitude */
                   dsp_phase += dsp_phase_incr;
                   dsp_phase_index = dsp_phase.index();
-                  if (!updateAmpInc(nextNewAmpInc, curSample2AmpInc, dsp_amp_incr, dsp_i))
+                  if (!updateAmpInc(dsp_amp, nextNewAmpInc, curSample2AmpInc, dsp_amp_incr, dsp_i)) {
+                        amp = dsp_amp;
                         return dsp_i;
-                  amp += dsp_amp_incr;
+                        }
+                  dsp_amp += dsp_amp_incr;
                   }
 
             start_index -= 2;	/* set back to original start index */
@@ -581,7 +622,7 @@ int Voice::dsp_float_interpolate_7th_order(unsigned n)
             for ( ; dsp_i < n && dsp_phase_index <= end_index; dsp_i++) {
                   coeffs = sinc_table7[fluid_phase_fract_to_tablerow (dsp_phase)];
 
-                  dsp_buf[dsp_i] = amp * (coeffs[0] * (float)dsp_data[dsp_phase_index-3]
+                  buf[dsp_i] = dsp_amp * (coeffs[0] * (float)dsp_data[dsp_phase_index-3]
                      + coeffs[1] * (float)dsp_data[dsp_phase_index-2]
                      + coeffs[2] * (float)dsp_data[dsp_phase_index-1]
                      + coeffs[3] * (float)dsp_data[dsp_phase_index]
@@ -592,9 +633,11 @@ int Voice::dsp_float_interpolate_7th_order(unsigned n)
                   /* increment phase and amplitude */
                   dsp_phase += dsp_phase_incr;
                   dsp_phase_index = dsp_phase.index();
-                  if (!updateAmpInc(nextNewAmpInc, curSample2AmpInc, dsp_amp_incr, dsp_i))
+                  if (!updateAmpInc(dsp_amp, nextNewAmpInc, curSample2AmpInc, dsp_amp_incr, dsp_i)) {
+                        amp = dsp_amp;
                         return dsp_i;
-                  amp += dsp_amp_incr;
+                        }
+                  dsp_amp += dsp_amp_incr;
                   }
 
             /* break out if buffer filled */
@@ -607,7 +650,7 @@ int Voice::dsp_float_interpolate_7th_order(unsigned n)
             for (; dsp_phase_index <= end_index && dsp_i < n; dsp_i++) {
                   coeffs = sinc_table7[fluid_phase_fract_to_tablerow (dsp_phase)];
 
-                  dsp_buf[dsp_i] = amp * (coeffs[0] * (float)dsp_data[dsp_phase_index-3]
+                  buf[dsp_i] = dsp_amp * (coeffs[0] * (float)dsp_data[dsp_phase_index-3]
                         + coeffs[1] * (float)dsp_data[dsp_phase_index-2]
                         + coeffs[2] * (float)dsp_data[dsp_phase_index-1]
                         + coeffs[3] * (float)dsp_data[dsp_phase_index]
@@ -618,9 +661,11 @@ int Voice::dsp_float_interpolate_7th_order(unsigned n)
                   /* increment phase and amplitude */
                   dsp_phase += dsp_phase_incr;
                   dsp_phase_index = dsp_phase.index();
-                  if (!updateAmpInc(nextNewAmpInc, curSample2AmpInc, dsp_amp_incr, dsp_i))
+                  if (!updateAmpInc(dsp_amp, nextNewAmpInc, curSample2AmpInc, dsp_amp_incr, dsp_i)) {
+                        amp = dsp_amp;
                         return dsp_i;
-                  amp += dsp_amp_incr;
+                        }
+                  dsp_amp += dsp_amp_incr;
                   }
 
             end_index++;	/* we're now interpolating the 2nd to last point */
@@ -629,7 +674,7 @@ int Voice::dsp_float_interpolate_7th_order(unsigned n)
             for (; dsp_phase_index <= end_index && dsp_i < n; dsp_i++) {
                   coeffs = sinc_table7[fluid_phase_fract_to_tablerow (dsp_phase)];
 
-                  dsp_buf[dsp_i] = amp * (coeffs[0] * (float)dsp_data[dsp_phase_index-3]
+                  buf[dsp_i] = dsp_amp * (coeffs[0] * (float)dsp_data[dsp_phase_index-3]
                         + coeffs[1] * (float)dsp_data[dsp_phase_index-2]
                         + coeffs[2] * (float)dsp_data[dsp_phase_index-1]
                         + coeffs[3] * (float)dsp_data[dsp_phase_index]
@@ -640,9 +685,11 @@ int Voice::dsp_float_interpolate_7th_order(unsigned n)
                   /* increment phase and amplitude */
                   dsp_phase += dsp_phase_incr;
                   dsp_phase_index = dsp_phase.index();
-                  if (!updateAmpInc(nextNewAmpInc, curSample2AmpInc, dsp_amp_incr, dsp_i))
+                  if (!updateAmpInc(dsp_amp, nextNewAmpInc, curSample2AmpInc, dsp_amp_incr, dsp_i)) {
+                        amp = dsp_amp;
                         return dsp_i;
-                  amp += dsp_amp_incr;
+                        }
+                  dsp_amp += dsp_amp_incr;
                   }
 
             end_index++;	/* we're now interpolating the last point */
@@ -651,7 +698,7 @@ int Voice::dsp_float_interpolate_7th_order(unsigned n)
             for (; dsp_phase_index <= end_index && dsp_i < n; dsp_i++) {
                   coeffs = sinc_table7[fluid_phase_fract_to_tablerow (dsp_phase)];
 
-                  dsp_buf[dsp_i] = amp * (coeffs[0] * (float)dsp_data[dsp_phase_index-3]
+                  buf[dsp_i] = dsp_amp * (coeffs[0] * (float)dsp_data[dsp_phase_index-3]
                         + coeffs[1] * (float)dsp_data[dsp_phase_index-2]
                         + coeffs[2] * (float)dsp_data[dsp_phase_index-1]
                         + coeffs[3] * (float)dsp_data[dsp_phase_index]
@@ -662,9 +709,11 @@ int Voice::dsp_float_interpolate_7th_order(unsigned n)
                   /* increment phase and amplitude */
                   dsp_phase += dsp_phase_incr;
                   dsp_phase_index = dsp_phase.index();
-                  if (!updateAmpInc(nextNewAmpInc, curSample2AmpInc, dsp_amp_incr, dsp_i))
+                  if (!updateAmpInc(dsp_amp, nextNewAmpInc, curSample2AmpInc, dsp_amp_incr, dsp_i)) {
+                        amp = dsp_amp;
                         return dsp_i;
-                  amp += dsp_amp_incr;
+                        }
+                  dsp_amp += dsp_amp_incr;
                   }
 
             if (!looping)
@@ -694,6 +743,7 @@ int Voice::dsp_float_interpolate_7th_order(unsigned n)
       dsp_phase -= (Phase)0x80000000;
 
       voice->phase = dsp_phase;
+      amp = dsp_amp;
 
       return dsp_i;
       }
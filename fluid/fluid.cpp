@@ -97,8 +97,16 @@ void Fluid::init(float sampleRate)
             _tuning[i] = i * 100.0;
       _masterTuning = 440.0;
 
-      for (int i = 0; i < 512; i++)
-            freeVoices.append(new Voice(this));
+      const int maxVoices = 512;
+      voices.reserve(maxVoices);
+      freeVoices.reserve(maxVoices);
+      activeVoices.reserve(maxVoices);
+      killQueue.reserve(maxVoices);
+      for (int i = 0; i < maxVoices; i++) {
+            Voice* v = new Voice(this);
+            voices.push_back(v);
+            freeVoices.push_back(v);
+            }
       }
 
 //---------------------------------------------------------
@@ -110,8 +118,8 @@ Fluid::~Fluid()
       _state = FLUID_SYNTH_STOPPED;
       _globalTerminate = true;
       while (!mutex.tryLock()) {}
-      qDeleteAll(activeVoices);
-      qDeleteAll(freeVoices);
+      SFont::loader()->waitForDone();
+      qDeleteAll(voices);
       qDeleteAll(sfonts);
       qDeleteAll(channel);
       qDeleteAll(patches);
@@ -123,8 +131,17 @@ Fluid::~Fluid()
 
 void Fluid::freeVoice(Voice* v)
       {
-      if (activeVoices.removeOne(v))
-            freeVoices.append(v);
+      int idx = v->activeIndex;
+      if (idx < 0)
+            return;
+      // move the last active voice into the gap; loops which turn off
+      // voices therefore walk activeVoices from the end
+      Voice* last = activeVoices.back();
+      activeVoices[idx] = last;
+      last->activeIndex = idx;
+      activeVoices.pop_back();
+      v->activeIndex = -1;
+      freeVoices.push_back(v);
       }
 
 //---------------------------------------------------------
@@ -233,7 +250,8 @@ void Fluid::allNotesOff(int chan)
 
 void Fluid::allSoundsOff(int chan)
       {
-      for(Voice* v : activeVoices) {
+      for (int i = int(activeVoices.size()) - 1; i >= 0; --i) {
+            Voice* v = activeVoices[i];
             if (chan == -1 || v->chan == chan)
                   v->off();
             }
@@ -248,8 +266,8 @@ void Fluid::allSoundsOff(int chan)
 
 void Fluid::system_reset()
       {
-      for(Voice* v : activeVoices)
-            v->off();
+      for (int i = int(activeVoices.size()) - 1; i >= 0; --i)
+            activeVoices[i]->off();
       for(Channel* c : channel)
             c->reset();
       }
@@ -401,81 +419,104 @@ void Fluid::update_presets()
 void Fluid::process(unsigned len, float* out, float* effect1, float* effect2)
       {
       if (mutex.tryLock()) {
-            //we have to copy voices array for proper output sound processing in for loop
-            auto tempVoices = activeVoices;
-            for (Voice* v : tempVoices)
-                  v->write(len, out, effect1, effect2);
+            // a voice which ends is removed from activeVoices and replaced
+            // by the last one, which has already been processed
+            for (int i = int(activeVoices.size()) - 1; i >= 0; --i)
+                  activeVoices[i]->write(len, out, effect1, effect2);
+            ++processCount;
             mutex.unlock();
             }
       }
 
+//---------------------------------------------------------
+//   voicePriority
+//    determine, how 'important' a voice is
+//---------------------------------------------------------
+
+float Fluid::voicePriority(const Voice* v) const
+      {
+      /* Start with an arbitrary number */
+      float prio = 10000.;
+
+      /* Is this voice on the drum channel?
+       * Then it is very important.
+       * Also, forget about the released-note condition:
+       * Typically, drum notes are triggered only very briefly, they run most
+       * of the time in release phase.
+       */
+      if (v->chan == 9) {
+            prio += 4000;
+
+            }
+      else if (v->RELEASED()) {
+            /* The key for this voice has been released. Consider it much less important
+            * than a voice, which is still held.
+            */
+            prio -= 2000.;
+            }
+
+      if (v->SUSTAINED()) {
+        /* The sustain pedal is held down on this channel.
+         * Consider it less important than non-sustained channels.
+         * This decision is somehow subjective. But usually the sustain pedal
+         * is used to play 'more-voices-than-fingers', so it shouldn't hurt
+         * if we kill one voice.
+         */
+            prio -= 1000;
+            }
+
+      /* We are not enthusiastic about releasing voices, which have just been started.
+       * Otherwise hitting a chord may result in killing notes belonging to that very same
+       * chord.
+       * So subtract the age of the voice from the priority - an older voice is just a little
+       * bit less important than a younger voice.
+       * This is a number between roughly 0 and 100.*/
+
+      prio -= (noteid - v->get_id());
+
+      /* take a rough estimate of loudness into account. Louder voices are more important. */
+      if (v->volenv_section != FLUID_VOICE_ENVATTACK) {
+            prio += v->volenv_val * 1000.;
+            }
+      return prio;
+      }
+
 /*
  * fluid_synth_free_voice_by_kill
  *
  * selects a voice for killing. the selection algorithm is a refinement
  * of the algorithm previously in fluid_synth_alloc_voice.
+ *
+ * The priorities of all active voices are put into a heap once per
+ * audio period, so a chord which needs to steal many voices does not
+ * scan all voices for every note. Candidates are remembered with the
+ * generation of their voice; a voice which was freed or reused since
+ * the heap was built is skipped.
  */
 
 void Fluid::free_voice_by_kill()
       {
-      float best_prio = 999999.;
-      float this_voice_prio;
-      Voice* best_voice = 0;
-
-      for(Voice* v : activeVoices) {
-            /* Determine, how 'important' a voice is.
-             * Start with an arbitrary number */
-            this_voice_prio = 10000.;
-
-            /* Is this voice on the drum channel?
-             * Then it is very important.
-             * Also, forget about the released-note condition:
-             * Typically, drum notes are triggered only very briefly, they run most
-             * of the time in release phase.
-             */
-            if (v->chan == 9) {
-                  this_voice_prio += 4000;
-
-                  }
-            else if (v->RELEASED()) {
-                  /* The key for this voice has been released. Consider it much less important
-                  * than a voice, which is still held.
-                  */
-                  this_voice_prio -= 2000.;
-                  }
-
-            if (v->SUSTAINED()) {
-              /* The sustain pedal is held down on this channel.
-               * Consider it less important than non-sustained channels.
-               * This decision is somehow subjective. But usually the sustain pedal
-               * is used to play 'more-voices-than-fingers', so it shouldn't hurt
-               * if we kill one voice.
-               */
-                  this_voice_prio -= 1000;
-                  }
-
-            /* We are not enthusiastic about releasing voices, which have just been started.
-             * Otherwise hitting a chord may result in killing notes belonging to that very same
-             * chord.
-             * So subtract the age of the voice from the priority - an older voice is just a little
-             * bit less important than a younger voice.
-             * This is a number between roughly 0 and 100.*/
-
-            this_voice_prio -= (noteid - v->get_id());
-
-            /* take a rough estimate of loudness into account. Louder voices are more important. */
-            if (v->volenv_section != FLUID_VOICE_ENVATTACK) {
-                  this_voice_prio += v->volenv_val * 1000.;
+      bool rebuilt = false;
+      for (;;) {
+            if (killQueue.empty() || killQueueCount != processCount) {
+                  // all candidates taken or the heap is from an earlier period
+                  if (rebuilt || activeVoices.empty())
+                        return;
+                  killQueue.clear();
+                  for (Voice* v : activeVoices)
+                        killQueue.push_back({ voicePriority(v), v, v->generation });
+                  std::make_heap(killQueue.begin(), killQueue.end());
+                  killQueueCount = processCount;
+                  rebuilt = true;
                   }
-
-            /* check if this voice has less priority than the previous candidate. */
-            if (this_voice_prio < best_prio) {
-                  best_voice = v;
-                  best_prio = this_voice_prio;
+            std::pop_heap(killQueue.begin(), killQueue.end());
+            KillCandidate c = killQueue.back();
+            killQueue.pop_back();
+            if (c.voice->activeIndex >= 0 && c.voice->generation == c.generation) {
+                  c.voice->off();
+                  return;
                   }
             }
-      if (best_voice)
-            best_voice->off();
       }
 
 //---------------------------------------------------------
@@ -487,16 +528,19 @@ Voice* Fluid::alloc_voice(unsigned id, Sample* sample, int chan, int key, int ve
       Channel* c = 0;
 
       /* check if there's an available synthesis process */
-      if (freeVoices.isEmpty())
+      if (freeVoices.empty())
             free_voice_by_kill();
 
-      if (freeVoices.isEmpty()) {
+      if (freeVoices.empty()) {
             qDebug("Failed to allocate a synthesis process. (chan=%d,key=%d)", chan, key);
             return 0;
             }
 
-      Voice* v = freeVoices.takeLast();
-      activeVoices.append(v);
+      Voice* v = freeVoices.back();
+      freeVoices.pop_back();
+      v->activeIndex = int(activeVoices.size());
+      ++v->generation;
+      activeVoices.push_back(v);
 
       if (chan >= 0)
             c = channel[chan];
@@ -619,8 +663,8 @@ bool Fluid::loadSoundFonts(const QStringList& sl)
             return true;
             }
       QMutexLocker locker(&mutex);
-      for(Voice* v : activeVoices)
-            v->off();
+      for (int i = int(activeVoices.size()) - 1; i >= 0; --i)
+            activeVoices[i]->off();
       for(Channel* c : channel)
             c->reset();
       for (SFont* sf : sfonts)
@@ -655,6 +699,7 @@ bool Fluid::loadSoundFonts(const QStringList& sl)
                   locker.unlock();
                   }
             }
+      SFont::loader()->waitForDone();     // keep the progress dialog up
       return ok;
       }
 
@@ -667,6 +712,8 @@ bool Fluid::addSoundFont(const QString& s)
       {
       QMutexLocker locker(&mutex);
       bool rv = (sfload(s) == -1) ? false : true;
+      locker.unlock();
+      SFont::loader()->waitForDone();     // keep the progress dialog up
       return rv;
       }
 
@@ -678,8 +725,8 @@ bool Fluid::addSoundFont(const QString& s)
 bool Fluid::removeSoundFont(const QString& s)
       {
       QMutexLocker locker(&mutex);
-      for(Voice* v : activeVoices)
-            v->off();
+      for (int i = int(activeVoices.size()) - 1; i >= 0; --i)
+            activeVoices[i]->off();
       SFont* sf = get_sfont_by_name(s);
       sfunload(sf->id());
       return true;
@@ -735,6 +782,7 @@ bool Fluid::sfunload(int id)
       sfonts.removeAll(sf);   // remove the SoundFont from the list
       updatePatchList();
 
+      SFont::loader()->waitForDone();     // samples may still be loaded
       delete sf;
       return true;
       }
@@ -298,8 +298,24 @@ class Fluid : public Synthesizer {
       QList<SFont*> sfonts;               // the loaded soundfonts
       QList<MidiPatch*> patches;
 
-      QList<Voice*> freeVoices;           // unused synthesis processes
-      QList<Voice*> activeVoices;         // active synthesis processes
+      //
+      // The voices are allocated once in init(). The lists below never
+      // grow beyond their reserved capacity, so playing does not allocate.
+      // Voice::activeIndex is the position of a voice in activeVoices.
+      //
+      std::vector<Voice*> voices;         // all synthesis processes
+      std::vector<Voice*> freeVoices;     // unused synthesis processes
+      std::vector<Voice*> activeVoices;   // active synthesis processes
+
+      struct KillCandidate {
+            float prio;
+            Voice* voice;
+            unsigned generation;          // Voice::generation when the candidate was taken
+            bool operator<(const KillCandidate& c) const { return prio > c.prio; }
+            };
+      std::vector<KillCandidate> killQueue;     // heap of voices to steal, least important first
+      unsigned processCount = 0;          // number of processed audio periods
+      unsigned killQueueCount = 0;        // processCount when killQueue was built
       QString _error;                     // last error message
 
       static bool initialized;
@@ -310,6 +326,7 @@ class Fluid : public Synthesizer {
 
       int _loadProgress = 0;
       bool _loadWasCanceled = false;
+      bool _realtime = false;             // do not load samples on the audio thread
 
       QMutex mutex;
       void updatePatchList();
@@ -340,6 +357,8 @@ class Fluid : public Synthesizer {
       virtual const char* name() const { return "Fluid"; }
 
       virtual void play(const PlayEvent&);
+      virtual void setRealtime(bool val)  { _realtime = val; }
+      bool realtime() const               { return _realtime; }
       virtual const QList<MidiPatch*>& getPatchInfo() const { return patches; }
 
       // get/set synthesizer state (parameter set)
@@ -387,6 +406,7 @@ class Fluid : public Synthesizer {
       void start_voice(Voice* voice);
       Voice* alloc_voice(unsigned id, Sample* sample, int chan, int key, int vel, double vt);
       void free_voice_by_kill();
+      float voicePriority(const Voice* v) const;
 
       virtual void process(unsigned len, float* out, float* effect1, float* effect2);
 
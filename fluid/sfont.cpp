@@ -80,6 +80,18 @@ bool SFont::read(const QString& s)
       if (!load())
             return false;
 
+#ifdef SOUNDFONT3
+      // The cache of decoded samples is keyed by the identity of the
+      // font file; hashing the content would read the whole font.
+      QFileInfo fi(s);
+      QByteArray key = fi.absoluteFilePath().toUtf8() + '\0'
+         + QByteArray::number(fi.size()) + '\0'
+         + QByteArray::number(fi.lastModified().toMSecsSinceEpoch());
+      _cacheDir = QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + "/soundfonts/"
+         + QCryptographicHash::hash(key, QCryptographicHash::Sha1).toHex();
+      pruneCache();
+#endif
+
       synth->setLoadProgress(0);
       for (auto instrument : instruments) {
             if (synth->loadWasCanceled())
@@ -136,46 +148,92 @@ Preset::~Preset()
             delete z;
       }
 
+//---------------------------------------------------------
+//   loader
+//    the threads which load samples, kept for the lifetime
+//    of the program
+//---------------------------------------------------------
+
+QThreadPool* SFont::loader()
+      {
+      static QThreadPool pool;
+      return &pool;
+      }
+
 //---------------------------------------------------------
 //   loadSamples
 //    this is called if the preset is associated with a
-//    channel
+//    channel. If wait is false, the samples are loaded on
+//    SFont::loader() and the call returns at once; a sample
+//    plays from the first note after it is loaded, see
+//    Sample::loaded(). The audio thread must not wait.
 //---------------------------------------------------------
 
-void Preset::loadSamples()
+void Preset::loadSamples(bool wait)
       {
-      bool locked = sfont->synth->mutex.tryLock();
+      if (!wait) {
+            if (!_loadPending.exchange(true)) {
+                  QtConcurrent::run(SFont::loader(), [this]() {
+                        loadSamples(true);
+                        _loadPending = false;
+                        });
+                  }
+            return;
+            }
 
+      // collect the samples of all zones, each once
+      std::vector<Sample*> samples;
+      std::set<Sample*> seen;
+      auto addSample = [&samples, &seen](Sample* s) {
+            if (s && !s->loaded() && seen.insert(s).second)
+                  samples.push_back(s);
+            };
       if (_global_zone && _global_zone->instrument) {
             Instrument* i = _global_zone->instrument;
-            if (i->global_zone && i->global_zone->sample)
-                  i->global_zone->sample->load();
-
+            if (i->global_zone)
+                  addSample(i->global_zone->sample);
             for (Zone* iz : i->zones)
-                  iz->sample->load();
+                  addSample(iz->sample);
             }
-
-      int currentInstrZone = 0;
-      float instrSize = (float)zones.size(); //float is used to properly calculate progress
       for (Zone* z : zones) {
-            sfont->synth->setLoadProgress(currentInstrZone++ / instrSize * 100);
             Instrument* i = z->instrument;
-            if (i->global_zone && i->global_zone->sample)
-                  i->global_zone->sample->load();
+            if (i->global_zone)
+                  addSample(i->global_zone->sample);
+            for (Zone* iz : i->zones)
+                  addSample(iz->sample);
+            }
+      if (samples.empty())
+            return;
 
-            for (Zone* iz : i->zones) {
-                  if (sfont->synth->globalTerminate()) {
-                        if (locked)
-                              sfont->synth->mutex.unlock();
+      //
+      // Decode the samples on the loader threads and on this one.
+      // Reading from the sound font file is serialized in
+      // SFont::readSampleData().
+      //
+      std::atomic<size_t> next { 0 };
+      auto loader = [this, &samples, &next]() {
+            for (size_t i = next++; i < samples.size(); i = next++) {
+                  if (sfont->synth->globalTerminate())
                         return;
+                  samples[i]->load();
                   }
-
-                  iz->sample->load();
-                  }
+            };
+      QThreadPool* pool = SFont::loader();
+      size_t helpers = std::min(size_t(std::max(1, pool->maxThreadCount())), samples.size()) - 1;
+      std::vector<QFuture<void>> futures;
+      for (size_t i = 0; i < helpers; ++i)
+            futures.push_back(QtConcurrent::run(pool, loader));
+
+      float total = (float)samples.size(); //float is used to properly calculate progress
+      for (size_t i = next++; i < samples.size(); i = next++) {
+            if (sfont->synth->globalTerminate())
+                  break;
+            samples[i]->load();
+            sfont->synth->setLoadProgress(std::min(size_t(next), samples.size()) / total * 100);
             }
-
-      if (locked)
-            sfont->synth->mutex.unlock();
+      // a helper which did not start yet is run here
+      for (QFuture<void>& f : futures)
+            f.waitForFinished();
       }
 
 //---------------------------------------------------------
@@ -202,7 +260,7 @@ bool Preset::noteon(Fluid* synth, unsigned id, int chan, int key, int vel, doubl
                   for(Zone* inst_zone : inst->get_zone()) {
                         /* make sure this instrument zone has a valid sample */
                         Sample* sample = inst_zone->get_sample();
-                        if (sample == 0 || sample->inRom())
+                        if (sample == 0 || sample->inRom() || !sample->loaded())
                               continue;
                         /* check if the note falls into the key and velocity range of this
                            instrument */
@@ -627,38 +685,46 @@ Sample::~Sample()
 
 void Sample::load()
       {
-      if (!_valid || data)
+      // another thread may load it at the same time
+      if (!_valid || _loading.exchange(true))
             return;
-      QFile fd(sf->get_name());
-      if (!fd.open(QIODevice::ReadOnly))
-            return;
-      if (sampletype & FLUID_SAMPLETYPE_OGG_VORBIS) {
-            if (!fd.seek(sf->samplePos() + start))
-                  return;
-            }
-      else {
-            if (!fd.seek(sf->samplePos() + start * sizeof(short)))
-                  return;
-            }
       unsigned int size = end - start;
 
       if (sampletype & FLUID_SAMPLETYPE_OGG_VORBIS) {
 #ifdef SOUNDFONT3
-            std::vector<char> p;
-            p.resize(size);
-            if (fd.read(p.data(), size) != size) {
-                  printf("  read %d failed\n", size);
-                  return;
+            unsigned int offset = start;
+            if (!readCache(offset, size)) {
+                  std::vector<char> p;
+                  p.resize(size);
+                  if (!sf->readSampleData(sf->samplePos() + start, p.data(), size)) {
+                        printf("  read %d failed\n", size);
+                        _loading.store(false);
+                        return;
+                        }
+                  unsigned int ls = loopstart;
+                  unsigned int le = loopend;
+                  if (decompressOggVorbis(p.data(), size) && data)
+                        writeCache(offset, size);
+                  else {
+                        // restore the position in the font for the next try
+                        start     = offset;
+                        end       = offset + size;
+                        loopstart = ls;
+                        loopend   = le;
+                        }
                   }
-            decompressOggVorbis(p.data(), size);
 #endif
             }
       else {
             data = new short[size];
             size *= sizeof(short);
 
-            if (fd.read((char*)data, size) != size)
+            if (!sf->readSampleData(sf->samplePos() + start * sizeof(short), (char*)data, size)) {
+                  delete[] data;
+                  data = 0;
+                  _loading.store(false);
                   return;
+                  }
 
             if (QSysInfo::ByteOrder == QSysInfo::BigEndian) {
                   unsigned char hi, lo;
@@ -677,7 +743,30 @@ void Sample::load()
             loopend   -= start;
             start      = 0;
             }
+      if (!data) {
+            // not loaded: another call may try again
+            _loading.store(false);
+            return;
+            }
       optimize();
+      _loaded.store(true, std::memory_order_release);
+      }
+
+//---------------------------------------------------------
+//   readSampleData
+//    read from the sound font file; can be called from
+//    several threads at the same time
+//---------------------------------------------------------
+
+bool SFont::readSampleData(qint64 pos, char* buf, qint64 size)
+      {
+      QMutexLocker locker(&sampleFileMutex);
+      if (!sampleFile.isOpen()) {
+            sampleFile.setFileName(f.fileName());
+            if (!sampleFile.open(QIODevice::ReadOnly))
+                  return false;
+            }
+      return sampleFile.seek(pos) && sampleFile.read(buf, size) == size;
       }
 
 //---------------------------------------------------------
@@ -23,6 +23,8 @@
 #ifndef _FLUID_DEFSFONT_H
 #define _FLUID_DEFSFONT_H
 
+#include <atomic>
+
 #include "config.h"
 #include "fluid.h"
 
@@ -52,6 +54,9 @@ struct SFVersion {            // version structure
 class SFont {
       Fluid* synth;
       QFile f;
+      QFile sampleFile;             // shared by all samples, opened on first use
+      QMutex sampleFileMutex;
+      QString _cacheDir;            // decoded samples of a compressed font, see Sample::readCache()
       unsigned samplepos;           // the position in the file at which the sample data starts
       unsigned samplesize;          // the size of the sample data
 
@@ -107,8 +112,15 @@ class SFont {
       Preset* get_preset(int bank, int prenum);
 
       bool read(const QString& file);
+      static QThreadPool* loader();
 
       int load_sampledata();
+      bool readSampleData(qint64 pos, char* buf, qint64 size);
+      const QString& cacheDir() const           { return _cacheDir; }
+      void setCacheDir(const QString& s)        { _cacheDir = s; }
+#ifdef SOUNDFONT3
+      void pruneCache() const;
+#endif
       unsigned int samplePos() const            { return samplepos;  }
       int id() const                            { return _id; }
       void setId(int i)                         { _id = i;    }
@@ -129,6 +141,8 @@ class SFont {
 
 class Sample {
       bool _valid;
+      std::atomic<bool> _loading { false };     // claimed by the thread which loads it
+      std::atomic<bool> _loaded  { false };     // data may be played
 
    public:
       SFont* sf;
@@ -159,8 +173,12 @@ class Sample {
       void load();
       bool valid() const    { return _valid; }
       void setValid(bool v) { _valid = v; }
+      bool loaded() const   { return _loaded.load(std::memory_order_acquire); }
 #ifdef SOUNDFONT3
       bool decompressOggVorbis(char* p, int size);
+      void setDecodedFrames(int frames);
+      bool readCache(unsigned offset, unsigned size);
+      void writeCache(unsigned offset, unsigned size) const;
 #endif
       };
 
@@ -223,6 +241,7 @@ class Preset {
 
       Zone* _global_zone;           // the global zone of the preset
       QList<Zone*> zones;
+      std::atomic<bool> _loadPending { false };   // loadSamples(false) queued a load
 
    public:
       Preset(SFont* sfont);
@@ -237,7 +256,7 @@ class Preset {
       bool importSfont();
 
       Zone* global_zone()                       { return _global_zone; }
-      void loadSamples();
+      void loadSamples(bool wait = true);
       QList<Zone*> getZones()                   { return zones; }
       };
 
@@ -28,7 +28,20 @@ bool Sample::decompressOggVorbis(char* src, int size)
             delete[] data;
             data = 0;
             }
-      end = frames - 1;
+      setDecodedFrames(frames);
+      return true;
+      }
+
+//---------------------------------------------------------
+//   setDecodedFrames
+//    set end and loop points after the sample data was
+//    replaced by frames of decoded audio
+//---------------------------------------------------------
+
+void Sample::setDecodedFrames(int frames)
+      {
+      start = 0;
+      end   = frames - 1;
 
       if (loopend > end ||loopstart >= loopend || loopstart <= start) {
             /* can pad loop by 8 samples and ensure at least 4 for loop (2*8+4) */
@@ -45,7 +58,125 @@ bool Sample::decompressOggVorbis(char* src, int size)
             qDebug("invalid sample");
             setValid(false);
             }
+      }
 
-      return true;
+//---------------------------------------------------------
+//   Cache of decoded samples
+//    One file per sample in SFont::cacheDir(), named
+//    after the offset of the compressed data in the font:
+//    a CacheHeader followed by the decoded frames. The
+//    file "source" holds the path of the font.
+//---------------------------------------------------------
+
+static const quint32 CACHE_MAGIC   = 0x4d435046;      // "FPCM"
+static const quint32 CACHE_VERSION = 1;
+
+struct CacheHeader {
+      quint32 magic;
+      quint32 version;
+      quint32 compressedSize;
+      quint32 frames;
+      };
+
+static QString cacheFileName(const QString& dir, unsigned offset)
+      {
+      return QString("%1/%2.pcm").arg(dir).arg(offset);
+      }
+
+// the path of the font whose samples are in the directory
+static QString sourceFileName(const QString& dir)
+      {
+      return dir + "/source";
+      }
+
+//---------------------------------------------------------
+//   readCache
+//    load the decoded sample from the cache; offset and
+//    size locate the compressed data in the font
+//---------------------------------------------------------
+
+bool Sample::readCache(unsigned offset, unsigned size)
+      {
+      if (sf->cacheDir().isEmpty())
+            return false;
+      QFile f(cacheFileName(sf->cacheDir(), offset));
+      if (!f.open(QIODevice::ReadOnly) || f.size() < qint64(sizeof(CacheHeader)))
+            return false;
+      uchar* p = f.map(0, f.size());
+      if (!p)
+            return false;
+      CacheHeader h;
+      memcpy(&h, p, sizeof(h));
+      qint64 bytes = qint64(h.frames) * sizeof(short);
+      bool ok = h.magic == CACHE_MAGIC && h.version == CACHE_VERSION
+         && h.compressedSize == size && h.frames > 0
+         && f.size() == qint64(sizeof(h)) + bytes;
+      if (ok) {
+            // copied, as data is owned by the sample and freed with delete[]
+            data = new short[h.frames];
+            memcpy(data, p + sizeof(h), bytes);
+            setDecodedFrames(h.frames);
+            }
+      f.unmap(p);
+      return ok;
+      }
+
+//---------------------------------------------------------
+//   writeCache
+//    store the decoded sample; a failure only costs
+//    decoding the sample again next time
+//---------------------------------------------------------
+
+void Sample::writeCache(unsigned offset, unsigned size) const
+      {
+      if (sf->cacheDir().isEmpty() || !QDir().mkpath(sf->cacheDir()))
+            return;
+      QString source = sourceFileName(sf->cacheDir());
+      if (!QFile::exists(source)) {
+            QSaveFile s(source);
+            if (s.open(QIODevice::WriteOnly)) {
+                  s.write(QFileInfo(sf->get_name()).absoluteFilePath().toUtf8());
+                  s.commit();
+                  }
+            }
+      CacheHeader h;
+      h.magic          = CACHE_MAGIC;
+      h.version        = CACHE_VERSION;
+      h.compressedSize = size;
+      h.frames         = end + 1;
+      QSaveFile f(cacheFileName(sf->cacheDir(), offset));
+      if (!f.open(QIODevice::WriteOnly))
+            return;
+      f.write((const char*)&h, sizeof(h));
+      f.write((const char*)data, qint64(h.frames) * sizeof(short));
+      if (!f.commit())
+            qDebug("Sample::writeCache: cannot write <%s>", qPrintable(f.fileName()));
+      }
+
+//---------------------------------------------------------
+//   pruneCache
+//    remove the cached samples of former versions of this
+//    font and of fonts which do not exist anymore
+//---------------------------------------------------------
+
+void SFont::pruneCache() const
+      {
+      if (_cacheDir.isEmpty())
+            return;
+      QString path = QFileInfo(f.fileName()).absoluteFilePath();
+      QDir root(QFileInfo(_cacheDir).path());
+      for (const QFileInfo& fi : root.entryInfoList(QDir::Dirs | QDir::NoDotAndDotDot)) {
+            QString dir = fi.absoluteFilePath();
+            if (dir == QFileInfo(_cacheDir).absoluteFilePath())
+                  continue;
+            QString sourcePath;
+            QFile source(sourceFileName(dir));
+            if (source.open(QIODevice::ReadOnly)) {
+                  sourcePath = QString::fromUtf8(source.readAll());
+                  source.close();
+                  }
+            if (sourcePath == path || !QFileInfo::exists(sourcePath))
+                  QDir(dir).removeRecursively();
+            }
       }
 } // namespace
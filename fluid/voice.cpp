@@ -118,6 +118,13 @@ Voice::Voice(Fluid* f)
       modenv_data[FLUID_VOICE_ENVFINISHED].incr  = 0.0f;
       modenv_data[FLUID_VOICE_ENVFINISHED].min   = -1.0f;
       modenv_data[FLUID_VOICE_ENVFINISHED].max   = 1.0f;
+
+      // generating the data of a period does not allocate, see
+      // generateDataForDSPChain()
+      dsp_buf.reserve(RESERVED_FRAMES);
+      Sample2AmpInc.reserve(RESERVED_CHANGES);
+      _volumeChanges.reserve(RESERVED_CHANGES);
+      _volEnvSections.reserve(FLUID_VOICE_ENVLAST + 1);
       }
 
 //---------------------------------------------------------
@@ -272,8 +279,8 @@ bool Voice::generateDataForDSPChain(unsigned framesBufCount)
             
             fluid_env_data_t* env_data = &volenv_data[volenv_section];
             Sample2AmpInc.clear();
-            std::map<int, int> sample2VolEnvSection;
-            std::set<int> volumeChanges;
+            _volEnvSections.clear();
+            _volumeChanges.clear();
             
             if (volenv_section >= FLUID_VOICE_ENVFINISHED) {
                   off();
@@ -286,8 +293,8 @@ bool Voice::generateDataForDSPChain(unsigned framesBufCount)
             while (curVolEnvCount + restN >= env_data->count) {
                   restN -= env_data->count - curVolEnvCount;
                   
-                  sample2VolEnvSection.insert(std::pair<int, int>(framesBufCount - restN, volenv_section));
-                  volumeChanges.insert(framesBufCount-restN);
+                  _volEnvSections.push_back(std::make_pair(int(framesBufCount - restN), volenv_section));
+                  _volumeChanges.push_back(framesBufCount-restN);
                   
                   curVolEnvCount = 0;
                   volenv_section++;
@@ -295,8 +302,8 @@ bool Voice::generateDataForDSPChain(unsigned framesBufCount)
                   env_data = &volenv_data[volenv_section];
                   }
             
-            sample2VolEnvSection.insert(std::pair<int, int>(framesBufCount, volenv_section));
-            volumeChanges.insert(framesBufCount);
+            _volEnvSections.push_back(std::make_pair(int(framesBufCount), volenv_section));
+            _volumeChanges.push_back(framesBufCount);
             
             fluid_check_fpe ("voice_write vol env");
             
@@ -350,18 +357,22 @@ bool Voice::generateDataForDSPChain(unsigned framesBufCount)
                   
                   if (modLfoStart >= 0) {
                         if (modLfoStart > 0)
-                              volumeChanges.insert(modLfoStart);
+                              _volumeChanges.push_back(modLfoStart);
                         
                         unsigned int modLfoNextTurn = samplesToNextTurningPoint(modlfo_dur, modlfo_pos);
                         
                         while (modLfoNextTurn+modLfoStart < framesBufCount) {
-                              volumeChanges.insert(modLfoNextTurn+modLfoStart);
+                              _volumeChanges.push_back(modLfoNextTurn+modLfoStart);
                               modLfoNextTurn++;
                               modLfoNextTurn += samplesToNextTurningPoint(modlfo_dur, modLfoNextTurn);
                               }
                         }
                   }
             
+            // in place, as std::set would allocate its nodes
+            std::sort(_volumeChanges.begin(), _volumeChanges.end());
+            _volumeChanges.erase(std::unique(_volumeChanges.begin(), _volumeChanges.end()), _volumeChanges.end());
+
             fluid_check_fpe ("voice_write mod LFO");
             
             /******************* vib lfo **********************/
@@ -389,11 +400,12 @@ bool Voice::generateDataForDSPChain(unsigned framesBufCount)
             
             qreal oldTargetAmp = amp;
             int lastPos = 0;
-            auto oldVolEnvSection = sample2VolEnvSection.begin();
+            auto oldVolEnvSection = _volEnvSections.begin();
             auto curVolEnvSection = oldVolEnvSection;
             
-            for (auto curPos : volumeChanges)
+            for (size_t i = 0; i < _volumeChanges.size(); ++i)
             {
+                  int curPos = _volumeChanges[i];
                   if (modLfoStart >= 0 && curPos >= modLfoStart)
                         modlfo_val = triangle(modlfo_dur, modlfo_pos+curPos-modLfoStart);
                   else
@@ -407,8 +419,8 @@ bool Voice::generateDataForDSPChain(unsigned framesBufCount)
                         
                         // if we should calculate for position 1 already make sure we don't do it twice
                         // could lead to curPos==lastPos which causes devision by zero
-                        if (volumeChanges.find(1) != volumeChanges.end())
-                              volumeChanges.erase(volumeChanges.find(1));
+                        if (i + 1 < _volumeChanges.size() && _volumeChanges[i + 1] == 1)
+                              _volumeChanges.erase(_volumeChanges.begin() + i + 1);
                         }
                   
                   // just go to the next volume section if we're below last volume point
@@ -481,7 +493,7 @@ bool Voice::generateDataForDSPChain(unsigned framesBufCount)
                   /* Volume increment to go from voice->amp to target_amp in FLUID_BUFSIZE steps */
                   amp_incr = (target_amp - oldTargetAmp) / (curPos - lastPos);
                   lastPos = curPos;
-                  Sample2AmpInc.insert(std::pair<int, qreal>(curPos, amp_incr));
+                  Sample2AmpInc.push_back(std::make_pair(curPos, amp_incr));
                   
                   // if voice is turned off after this no need to calculate any more values
                   if (positionToTurnOff > 0)
@@ -1865,13 +1877,13 @@ void Voice::effects(int startBufIdx, int count, float* out, float* reverb, float
        * doesn't change.
        */
 
+      float* buf = dsp_buf.data() + startBufIdx;
       if (filter_coeff_incr_count > 0) {
             /* Increment is added to each filter coefficient filter_coeff_incr_count times. */
-            for (int i = startBufIdx; i < startBufIdx + count; i++) {
+            for (int i = 0; i < count; i++) {
                   /* The filter is implemented in Direct-II form. */
-                  auto& dspValRef = dsp_buf[i];
-                  float dsp_centernode = dspValRef - a1 * hist1 - a2 * hist2;
-                  dspValRef = b02 * (dsp_centernode + hist2) + b1 * hist1;
+                  float dsp_centernode = buf[i] - a1 * hist1 - a2 * hist2;
+                  buf[i] = b02 * (dsp_centernode + hist2) + b1 * hist1;
                   hist2 = hist1;
                   hist1 = dsp_centernode;
 
@@ -1881,38 +1893,42 @@ void Voice::effects(int startBufIdx, int count, float* out, float* reverb, float
                         b02 += b02_incr;
                         b1  += b1_incr;
                         }
-
-                  //code duplication is needed to optimize using std::vector::operator[]
-                  float vv = dspValRef * amp_left;
-                  *out++ += vv;
-                  *reverb++ += vv * amp_reverb;
-                  *chorus++ += vv * amp_chorus;
-
-                  vv = dspValRef * amp_right;
-                  *out++ += vv;
-                  *reverb++ += vv * amp_reverb;
-                  *chorus++ += vv * amp_chorus;
                   }
             }
       else { /* The filter parameters are constant.  This is duplicated to save time. */
-            for (int i = startBufIdx; i < startBufIdx + count; i++) {   // The filter is implemented in Direct-II form.
-                  auto& dspValRef = dsp_buf[i];
-                  float dsp_centernode = dspValRef - a1 * hist1 - a2 * hist2;
-                  dspValRef      = b02 * (dsp_centernode + hist2) + b1 * hist1;
-                  hist2          = hist1;
-                  hist1          = dsp_centernode;
-
-                  //code duplication is needed to optimize using std::vector::operator[]
-                  float vv = dspValRef * amp_left;
-                  *out++ += vv;
-                  *reverb++ += vv * amp_reverb;
-                  *chorus++ += vv * amp_chorus;
-
-                  vv = dspValRef * amp_right;
-                  *out++ += vv;
-                  *reverb++ += vv * amp_reverb;
-                  *chorus++ += vv * amp_chorus;
+            // keep the filter state in registers, dsp_buf could alias the members
+            float fa1    = a1;
+            float fa2    = a2;
+            float fb02   = b02;
+            float fb1    = b1;
+            float fhist1 = hist1;
+            float fhist2 = hist2;
+            for (int i = 0; i < count; i++) {   // The filter is implemented in Direct-II form.
+                  float dsp_centernode = buf[i] - fa1 * fhist1 - fa2 * fhist2;
+                  buf[i] = fb02 * (dsp_centernode + fhist2) + fb1 * fhist1;
+                  fhist2 = fhist1;
+                  fhist1 = dsp_centernode;
                   }
+            hist1 = fhist1;
+            hist2 = fhist2;
+            }
+
+      /* Mix into the output and effect buffers. This is kept out of
+       * the recursive filter loop so that the compiler can vectorize it.
+       */
+      const float left    = amp_left;
+      const float right   = amp_right;
+      const float rev     = amp_reverb;
+      const float cho     = amp_chorus;
+      for (int i = 0; i < count; i++) {
+            float vl = buf[i] * left;
+            float vr = buf[i] * right;
+            out[2 * i]        += vl;
+            out[2 * i + 1]    += vr;
+            reverb[2 * i]     += vl * rev;
+            reverb[2 * i + 1] += vr * rev;
+            chorus[2 * i]     += vl * cho;
+            chorus[2 * i + 1] += vr * cho;
             }
       }
 }
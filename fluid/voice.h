@@ -67,6 +67,12 @@ class Voice
       static float interp_coeff[FLUID_INTERP_MAX][4];
       static float sinc_table7[FLUID_INTERP_MAX][7];
 
+      static const unsigned RESERVED_FRAMES  = 2048;    // of dsp_buf
+      static const unsigned RESERVED_CHANGES = 64;      // amplitude changes in a period
+
+      // the amplitude increments, by the frame from which they apply
+      typedef std::vector<std::pair<int, qreal>> AmpIncs;
+
       Fluid* _fluid;
       double _noteTuning;             // +/- in midicent
 
@@ -79,6 +85,11 @@ class Voice
       std::vector<float> _cacheOut;
       std::vector<float> _cacheReverb;
       std::vector<float> _cacheChorus;
+
+      //Frames at which the amplitude is calculated and the volume envelope section which ends at a frame.
+      //Kept between periods, so that generateDataForDSPChain() does not allocate.
+      std::vector<int> _volumeChanges;
+      std::vector<std::pair<int, int>> _volEnvSections;
             
       /*
        / Applies effects to the calculated interpolation and put frames to output containers.
@@ -106,6 +117,8 @@ public:
 	unsigned char chan;             // the channel number, quick access for channel messages
 	unsigned char key;              // the key, quick access for noteoff
 	unsigned char vel;              // the velocity
+	int activeIndex = -1;           // index in Fluid::activeVoices, -1 if the voice is free
+	unsigned generation = 0;        // incremented by Fluid::alloc_voice() for every new note
 
 	Channel* channel;
 	Generator gen[GEN_LAST];
@@ -143,7 +156,7 @@ public:
 	fluid_env_data_t volenv_data[FLUID_VOICE_ENVLAST];
 	unsigned int volenv_count;
 	int volenv_section;
-   std::map<int, qreal> Sample2AmpInc;
+   AmpIncs Sample2AmpInc;
 	float volenv_val;
 	float amplitude_that_reaches_noise_floor_nonloop;
 	float amplitude_that_reaches_noise_floor_loop;
@@ -263,7 +276,7 @@ public:
       void add_mod(const Mod* mod, int mode);
 
       static void dsp_float_config();
-      bool updateAmpInc(unsigned int &nextNewAmpInc, std::map<int, qreal>::iterator &curSample2AmpInc, qreal &dsp_amp_incr, unsigned int &dsp_i);
+      bool updateAmpInc(float dsp_amp, unsigned int &nextNewAmpInc, AmpIncs::iterator &curSample2AmpInc, qreal &dsp_amp_incr, unsigned int &dsp_i);
       int dsp_float_interpolate_none(unsigned);
       int dsp_float_interpolate_linear(unsigned);
       int dsp_float_interpolate_4th_order(unsigned);
@@ -62,19 +62,17 @@ static void undoChangeBarLineType(BarLine* bl, BarLineType barType)
                   else if (segmentType == SegmentType::BeginBarLine) {
                         Segment* segment1 = m->undoGetSegmentR(SegmentType::BeginBarLine, 0);
                         for (Element* e : segment1->elist()) {
-                              if (e) {
-                                    e->score()->undo(new ChangeProperty(e, Pid::BARLINE_TYPE, QVariant::fromValue(barType), PropertyFlags::NOSTYLE));
-                                    e->score()->undo(new ChangeProperty(e, Pid::GENERATED, false, PropertyFlags::NOSTYLE));
-                                    }
-                              else {
-                                    auto score = bl->score();
-                                    BarLine* newBl = new BarLine(score);
-                                    newBl->setBarLineType(barType);
-                                    newBl->setParent(segment1);
-                                    newBl->setTrack(0);
-                                    newBl->setSpanStaff(score->nstaves());
-                                    newBl->score()->undo(new AddElement(newBl));
-                                    }
+                              e->score()->undo(new ChangeProperty(e, Pid::BARLINE_TYPE, QVariant::fromValue(barType), PropertyFlags::NOSTYLE));
+                              e->score()->undo(new ChangeProperty(e, Pid::GENERATED, false, PropertyFlags::NOSTYLE));
+                              }
+                        if (!segment1->element(0)) {
+                              auto score = bl->score();
+                              BarLine* newBl = new BarLine(score);
+                              newBl->setBarLineType(barType);
+                              newBl->setParent(segment1);
+                              newBl->setTrack(0);
+                              newBl->setSpanStaff(score->nstaves());
+                              newBl->score()->undo(new AddElement(newBl));
                               }
                         }
                   else if (segmentType == SegmentType::StartRepeatBarLine)
@@ -483,7 +481,7 @@ void BarLine::draw(QPainter* painter) const
             if (m->isIrregular() && score()->markIrregularMeasures() && !m->isMMRest()) {
                   painter->setPen(MScore::layoutBreakColor);
                   QFont f("FreeSerif");
-                  f.setPointSizeF(12 * spatium() * MScore::pixelRatio / SPATIUM20);
+                  f.setPointSizeF(12 * spatium() * MScore::pixelRatio() / SPATIUM20);
                   f.setBold(true);
                   QString str = m->len() > m->timesig() ? "+" : "-";
                   QRectF r = QFontMetricsF(f, MScore::paintDevice()).boundingRect(str);
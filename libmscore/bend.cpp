@@ -185,7 +185,7 @@ void Bend::draw(QPainter* painter) const
       painter->setPen(pen);
       painter->setBrush(QBrush(curColor()));
 
-      QFont f = font(_spatium * MScore::pixelRatio);
+      QFont f = font(_spatium * MScore::pixelRatio());
       painter->setFont(f);
       QFontMetrics fm(f, MScore::paintDevice());
 
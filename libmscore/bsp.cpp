@@ -94,6 +94,9 @@ void BspTree::initialize(const QRectF& rec, int n)
       nodes.resize((1 << (depth+1)) - 1);
       leaves.resize(1 << depth);
       leaves.fill(QList<Element*>());
+      itemRects.clear();
+      itemRects.reserve(n);
+      itemIndex.clear();
       initialize(rec, depth, 0);
       }
 
@@ -106,6 +109,8 @@ void BspTree::clear()
       leafCnt = 0;
       nodes.clear();
       leaves.clear();
+      itemRects.clear();
+      itemIndex.clear();
       }
 
 //---------------------------------------------------------
@@ -113,21 +118,134 @@ void BspTree::clear()
 //---------------------------------------------------------
 
 void BspTree::insert(Element* element)
+      {
+      QRectF r = element->pageBoundingRect();
+      insert(element, r);
+      itemRects.append(qMakePair(element, r));
+      if (!itemIndex.isEmpty())
+            itemIndex.insert(element, itemRects.size() - 1);
+      }
+
+void BspTree::insert(Element* element, const QRectF& r)
       {
       InsertItemBspTreeVisitor insertVisitor;
       insertVisitor.item = element;
-      climbTree(&insertVisitor, element->pageBoundingRect());
+      climbTree(&insertVisitor, r);
       }
 
 //---------------------------------------------------------
 //   remove
+//    the element is removed from the leaves it was
+//    inserted into; it is not accessed and may already
+//    be deleted
 //---------------------------------------------------------
 
 void BspTree::remove(Element* element)
+      {
+      int i = findItem(element, -1);
+      if (i < 0)
+            return;
+      QRectF r = itemRects[i].second;
+      itemRects.remove(i);
+      itemIndex.clear();
+      remove(element, r);
+      }
+
+void BspTree::remove(Element* element, const QRectF& r)
       {
       RemoveItemBspTreeVisitor removeVisitor;
       removeVisitor.item = element;
-      climbTree(&removeVisitor, element->pageBoundingRect());
+      climbTree(&removeVisitor, r);
+      }
+
+//---------------------------------------------------------
+//   findItem
+//    index of item in itemRects, -1 if it is not in the
+//    tree; pos is where the item is expected: the items
+//    of a page usually come in the same order as on the
+//    last update, then no hash is needed
+//---------------------------------------------------------
+
+int BspTree::findItem(Element* item, int pos)
+      {
+      if (pos >= 0 && pos < itemRects.size() && itemRects[pos].first == item)
+            return pos;
+      if (itemIndex.isEmpty()) {
+            itemIndex.reserve(itemRects.size());
+            for (int i = 0; i < itemRects.size(); ++i)
+                  itemIndex.insert(itemRects[i].first, i);
+            }
+      return itemIndex.value(item, -1);
+      }
+
+//---------------------------------------------------------
+//   mostlyMoved
+//    estimate from every eighth item whether most items
+//    are new or have a changed bounding rect
+//---------------------------------------------------------
+
+bool BspTree::mostlyMoved(const QList<Element*>& items)
+      {
+      int sampled = 0;
+      int moved   = 0;
+      int shift   = 0;      // of the items since the last update
+      for (int i = 0; i < items.size(); i += 8) {
+            Element* e = items[i];
+            int k = findItem(e, i + shift);
+            if (k >= 0)
+                  shift = k - i;
+            if (k < 0 || itemRects[k].second != e->pageBoundingRect())
+                  ++moved;
+            ++sampled;
+            }
+      return moved * 2 > sampled;
+      }
+
+//---------------------------------------------------------
+//   update
+//    Bring the tree in sync with a new list of items.
+//    Only items which are new, gone or have a changed
+//    bounding rect are touched. The tree is rebuilt if
+//    its rect or depth changes, or if most items moved:
+//    then moving them one by one costs more than
+//    inserting all of them into a new tree. A rebuild
+//    only appends the items to itemRects.
+//---------------------------------------------------------
+
+void BspTree::update(const QRectF& rec, const QList<Element*>& items)
+      {
+      if (nodes.empty() || rec != rect || intmaxlog(items.size()) != int(depth) || mostlyMoved(items)) {
+            initialize(rec, items.size());
+            for (Element* e : items)
+                  insert(e);
+            return;
+            }
+      QVector<QPair<Element*, QRectF>> newRects;
+      newRects.reserve(items.size());
+      QVector<bool> kept(itemRects.size(), false);
+      int shift = 0;
+      for (int i = 0; i < items.size(); ++i) {
+            Element* e = items[i];
+            QRectF r = e->pageBoundingRect();
+            int k = findItem(e, i + shift);
+            if (k >= 0) {
+                  shift = k - i;
+                  kept[k] = true;
+                  if (itemRects[k].second == r) {
+                        newRects.append(qMakePair(e, r));
+                        continue;
+                        }
+                  remove(e, itemRects[k].second);
+                  }
+            insert(e, r);
+            newRects.append(qMakePair(e, r));
+            }
+      for (int k = 0; k < itemRects.size(); ++k) {
+            if (!kept[k])
+                  remove(itemRects[k].first, itemRects[k].second);
+            }
+      itemRects.swap(newRects);
+      itemIndex.clear();
       }
 
 //---------------------------------------------------------
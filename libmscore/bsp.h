@@ -50,11 +50,18 @@ class BspTree
       void findItems(QList<Element*>* foundItems, const QRectF& rect, int index);
       void findItems(QList<Element*>* foundItems, const QPointF& pos, int index);
       QRectF rectForIndex(int index) const;
+      void insert(Element* item, const QRectF& r);
+      void remove(Element* item, const QRectF& r);
+      int findItem(Element* item, int pos);
+      bool mostlyMoved(const QList<Element*>& items);
 
       QVector<Node> nodes;
       QVector<QList<Element*> > leaves;
       int leafCnt;
       QRectF rect;
+      QVector<QPair<Element*, QRectF>> itemRects;     // items with their page bounding rect
+                                                      // when inserted, in insertion order
+      QHash<Element*, int> itemIndex;     // index into itemRects, built by findItem() when needed
 
    public:
       BspTree();
@@ -64,6 +71,7 @@ class BspTree
 
       void insert(Element* item);
       void remove(Element* item);
+      void update(const QRectF& rect, const QList<Element*>& items);
 
       QList<Element*> items(const QRectF& rect);
       QList<Element*> items(const QPointF& pos);
@@ -216,8 +216,10 @@ void Score::update()
             CmdState& cs = ms->cmdState();
             ms->deletePostponed();
             if (cs.layoutRange()) {
-                  for (Score* s : ms->scoreList())
+                  for (Score* s : ms->scoreList()) {
                         s->doLayoutRange(cs.startTick(), cs.endTick());
+                        s->setPlayEventsDirty(cs.startTick(), cs.endTick());
+                        }
                   updateAll = true;
                   }
             }
@@ -2077,7 +2079,7 @@ Element* Score::move(const QString& cmd)
                                     return 0;
                               }
                         // segment for sure contains chords/rests,
-                        int size = int(seg->elist().size());
+                        int size = seg->tracks();
                         // if segment has a chord/rest in original element track, use it
                         if (track > -1 && track < size && seg->element(track)) {
                               trg  = seg->element(track);
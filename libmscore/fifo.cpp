@@ -20,9 +20,10 @@ namespace Ms {
 
 void FifoBase::clear()
       {
-      ridx    = 0;
-      widx    = 0;
-      counter = 0;
+      ridx      = 0;
+      widx      = 0;
+      counter   = 0;
+      overflows = 0;
       }
 
 //---------------------------------------------------------
@@ -32,8 +33,8 @@ void FifoBase::clear()
 void FifoBase::push()
       {
       widx = (widx + 1) % maxCount;
-//      q_atomic_increment(&counter);
-      ++counter;
+      // publish the written slot to the reader
+      counter.fetch_add(1, std::memory_order_release);
       }
 
 //---------------------------------------------------------
@@ -43,8 +44,8 @@ void FifoBase::push()
 void FifoBase::pop()
       {
       ridx = (ridx + 1) % maxCount;
-      // q_atomic_decrement(&counter);
-      --counter;
+      // hand the read slot back to the writer
+      counter.fetch_sub(1, std::memory_order_release);
       }
 
 }
@@ -25,6 +25,8 @@ namespace Ms {
 //    - reader decrements counter
 //    - writer increments counter
 //    - counter increment/decrement must be atomic
+//    - neither side ever waits, a write to a full
+//      fifo is rejected and counted as overflow
 //---------------------------------------------------------
 
 class FifoBase {
@@ -33,18 +35,21 @@ class FifoBase {
       int ridx;                 // read index
       int widx;                 // write index
       std::atomic<int> counter; // objects in fifo
+      std::atomic<int> overflows; // rejected writes
       int maxCount;
 
       void push();
       void pop();
+      void overflow()         { overflows.fetch_add(1, std::memory_order_relaxed); }
 
    public:
       FifoBase()              { clear(); }
       virtual ~FifoBase()     {}
       void clear();
-      int count() const       { return counter; }
-      bool empty() const    { return counter == 0; }
-      bool isFull() const     { return maxCount == counter; }
+      int count() const       { return counter.load(std::memory_order_acquire); }
+      bool empty() const      { return count() == 0; }
+      bool isFull() const     { return maxCount == count(); }
+      int overflowCount() const { return overflows.load(std::memory_order_relaxed); }
       };
 
 
@@ -572,7 +572,7 @@ void FiguredBassItem::draw(QPainter* painter) const
 #endif
       // (use the same font selection as used in layout() above)
       qreal m = score()->styleD(Sid::figuredBassFontSize) * spatium() / SPATIUM20;
-      f.setPointSizeF(m * MScore::pixelRatio);
+      f.setPointSizeF(m * MScore::pixelRatio());
 
       painter->setFont(f);
       painter->setBrush(Qt::NoBrush);
@@ -293,7 +293,7 @@ void FretDiagram::draw(QPainter* painter) const
       QFont scaledFont(font);
       scaledFont.setPointSizeF(font.pointSize() * _userMag * score()->styleD(Sid::fretMag));
       QFontMetricsF fm(scaledFont, MScore::paintDevice());
-      scaledFont.setPointSizeF(scaledFont.pointSizeF() * MScore::pixelRatio);
+      scaledFont.setPointSizeF(scaledFont.pointSizeF() * MScore::pixelRatio());
 
       painter->setFont(scaledFont);
       qreal dotd = stringDist * .6;
@@ -331,7 +331,7 @@ void FretDiagram::draw(QPainter* painter) const
             }
       if (_fretOffset > 0) {
             qreal fretNumMag = score()->styleD(Sid::fretNumMag);
-            scaledFont.setPointSizeF(font.pointSize() * fretNumMag * _userMag * score()->styleD(Sid::fretMag) * MScore::pixelRatio);
+            scaledFont.setPointSizeF(font.pointSize() * fretNumMag * _userMag * score()->styleD(Sid::fretMag) * MScore::pixelRatio());
             painter->setFont(scaledFont);
             if (_numPos == 0) {
                   painter->drawText(QRectF(-stringDist *.4, .0, .0, fretDist),
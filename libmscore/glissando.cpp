@@ -106,7 +106,7 @@ void GlissandoSegment::draw(QPainter* painter) const
 
       if (glissando()->showText()) {
             QFont f(glissando()->fontFace());
-            f.setPointSizeF(glissando()->fontSize() * MScore::pixelRatio * _spatium / SPATIUM20);
+            f.setPointSizeF(glissando()->fontSize() * MScore::pixelRatio() * _spatium / SPATIUM20);
             f.setBold(glissando()->fontStyle() & FontStyle::Bold);
             f.setItalic(glissando()->fontStyle() & FontStyle::Italic);
             f.setUnderline(glissando()->fontStyle() & FontStyle::Underline);
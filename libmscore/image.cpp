@@ -133,7 +133,7 @@ void Image::draw(QPainter* painter) const
                   if (score()->printing() && !MScore::svgPrinting) {
                         // use original image size for printing, but not for svg for reasonable file size.
                         painter->scale(s.width() / rasterDoc->width(), s.height() / rasterDoc->height());
-                        painter->drawPixmap(QPointF(0, 0), QPixmap::fromImage(*rasterDoc));
+                        painter->drawImage(QPointF(0, 0), *rasterDoc);
                         }
                   else {
                         QTransform t = painter->transform();
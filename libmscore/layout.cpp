@@ -2454,6 +2454,16 @@ void Score::getNextMeasure(LayoutContext& lc)
                                     chord->computeUp();
                                     chord->layoutStem1();   // create stems needed to calculate spacing
                                                             // stem direction can change later during beam processing
+                                    if (MScore::parallelLayout && !st->isTabStaff()) {
+                                          // layoutChords3() adds missing dots with undo, which
+                                          // is not thread safe; see Note::setDotY()
+                                          for (Chord* c : chord->graceNotes()) {
+                                                for (Note* n : c->notes())
+                                                      n->updateDots();
+                                                }
+                                          for (Note* n : chord->notes())
+                                                n->updateDots();
+                                          }
                                     }
                               cr->setMag(m);
                               }
@@ -2475,22 +2485,60 @@ void Score::getNextMeasure(LayoutContext& lc)
 
       createBeams(measure);
 
-      for (int staffIdx = 0; staffIdx < score()->nstaves(); ++staffIdx) {
+      //
+      // layout note heads, accidentals and articulations;
+      // on standard staves every staff only touches the chords of
+      // its own tracks, so these staves can be processed concurrently.
+      // Tablature chords add and remove stems and hooks with undo
+      // (Chord::layoutTablature()) and are always laid out here
+      //
+      auto layoutStaffChords = [this, measure](int staffIdx) {
             for (Segment& segment : measure->segments()) {
-                  if (segment.isChordRestType()) {
-                        layoutChords1(&segment, staffIdx);
-                        for (int voice = 0; voice < VOICES; ++voice) {
-                              ChordRest* cr = segment.cr(staffIdx * VOICES + voice);
-                              if (cr) {
-                                    for (Lyrics* l : cr->lyrics()) {
-                                          if (l)
-                                                l->layout();
-                                          }
-                                    if (cr->isChord())
-                                          toChord(cr)->layoutArticulations();
-                                    }
+                  if (!segment.isChordRestType())
+                        continue;
+                  layoutChords1(&segment, staffIdx);
+                  for (int voice = 0; voice < VOICES; ++voice) {
+                        ChordRest* cr = segment.cr(staffIdx * VOICES + voice);
+                        if (cr && cr->isChord())
+                              toChord(cr)->layoutArticulations();
+                        }
+                  }
+            };
+      if (MScore::parallelLayout && nstaves() > 1) {
+            QVector<int> staffList;
+            for (int staffIdx = 0; staffIdx < nstaves(); ++staffIdx) {
+                  const Staff* staff = Score::staff(staffIdx);
+                  bool tab = false;
+                  for (Segment& segment : measure->segments()) {
+                        if (segment.isChordRestType() && staff->isTabStaff(segment.tick())) {
+                              tab = true;
+                              break;
                               }
                         }
+                  if (tab)
+                        layoutStaffChords(staffIdx);
+                  else
+                        staffList.append(staffIdx);
+                  }
+            QtConcurrent::blockingMap(staffList, [&layoutStaffChords](int& staffIdx) { layoutStaffChords(staffIdx); });
+            }
+      else {
+            for (int staffIdx = 0; staffIdx < nstaves(); ++staffIdx)
+                  layoutStaffChords(staffIdx);
+            }
+
+      // lyrics use text layout and are always done in score order
+      for (Segment& segment : measure->segments()) {
+            if (!segment.isChordRestType())
+                  continue;
+            for (int track = 0; track < ntracks(); ++track) {
+                  ChordRest* cr = segment.cr(track);
+                  if (!cr)
+                        continue;
+                  for (Lyrics* l : cr->lyrics()) {
+                        if (l)
+                              l->layout();
+                        }
                   }
             }
 
@@ -4020,6 +4068,8 @@ void LayoutContext::layout()
       do {
             getNextPage();
             collectPage();
+            if (rangeDone && reusablePagesFollow())
+                  return;
             } while (curSystem && !(rangeDone && page->system(0)->measures().back()->tick() > endTick)); // FIXME: perhaps the first measure was meant? Or last system?
       if (!curSystem) {
             // The end of the score. The remaining systems are not needed...
@@ -4037,6 +4087,28 @@ void LayoutContext::layout()
       score->systems().append(systemList);     // TODO
       }
 
+//---------------------------------------------------------
+//   reusablePagesFollow
+//    Once the relayouted range is done all following
+//    systems are taken unchanged. If the next system to
+//    place still starts the page it was on in the previous
+//    layout, that page and all pages after it are identical
+//    to the previous layout and can be kept as they are.
+//---------------------------------------------------------
+
+bool LayoutContext::reusablePagesFollow()
+      {
+      if (!curSystem || curPage >= score->npages())
+            return false;
+      Page* nextPage = score->pages()[curPage];
+      if (curSystem->page() != nextPage || nextPage->systems().empty() || nextPage->systems().front() != curSystem)
+            return false;
+      // the systems still in systemList belong to the kept pages
+      score->systems().append(systemList);
+      systemList.clear();
+      return true;
+      }
+
 //---------------------------------------------------------
 //   LayoutContext::~LayoutContext
 //---------------------------------------------------------
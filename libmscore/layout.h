@@ -59,6 +59,7 @@ struct LayoutContext {
       int adjustMeasureNo(MeasureBase*);
       void getNextPage();
       void collectPage();
+      bool reusablePagesFollow();
       };
 
 //---------------------------------------------------------
@@ -78,6 +78,7 @@
 #include "stafftypechange.h"
 #include "stafflines.h"
 #include "bracketItem.h"
+#include "synthesizer/event.h"
 
 namespace Ms {
 
@@ -95,6 +96,7 @@ class MStaff {
                                           ///< this changes some layout rules
       bool _visible          { true  };
       bool _slashStyle       { false };
+      EventMap* _playEvents  { 0 };         ///< cached midi events of this measure, 0 if not rendered
 #ifndef NDEBUG
       bool _corrupted        { false };
 #endif
@@ -127,6 +129,9 @@ class MStaff {
       bool slashStyle() const        { return _slashStyle; }
       void setSlashStyle(bool val)   { _slashStyle = val;  }
 
+      EventMap* playEvents() const   { return _playEvents; }
+      void setPlayEvents(EventMap* e);
+
 #ifndef NDEBUG
       bool corrupted() const         { return _corrupted; }
       void setCorrupted(bool val)    { _corrupted = val; }
@@ -139,6 +144,7 @@ MStaff::~MStaff()
       delete _lines;
       delete _vspacerUp;
       delete _vspacerDown;
+      delete _playEvents;
       }
 
 MStaff::MStaff(const MStaff& m)
@@ -155,6 +161,17 @@ MStaff::MStaff(const MStaff& m)
 #endif
       }
 
+//---------------------------------------------------------
+//   MStaff::setPlayEvents
+//---------------------------------------------------------
+
+void MStaff::setPlayEvents(EventMap* e)
+      {
+      if (e != _playEvents)
+            delete _playEvents;
+      _playEvents = e;
+      }
+
 //---------------------------------------------------------
 //   MStaff::setScore
 //---------------------------------------------------------
@@ -292,6 +309,19 @@ void Measure::setCorrupted(int staffIdx, bool val)              { _mstaves[staff
 
 void Measure::setNoText(int staffIdx, MeasureNumber* t)         { _mstaves[staffIdx]->setNoText(t); }
 MeasureNumber* Measure::noText(int staffIdx) const              { return _mstaves[staffIdx]->noText(); }
+const EventMap* Measure::playEvents(int staffIdx) const         { return _mstaves[staffIdx]->playEvents(); }
+void Measure::setPlayEvents(int staffIdx, EventMap* e)          { _mstaves[staffIdx]->setPlayEvents(e); }
+
+//---------------------------------------------------------
+//   setPlayEventsDirty
+//    drop the cached midi events of all staves
+//---------------------------------------------------------
+
+void Measure::setPlayEventsDirty()
+      {
+      for (MStaff* ms : _mstaves)
+            ms->setPlayEvents(0);
+      }
 
 //---------------------------------------------------------
 //   Measure
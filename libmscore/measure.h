@@ -41,6 +41,7 @@ class AccidentalState;
 class Spanner;
 class Part;
 class RepeatMeasure;
+class EventMap;
 
 class MStaff;
 
@@ -129,6 +130,9 @@ class Measure final : public MeasureBase {
       void setCorrupted(int staffIdx, bool val);
       void setNoText(int staffIdx, MeasureNumber*);
       MeasureNumber* noText(int staffIdx) const;
+      const EventMap* playEvents(int staffIdx) const;
+      void setPlayEvents(int staffIdx, EventMap*);
+      void setPlayEventsDirty();
 
       void createStaves(int);
 
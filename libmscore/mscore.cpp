@@ -63,6 +63,7 @@ namespace Ms {
 
 bool MScore::debugMode = false;
 bool MScore::testMode = false;
+bool MScore::parallelLayout = false;
 
 // #ifndef NDEBUG
 bool MScore::showSegmentShapes   = false;
@@ -74,6 +75,7 @@ bool MScore::showBoundingRect    = false;
 bool MScore::showSystemBoundingRect    = false;
 bool MScore::showCorruptedMeasures = true;
 bool MScore::useFallbackFont       = true;
+QString MScore::fontMetricsCacheDir;
 bool MScore::autoplaceSlurs        = true;
 // #endif
 
@@ -115,10 +117,12 @@ bool    MScore::noImages = false;
 bool    MScore::pdfPrinting = false;
 bool    MScore::svgPrinting = false;
 
-double  MScore::pixelRatio  = 0.8;        // DPI / logicalDPI
+double  MScore::_pixelRatio = 0.8;        // DPI / logicalDPI
 
 MPaintDevice* MScore::_paintDevice;
 
+thread_local const RenderContext* RenderContext::_current = 0;
+
 #ifdef SCRIPT_INTERFACE
 QQmlEngine* MScore::_qml = 0;
 #endif
@@ -209,6 +213,21 @@ void fillComboBoxDirection(QComboBox* cb)
       cb->addItem(qApp->translate("Direction", "Down"), QVariant::fromValue<Direction>(Direction::DOWN));
       }
 
+//---------------------------------------------------------
+//   RenderContext
+//---------------------------------------------------------
+
+RenderContext::RenderContext(double pixelRatio, bool printing)
+   : _previous(_current), _pixelRatio(pixelRatio), _printing(printing)
+      {
+      _current = this;
+      }
+
+RenderContext::~RenderContext()
+      {
+      _current = _previous;
+      }
+
 //---------------------------------------------------------
 //   doubleToSpatium
 //---------------------------------------------------------
@@ -298,6 +298,31 @@ class MPaintDevice : public QPaintDevice {
       virtual ~MPaintDevice() {}
       };
 
+//---------------------------------------------------------
+//   RenderContext
+//    Render state of the current thread. Exports install a
+//    context while they paint instead of changing the
+//    global pixel ratio and Score::setPrinting(), so pages
+//    can be painted on several threads at once.
+//---------------------------------------------------------
+
+class RenderContext {
+      static thread_local const RenderContext* _current;
+      const RenderContext* _previous;
+      double _pixelRatio;
+      bool _printing;
+
+   public:
+      RenderContext(double pixelRatio, bool printing = true);
+      ~RenderContext();
+      RenderContext(const RenderContext&) = delete;
+      RenderContext& operator=(const RenderContext&) = delete;
+
+      static const RenderContext* current() { return _current;    }
+      double pixelRatio() const            { return _pixelRatio; }
+      bool printing() const                { return _printing;   }
+      };
+
 //---------------------------------------------------------
 //   MScore
 //    MuseScore application object
@@ -317,6 +342,7 @@ class MScore : public QObject {
 #endif
 
       static MPaintDevice* _paintDevice;
+      static double _pixelRatio;
 
    public:
       enum class DirectionH : char { AUTO, LEFT, RIGHT };
@@ -373,10 +399,12 @@ class MScore : public QObject {
       static bool showSystemBoundingRect;
       static bool showCorruptedMeasures;
       static bool useFallbackFont;
+      static QString fontMetricsCacheDir;       // where computed score font metrics are kept, empty: none
       static bool autoplaceSlurs;
 // #endif
       static bool debugMode;
       static bool testMode;
+      static bool parallelLayout;
 
       static int division;
       static int sampleRate;
@@ -391,7 +419,13 @@ class MScore : public QObject {
 
       static bool pdfPrinting;
       static bool svgPrinting;
-      static double pixelRatio;
+
+      // DPI / logicalDPI of the paint device, overridden by the render context
+      static double pixelRatio() {
+            const RenderContext* c = RenderContext::current();
+            return c ? c->pixelRatio() : _pixelRatio;
+            }
+      static void setPixelRatio(double val) { _pixelRatio = val; }
 
       static qreal verticalPageGap;
       static qreal horizontalPageGapEven;
@@ -1142,7 +1142,7 @@ void Note::draw(QPainter* painter) const
                         }
                   }
             QFont f(tab->fretFont());
-            f.setPointSizeF(f.pointSizeF() * spatium() * MScore::pixelRatio / SPATIUM20);
+            f.setPointSizeF(f.pointSizeF() * spatium() * MScore::pixelRatio() / SPATIUM20);
             painter->setFont(f);
             painter->setPen(c);
             painter->drawText(QPointF(bbox().x(), tab->fretFontYOffset()), _fretString);
@@ -1941,10 +1941,23 @@ void Note::setDotY(Direction pos)
 
       // apply to dots
 
-      int cdots = chord()->dots();
-      int ndots = _dots.size();
+      updateDots();
+      for (NoteDot* dot : _dots) {
+            dot->layout();
+            dot->rypos() = y;
+            }
+      }
 
-      int n = cdots - ndots;
+//---------------------------------------------------------
+//   updateDots
+//    add or remove dots to match the dots of the chord;
+//    this pushes undo commands and so must not run in the
+//    parallel part of the layout
+//---------------------------------------------------------
+
+void Note::updateDots()
+      {
+      int n = chord()->dots() - _dots.size();
       for (int i = 0; i < n; ++i) {
             NoteDot* dot = new NoteDot(score());
             dot->setParent(this);
@@ -1956,10 +1969,6 @@ void Note::setDotY(Direction pos)
             for (int i = 0; i < -n; ++i)
                   score()->undoRemoveElement(_dots.back());
             }
-      for (NoteDot* dot : _dots) {
-            dot->layout();
-            dot->rypos() = y;
-            }
       }
 
 //---------------------------------------------------------
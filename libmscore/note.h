@@ -471,6 +471,7 @@ class Note final : public Element {
       void setMark(bool v) const      { _mark = v;   }
       virtual void setScore(Score* s) override;
       void setDotY(Direction);
+      void updateDots();
 
       void addParentheses();
 
@@ -32,6 +32,8 @@
 
 namespace Ms {
 
+static int layoutVersions = 0;
+
 //---------------------------------------------------------
 //   Page
 //---------------------------------------------------------
@@ -39,13 +41,27 @@ namespace Ms {
 Page::Page(Score* s)
    : Element(s, ElementFlag::NOT_SELECTABLE), _no(0)
       {
-      bspTreeValid = false;
+      rebuildBspTree();
       }
 
 Page::~Page()
       {
       }
 
+//---------------------------------------------------------
+//   rebuildBspTree
+//    called after the page was laid out again; the new
+//    layout version tells renderings of the page made
+//    before apart
+//---------------------------------------------------------
+
+void Page::rebuildBspTree()
+      {
+      bspTreeValid     = false;
+      displayListValid = false;
+      _layoutVersion   = ++layoutVersions;
+      }
+
 //---------------------------------------------------------
 //   items
 //---------------------------------------------------------
@@ -75,6 +91,29 @@ QList<Element*> Page::items(const QPointF& p)
 #endif
       }
 
+//---------------------------------------------------------
+//   displayList
+//    all elements of the page sorted by z with their page
+//    positions, so painting needs no tree lookup, sorting or
+//    parent walks; rebuilt with the bsp tree after layout
+//---------------------------------------------------------
+
+const std::vector<DisplayItem>& Page::displayList()
+      {
+      if (!displayListValid) {
+            QList<Element*> el = elements();
+            qStableSort(el.begin(), el.end(), elementLessThan);
+            _displayList.clear();
+            _displayList.reserve(el.size());
+            for (const Element* e : el) {
+                  QPointF pos(e->pagePos());
+                  _displayList.push_back({ e, pos, e->bbox().translated(pos) });
+                  }
+            displayListValid = true;
+            }
+      return _displayList;
+      }
+
 //---------------------------------------------------------
 //   appendSystem
 //---------------------------------------------------------
@@ -217,28 +256,15 @@ void Page::scanElements(void* data, void (*func)(void*, Element*), bool all)
       }
 
 #ifdef USE_BSP
-//---------------------------------------------------------
-//   bspInsert
-//---------------------------------------------------------
-
-static void bspInsert(void* bspTree, Element* e)
-      {
-      ((BspTree*) bspTree)->insert(e);
-      }
-
-static void countElements(void* data, Element* /*e*/)
-      {
-      ++(*(int*)data);
-      }
-
 //---------------------------------------------------------
 //   doRebuildBspTree
+//    only elements which moved since the last rebuild
+//    are reinserted
 //---------------------------------------------------------
 
 void Page::doRebuildBspTree()
       {
-      int n = 0;
-      scanElements(&n, countElements, false);
+      QList<Element*> el = elements();
 
       QRectF r;
       if (score()->layoutMode() == LayoutMode::LINE) {
@@ -256,8 +282,7 @@ void Page::doRebuildBspTree()
       else
             r = abbox();
 
-      bspTree.initialize(r, n);
-      scanElements(&bspTree, &bspInsert, false);
+      bspTree.update(r, el);
       bspTreeValid = true;
       }
 #endif
@@ -26,6 +26,18 @@ class XmlWriter;
 class Score;
 class MeasureBase;
 
+//---------------------------------------------------------
+//   DisplayItem
+//    element of a page as it is painted: its page position
+//    and page bounding rect as of the last layout
+//---------------------------------------------------------
+
+struct DisplayItem {
+      const Element* element;
+      QPointF pos;
+      QRectF bbox;
+      };
+
 //---------------------------------------------------------
 //   @@ Page
 //   @P pagenumber int (read only)
@@ -39,6 +51,9 @@ class Page final : public Element {
       void doRebuildBspTree();
 #endif
       bool bspTreeValid;
+      std::vector<DisplayItem> _displayList;
+      bool displayListValid { false };
+      int _layoutVersion;           // new for every layout of the page, unique among all pages
 
       QString replaceTextMacros(const QString&) const;
       void drawHeaderFooter(QPainter*, int area, const QString&) const;
@@ -70,7 +85,9 @@ class Page final : public Element {
 
       QList<Element*> items(const QRectF& r);
       QList<Element*> items(const QPointF& p);
-      void rebuildBspTree()   { bspTreeValid = false; }
+      void rebuildBspTree();
+      int layoutVersion() const { return _layoutVersion; }
+      const std::vector<DisplayItem>& displayList();
       QPointF pagePos() const { return QPointF(); }     ///< position in page coordinates
       QList<Element*> elements();               ///< list of visible elements
       QRectF tbbox();                           // tight bounding box, excluding white space
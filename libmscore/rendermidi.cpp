@@ -389,6 +389,58 @@ static void aeolusSetStop(int tick, int channel, int i, int k, bool val, EventMa
 //      events->insert(std::pair<int,NPlayEvent>(tick, event));
       }
 
+//---------------------------------------------------------
+//   collectMeasureControllers
+//    collect program changes and controller of the staff
+//    texts in measure m
+//---------------------------------------------------------
+
+static void collectMeasureControllers(EventMap* events, Measure* m, Staff* staff, int tickOffset)
+      {
+      int firstStaffIdx = staff->idx();
+      int nextStaffIdx  = firstStaffIdx + 1;
+
+      for (Segment* s = m->first(SegmentType::ChordRest); s; s = s->next(SegmentType::ChordRest)) {
+            // int tick = s->tick();
+            for (Element* e : s->annotations()) {
+                  if (!e->isStaffTextBase() || e->staffIdx() < firstStaffIdx || e->staffIdx() >= nextStaffIdx)
+                        continue;
+                  const StaffTextBase* st1 = toStaffTextBase(e);
+                  int tick = s->tick() + tickOffset;
+
+                  Instrument* instr = e->part()->instrument(s->tick());
+                  for (const ChannelActions& ca : *st1->channelActions()) {
+                        int channel = instr->channel().at(ca.channel)->channel();
+                        for (const QString& ma : ca.midiActionNames) {
+                              NamedEventList* nel = instr->midiAction(ma, ca.channel);
+                              if (!nel)
+                                    continue;
+                              for (MidiCoreEvent event : nel->events) {
+                                    event.setChannel(channel);
+                                    NPlayEvent e1(event);
+                                    e1.setOriginatingStaff(firstStaffIdx);
+                                    if (e1.dataA() == CTRL_PROGRAM)
+                                          events->insert(std::pair<int, NPlayEvent>(tick-1, e1));
+                                    else
+                                          events->insert(std::pair<int, NPlayEvent>(tick, e1));
+                                    }
+                              }
+                        }
+                  if (st1->setAeolusStops()) {
+                        Staff* s1 = st1->staff();
+                        int voice   = 0;
+                        int channel = s1->channel(s->tick(), voice);
+
+                        for (int i = 0; i < 4; ++i) {
+                              static int num[4] = { 12, 13, 16, 16 };
+                              for (int k = 0; k < num[i]; ++k)
+                                    aeolusSetStop(tick, channel, i, k, st1->getAeolusStop(i, k), events);
+                              }
+                        }
+                  }
+            }
+      }
+
 //---------------------------------------------------------
 //   collectMeasureEvents
 //---------------------------------------------------------
@@ -439,49 +491,42 @@ static void collectMeasureEvents(EventMap* events, Measure* m, Staff* staff, int
                               collectNote(events, channel, note, velocity, tickOffset, staffIdx);
                  }
             }
+      collectMeasureControllers(events, m, staff, tickOffset);
+      }
 
-      //
-      // collect program changes and controller
-      //
-      for (Segment* s = m->first(SegmentType::ChordRest); s; s = s->next(SegmentType::ChordRest)) {
-            // int tick = s->tick();
-            for (Element* e : s->annotations()) {
-                  if (!e->isStaffTextBase() || e->staffIdx() < firstStaffIdx || e->staffIdx() >= nextStaffIdx)
-                        continue;
-                  const StaffTextBase* st1 = toStaffTextBase(e);
-                  int tick = s->tick() + tickOffset;
+//---------------------------------------------------------
+//   measureEvents
+//    events of one measure and staff relative to the
+//    measure start; rendered on first use and cached in
+//    the measure until it is marked dirty
+//---------------------------------------------------------
 
-                  Instrument* instr = e->part()->instrument(tick);
-                  for (const ChannelActions& ca : *st1->channelActions()) {
-                        int channel = instr->channel().at(ca.channel)->channel();
-                        for (const QString& ma : ca.midiActionNames) {
-                              NamedEventList* nel = instr->midiAction(ma, ca.channel);
-                              if (!nel)
-                                    continue;
-                              for (MidiCoreEvent event : nel->events) {
-                                    event.setChannel(channel);
-                                    NPlayEvent e1(event);
-                                    e1.setOriginatingStaff(firstStaffIdx);
-                                    if (e1.dataA() == CTRL_PROGRAM)
-                                          events->insert(std::pair<int, NPlayEvent>(tick-1, e1));
-                                    else
-                                          events->insert(std::pair<int, NPlayEvent>(tick, e1));
-                                    }
-                              }
-                        }
-                  if (st1->setAeolusStops()) {
-                        Staff* s1 = st1->staff();
-                        int voice   = 0;
-                        int channel = s1->channel(tick, voice);
+static const EventMap* measureEvents(Measure* m, Staff* staff)
+      {
+      int staffIdx = staff->idx();
+      const EventMap* events = m->playEvents(staffIdx);
+      if (!events) {
+            EventMap* e = new EventMap;
+            collectMeasureEvents(e, m, staff, -m->tick());
+            m->setPlayEvents(staffIdx, e);
+            events = e;
+            }
+      return events;
+      }
 
-                        for (int i = 0; i < 4; ++i) {
-                              static int num[4] = { 12, 13, 16, 16 };
-                              for (int k = 0; k < num[i]; ++k)
-                                    aeolusSetStop(tick, channel, i, k, st1->getAeolusStop(i, k), events);
-                              }
-                        }
-                  }
-            }
+//---------------------------------------------------------
+//   addMeasureEvents
+//    add the cached events of measure m played at
+//    tick + tickOffset
+//---------------------------------------------------------
+
+static void addMeasureEvents(EventMap* events, Measure* m, Staff* staff, int tickOffset)
+      {
+      const EventMap* me = measureEvents(m, staff);
+      int offset = m->tick() + tickOffset;
+      events->registerChannel(me->highestChannel());
+      for (const auto& e : *me)
+            events->insert(std::pair<int, NPlayEvent>(e.first + offset, e.second));
       }
 
 //---------------------------------------------------------
@@ -676,6 +721,24 @@ void Score::updateVelo()
             }
       }
 
+//---------------------------------------------------------
+//   renderStaffMeasure
+//    lastMeasure is the last measure which is not a
+//    measure repeat, it is updated for the next call
+//---------------------------------------------------------
+
+void Score::renderStaffMeasure(EventMap* events, Staff* staff, Measure* m, int tickOffset, Measure*& lastMeasure)
+      {
+      if (lastMeasure && m->isRepeatMeasure(staff)) {
+            int offset = m->tick() - lastMeasure->tick();
+            addMeasureEvents(events, lastMeasure, staff, tickOffset + offset);
+            }
+      else {
+            lastMeasure = m;
+            addMeasureEvents(events, lastMeasure, staff, tickOffset);
+            }
+      }
+
 //---------------------------------------------------------
 //   renderStaff
 //---------------------------------------------------------
@@ -688,14 +751,7 @@ void Score::renderStaff(EventMap* events, Staff* staff)
             int endTick    = startTick + rs->len();
             int tickOffset = rs->utick - rs->tick;
             for (Measure* m = tick2measure(startTick); m; m = m->nextMeasure()) {
-                  if (lastMeasure && m->isRepeatMeasure(staff)) {
-                        int offset = m->tick() - lastMeasure->tick();
-                        collectMeasureEvents(events, lastMeasure, staff, tickOffset + offset);
-                        }
-                  else {
-                        lastMeasure = m;
-                        collectMeasureEvents(events, lastMeasure, staff, tickOffset);
-                        }
+                  renderStaffMeasure(events, staff, m, tickOffset, lastMeasure);
                   if (m->tick() + m->ticks() >= endTick)
                         break;
                   }
@@ -713,98 +769,111 @@ void Score::renderSpanners(EventMap* events)
             int utick1 = rs->utick;
             int tick1 = repeatList()->utick2tick(utick1);
             int tick2 = tick1 + rs->len();
-            std::map<int, std::vector<std::pair<int, std::pair<bool, int>>>> channelPedalEvents;
-            for (const auto& sp : _spanner.map()) {
-                  Spanner* s = sp.second;
+            renderSpanners(events, tick1, tick2, tickOffset);
+            }
+      }
 
-                  int staff = s->staffIdx();
-                  int idx = s->staff()->channel(s->tick(), 0);
-                  int channel = s->part()->instrument(s->tick())->channel(idx)->channel();
+//---------------------------------------------------------
+//   renderSpanners
+//    render spanners in the range tick1 - tick2
+//    played at tick + tickOffset
+//---------------------------------------------------------
 
-                  if (s->isPedal() || s->isLetRing()) {
-                        channelPedalEvents.insert({channel, std::vector<std::pair<int, std::pair<bool, int>>>()});
-                        std::vector<std::pair<int, std::pair<bool, int>>> pedalEventList = channelPedalEvents.at(channel);
-                        std::pair<int, std::pair<bool, int>> lastEvent;
+void Score::renderSpanners(EventMap* events, int tick1, int tick2, int tickOffset)
+      {
+      std::map<int, std::vector<std::pair<int, std::pair<bool, int>>>> channelPedalEvents;
+      for (const auto& sp : _spanner.map()) {
+            Spanner* s = sp.second;
 
-                        if (!pedalEventList.empty())
-                              lastEvent = pedalEventList.back();
-                        else
-                              lastEvent = std::pair<int, std::pair<bool, int>>(0, std::pair<bool, int>(true, staff));
+            int staff = s->staffIdx();
+            int idx = s->staff()->channel(s->tick(), 0);
+            int channel = s->part()->instrument(s->tick())->channel(idx)->channel();
 
-                        if (s->tick() >= tick1 && s->tick() < tick2) {
-                              // Handle "overlapping" pedal segments (usual case for connected pedal line)
-                              if (lastEvent.second.first == false && lastEvent.first >= (s->tick() + tickOffset + 2)) {
-                                    channelPedalEvents.at(channel).pop_back();
-                                    channelPedalEvents.at(channel).push_back(std::pair<int, std::pair<bool, int>>(s->tick() + tickOffset + 1, std::pair<bool, int>(false, staff)));
-                                    }
-                              channelPedalEvents.at(channel).push_back(std::pair<int, std::pair<bool, int>>(s->tick() + tickOffset + 2, std::pair<bool, int>(true, staff)));
-                              }
-                        if (s->tick2() >= tick1 && s->tick2() <= tick2) {
-                              int t = s->tick2() + tickOffset + 1;
-                              if (t > repeatList()->last()->utick + repeatList()->last()->len())
-                                    t = repeatList()->last()->utick + repeatList()->last()->len();
-                              channelPedalEvents.at(channel).push_back(std::pair<int, std::pair<bool, int>>(t, std::pair<bool, int>(false, staff)));
+            if (s->isPedal() || s->isLetRing()) {
+                  channelPedalEvents.insert({channel, std::vector<std::pair<int, std::pair<bool, int>>>()});
+                  std::vector<std::pair<int, std::pair<bool, int>>> pedalEventList = channelPedalEvents.at(channel);
+                  std::pair<int, std::pair<bool, int>> lastEvent;
+
+                  if (!pedalEventList.empty())
+                        lastEvent = pedalEventList.back();
+                  else
+                        lastEvent = std::pair<int, std::pair<bool, int>>(0, std::pair<bool, int>(true, staff));
+
+                  if (s->tick() >= tick1 && s->tick() < tick2) {
+                        // Handle "overlapping" pedal segments (usual case for connected pedal line)
+                        if (lastEvent.second.first == false && lastEvent.first >= (s->tick() + tickOffset + 2)) {
+                              channelPedalEvents.at(channel).pop_back();
+                              channelPedalEvents.at(channel).push_back(std::pair<int, std::pair<bool, int>>(s->tick() + tickOffset + 1, std::pair<bool, int>(false, staff)));
                               }
+                        channelPedalEvents.at(channel).push_back(std::pair<int, std::pair<bool, int>>(s->tick() + tickOffset + 2, std::pair<bool, int>(true, staff)));
+                        }
+                  if (s->tick2() >= tick1 && s->tick2() <= tick2) {
+                        int t = s->tick2() + tickOffset + 1;
+                        if (t > repeatList()->last()->utick + repeatList()->last()->len())
+                              t = repeatList()->last()->utick + repeatList()->last()->len();
+                        channelPedalEvents.at(channel).push_back(std::pair<int, std::pair<bool, int>>(t, std::pair<bool, int>(false, staff)));
+                        }
+                  }
+            else if (s->isVibrato()) {
+                  if (s->tick() < tick1 || s->tick() >= tick2)
+                        continue;
+                  // from start to end of trill, send bend events at regular interval
+                  Vibrato* t = toVibrato(s);
+                  // guitar vibrato, up only
+                  int spitch = 0; // 1/8 (100 is a semitone)
+                  int epitch = 12;
+                  if (t->vibratoType() == Vibrato::Type::GUITAR_VIBRATO_WIDE) {
+                        spitch = 0; // 1/4
+                        epitch = 25;
+                        }
+                  // vibrato with whammy bar up and down
+                  else if (t->vibratoType() == Vibrato::Type::VIBRATO_SAWTOOTH_WIDE) {
+                        spitch = 25; // 1/16
+                        epitch = -25;
+                        }
+                  else if (t->vibratoType() == Vibrato::Type::VIBRATO_SAWTOOTH) {
+                        spitch = 12;
+                        epitch = -12;
                         }
-                  else if (s->isVibrato()) {
-                        // from start to end of trill, send bend events at regular interval
-                        Vibrato* t = toVibrato(s);
-                        // guitar vibrato, up only
-                        int spitch = 0; // 1/8 (100 is a semitone)
-                        int epitch = 12;
-                        if (t->vibratoType() == Vibrato::Type::GUITAR_VIBRATO_WIDE) {
-                              spitch = 0; // 1/4
-                              epitch = 25;
-                              }
-                        // vibrato with whammy bar up and down
-                        else if (t->vibratoType() == Vibrato::Type::VIBRATO_SAWTOOTH_WIDE) {
-                              spitch = 25; // 1/16
-                              epitch = -25;
-                              }
-                        else if (t->vibratoType() == Vibrato::Type::VIBRATO_SAWTOOTH) {
-                              spitch = 12;
-                              epitch = -12;
-                              }
 
-                        int j = 0;
-                        int delta = MScore::division / 8; // 1/8 note
-                        int lastPointTick = s->tick();
-                        while (lastPointTick < s->tick2()) {
-                              int pitch = (j % 4 < 2) ? spitch : epitch;
-                              int nextPitch = ((j+1) % 4 < 2) ? spitch : epitch;
-                              int nextPointTick = lastPointTick + delta;
-                              for (int i = lastPointTick; i <= nextPointTick; i += 16) {
-                                    double dx = ((i - lastPointTick) * 60) / delta;
-                                    int p = pitch + dx * (nextPitch - pitch) / delta;
-                                    int midiPitch = (p * 16384) / 1200 + 8192;
-                                    int msb = midiPitch / 128;
-                                    int lsb = midiPitch % 128;
-                                    NPlayEvent ev(ME_PITCHBEND, channel, lsb, msb);
-                                    ev.setOriginatingStaff(staff);
-                                    events->insert(std::pair<int, NPlayEvent>(i, ev));
-                                    }
-                              lastPointTick = nextPointTick;
-                              j++;
+                  int j = 0;
+                  int delta = MScore::division / 8; // 1/8 note
+                  int lastPointTick = s->tick();
+                  while (lastPointTick < s->tick2()) {
+                        int pitch = (j % 4 < 2) ? spitch : epitch;
+                        int nextPitch = ((j+1) % 4 < 2) ? spitch : epitch;
+                        int nextPointTick = lastPointTick + delta;
+                        for (int i = lastPointTick; i <= nextPointTick; i += 16) {
+                              double dx = ((i - lastPointTick) * 60) / delta;
+                              int p = pitch + dx * (nextPitch - pitch) / delta;
+                              int midiPitch = (p * 16384) / 1200 + 8192;
+                              int msb = midiPitch / 128;
+                              int lsb = midiPitch % 128;
+                              NPlayEvent ev(ME_PITCHBEND, channel, lsb, msb);
+                              ev.setOriginatingStaff(staff);
+                              events->insert(std::pair<int, NPlayEvent>(i + tickOffset, ev));
                               }
-                        NPlayEvent ev(ME_PITCHBEND, channel, 0, 64); // no pitch bend
-                        ev.setOriginatingStaff(staff);
-                        events->insert(std::pair<int, NPlayEvent>(s->tick2(), ev));
+                        lastPointTick = nextPointTick;
+                        j++;
                         }
-                  else
-                        continue;
+                  NPlayEvent ev(ME_PITCHBEND, channel, 0, 64); // no pitch bend
+                  ev.setOriginatingStaff(staff);
+                  events->insert(std::pair<int, NPlayEvent>(s->tick2() + tickOffset, ev));
                   }
+            else
+                  continue;
+            }
 
-            for (const auto& pedalEvents : channelPedalEvents) {
-                  int channel = pedalEvents.first;
-                  for (const auto& pe : pedalEvents.second) {
-                        NPlayEvent event;
-                        if (pe.second.first == true)
-                              event = NPlayEvent(ME_CONTROLLER, channel, CTRL_SUSTAIN, 127);
-                        else
-                              event = NPlayEvent(ME_CONTROLLER, channel, CTRL_SUSTAIN, 0);
-                        event.setOriginatingStaff(pe.second.second);
-                        events->insert(std::pair<int,NPlayEvent>(pe.first, event));
-                        }
+      for (const auto& pedalEvents : channelPedalEvents) {
+            int channel = pedalEvents.first;
+            for (const auto& pe : pedalEvents.second) {
+                  NPlayEvent event;
+                  if (pe.second.first == true)
+                        event = NPlayEvent(ME_CONTROLLER, channel, CTRL_SUSTAIN, 127);
+                  else
+                        event = NPlayEvent(ME_CONTROLLER, channel, CTRL_SUSTAIN, 0);
+                  event.setOriginatingStaff(pe.second.second);
+                  events->insert(std::pair<int,NPlayEvent>(pe.first, event));
                   }
             }
       }
@@ -1871,13 +1940,7 @@ void Score::renderMidi(EventMap* events)
 
 void Score::renderMidi(EventMap* events, bool metronome, bool expandRepeats)
       {
-      updateSwing();
-      updateCapo();
-      createPlayEvents();
-
-      updateRepeatList(expandRepeats);
-      masterScore()->updateChannel();
-      updateVelo();
+      prepareMidi(expandRepeats);
 
       // create note & other events
       for (Staff* part : _staves)
@@ -1905,4 +1968,193 @@ void Score::renderMidi(EventMap* events, bool metronome, bool expandRepeats)
                   }
             }
       }
+
+//---------------------------------------------------------
+//   prepareMidi
+//    update play events, repeat list, channels and
+//    velocities; must be called before rendering
+//    chunks with renderMidiChunk()
+//---------------------------------------------------------
+
+void Score::prepareMidi(bool expandRepeats)
+      {
+      updateSwing();
+      updateCapo();
+      createPlayEvents();
+
+      updateRepeatList(expandRepeats);
+      masterScore()->updateChannel();
+      updateVelo();
+
+      // drop the cached measure events of staves whose
+      // velocities, channels, swing etc. have changed
+      for (Staff* staff : _staves) {
+            QVector<int> key = staff->playbackKey();
+            if (key == staff->playEventsKey())
+                  continue;
+            int staffIdx = staff->idx();
+            for (Measure* m = firstMeasure(); m; m = m->nextMeasure())
+                  m->setPlayEvents(staffIdx, 0);
+            staff->setPlayEventsKey(key);
+            }
+      }
+
+//---------------------------------------------------------
+//   tiedFromPrevMeasure
+//    true if a note at the start of m has a tie back
+//---------------------------------------------------------
+
+static bool tiedFromPrevMeasure(Measure* m)
+      {
+      Segment* s = m->first(SegmentType::ChordRest);
+      if (!s)
+            return false;
+      for (Element* e : s->elist()) {
+            if (!e || !e->isChord())
+                  continue;
+            for (Note* n : toChord(e)->notes()) {
+                  if (n->tieBack())
+                        return true;
+                  }
+            }
+      return false;
+      }
+
+//---------------------------------------------------------
+//   setPlayEventsDirty
+//    drop the cached midi events of the measures in the
+//    range tick1 - tick2; notes tied into the range and
+//    the measure after it depend on it too
+//---------------------------------------------------------
+
+void Score::setPlayEventsDirty(int tick1, int tick2)
+      {
+      Measure* fm = tick2measure(tick1);
+      if (!fm)
+            return;
+      while (fm->prevMeasure() && tiedFromPrevMeasure(fm))
+            fm = fm->prevMeasure();
+      Measure* lm = tick2measure(tick2);
+      if (!lm)
+            lm = lastMeasure();
+      if (lm->nextMeasure())
+            lm = lm->nextMeasure();
+      for (Measure* m = fm; m; m = m->nextMeasure()) {
+            m->setPlayEventsDirty();
+            if (m == lm)
+                  break;
+            }
+      }
+
+void Score::setPlayEventsDirty()
+      {
+      for (Measure* m = firstMeasure(); m; m = m->nextMeasure())
+            m->setPlayEventsDirty();
+      }
+
+//---------------------------------------------------------
+//   midiChunks
+//    split the repeat list into chunks of at least
+//    minMeasures measures; a chunk never crosses
+//    the end of a repeat segment
+//---------------------------------------------------------
+
+std::vector<MidiChunk> Score::midiChunks(int minMeasures)
+      {
+      std::vector<MidiChunk> chunks;
+      for (const RepeatSegment* rs : *repeatList()) {
+            int endTick    = rs->tick + rs->len();
+            int tickOffset = rs->utick - rs->tick;
+            Measure* first = 0;
+            int n          = 0;
+            for (Measure* m = tick2measure(rs->tick); m; m = m->nextMeasure()) {
+                  if (!first)
+                        first = m;
+                  bool segmentEnd = m->tick() + m->ticks() >= endTick;
+                  if (++n >= minMeasures || segmentEnd || !m->nextMeasure()) {
+                        chunks.push_back({ first, m, tickOffset, first->tick(), m->endTick() });
+                        first = 0;
+                        n     = 0;
+                        }
+                  if (segmentEnd)
+                        break;
+                  }
+            }
+      return chunks;
+      }
+
+//---------------------------------------------------------
+//   renderMidiControllers
+//    render the program changes and controllers of the
+//    whole playlist without the notes; the sequencer
+//    replays them after a seek into chunks which are not
+//    rendered yet. prepareMidi() must have been called before
+//---------------------------------------------------------
+
+void Score::renderMidiControllers(EventMap* events)
+      {
+      for (Staff* staff : _staves) {
+            Measure* lastMeasure = 0;
+            for (const RepeatSegment* rs : *repeatList()) {
+                  int endTick    = rs->tick + rs->len();
+                  int tickOffset = rs->utick - rs->tick;
+                  for (Measure* m = tick2measure(rs->tick); m; m = m->nextMeasure()) {
+                        // see renderStaffMeasure()
+                        if (lastMeasure && m->isRepeatMeasure(staff))
+                              collectMeasureControllers(events, lastMeasure, staff, tickOffset + m->tick() - lastMeasure->tick());
+                        else {
+                              lastMeasure = m;
+                              collectMeasureControllers(events, m, staff, tickOffset);
+                              }
+                        if (m->tick() + m->ticks() >= endTick)
+                              break;
+                        }
+                  }
+            }
+      EventMap spannerEvents;
+      renderSpanners(&spannerEvents);
+      for (const auto& p : spannerEvents) {
+            if (p.second.type() == ME_CONTROLLER)
+                  events->insert(p);
+            }
+      }
+
+//---------------------------------------------------------
+//   renderMidiChunk
+//    render the events of one chunk, prepareMidi() must
+//    have been called before
+//---------------------------------------------------------
+
+void Score::renderMidiChunk(EventMap* events, const MidiChunk& chunk, bool metronome)
+      {
+      for (Staff* staff : _staves) {
+            // a measure repeat at the start of the chunk plays
+            // the last measure before it
+            Measure* lastMeasure = 0;
+            if (chunk.first->isRepeatMeasure(staff)) {
+                  for (Measure* m = chunk.first->prevMeasure(); m; m = m->prevMeasure()) {
+                        if (!m->isRepeatMeasure(staff)) {
+                              lastMeasure = m;
+                              break;
+                              }
+                        }
+                  }
+            for (Measure* m = chunk.first; m; m = m->nextMeasure()) {
+                  renderStaffMeasure(events, staff, m, chunk.tickOffset, lastMeasure);
+                  if (m == chunk.last)
+                        break;
+                  }
+            }
+      events->fixupMIDI();
+
+      renderSpanners(events, chunk.tick1, chunk.tick2, chunk.tickOffset);
+
+      if (!metronome)
+            return;
+      for (Measure* m = chunk.first; m; m = m->nextMeasure()) {
+            renderMetronome(events, m, chunk.tickOffset);
+            if (m == chunk.last)
+                  break;
+            }
+      }
 }
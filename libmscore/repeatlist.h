@@ -43,6 +43,23 @@ class RepeatSegment {
       friend class RepeatList;
       };
 
+//---------------------------------------------------------
+//   MidiChunk
+//    consecutive measures of one repeat segment,
+//    the unit of windowed midi rendering
+//---------------------------------------------------------
+
+struct MidiChunk {
+      Measure* first;
+      Measure* last;
+      int tickOffset;         // utick - tick
+      int tick1;              // start tick of first
+      int tick2;              // end tick of last
+
+      int utick1() const { return tick1 + tickOffset; }
+      int utick2() const { return tick2 + tickOffset; }
+      };
+
 //---------------------------------------------------------
 //   RepeatList
 //---------------------------------------------------------
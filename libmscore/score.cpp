@@ -475,8 +475,8 @@ void Score::fixTicks()
                               }
 #if 0 // TODO::fermata
                         qreal stretch = 0.0;
-                        for (unsigned i = 0; i < s->elist().size(); ++i) {
-                              Element* e = s->elist().at(i);
+                        for (int i = 0; i < s->tracks(); ++i) {
+                              Element* e = s->element(i);
                               if (!e)
                                     continue;
                               ChordRest* cr = toChordRest(e);
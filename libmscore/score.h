@@ -86,6 +86,7 @@ class Channel;
 struct Interval;
 struct TEvent;
 struct LayoutContext;
+struct MidiChunk;
 
 enum class Tid;
 enum class ClefType : signed char;
@@ -522,8 +523,10 @@ class Score : public QObject, public ScoreElement {
       void resetTempo();
       void resetTempoRange(int tick1, int tick2);
 
+      void renderStaffMeasure(EventMap* events, Staff*, Measure* m, int tickOffset, Measure*& lastMeasure);
       void renderStaff(EventMap* events, Staff*);
       void renderSpanners(EventMap* events);
+      void renderSpanners(EventMap* events, int tick1, int tick2, int tickOffset);
       void renderMetronome(EventMap* events, Measure* m, int tickOffset);
       void updateVelo();
 
@@ -766,6 +769,7 @@ class Score : public QObject, public ScoreElement {
       bool exportFile();
 
       void print(QPainter* printer, int page);
+      QImage renderPage(int page, qreal dpi, int trimMargin = -1, bool transparent = false) const;
       ChordRest* getSelectedChordRest() const;
       QSet<ChordRest*> getSelectedChordRests() const;
       void getSelectedChordRest2(ChordRest** cr1, ChordRest** cr2) const;
@@ -816,7 +820,10 @@ class Score : public QObject, public ScoreElement {
       bool saved() const             { return _saved;         }
       void setSaved(bool v)          { _saved = v;            }
       void setSavedCapture(bool v)   { _savedCapture = v;     }
-      bool printing() const          { return _printing;      }
+      bool printing() const          {
+            const RenderContext* c = RenderContext::current();
+            return c ? c->printing() : _printing;
+            }
       void setPrinting(bool val)     { _printing = val;      }
       void setAutosaveDirty(bool v)  { _autosaveDirty = v;    }
       bool autosaveDirty() const     { return _autosaveDirty; }
@@ -883,6 +890,12 @@ class Score : public QObject, public ScoreElement {
       void pasteSymbols(XmlReader& e, ChordRest* dst);
       void renderMidi(EventMap* events);
       void renderMidi(EventMap* events, bool metronome, bool expandRepeats);
+      void prepareMidi(bool expandRepeats);
+      std::vector<MidiChunk> midiChunks(int minMeasures);
+      void renderMidiChunk(EventMap* events, const MidiChunk&, bool metronome);
+      void renderMidiControllers(EventMap* events);
+      void setPlayEventsDirty(int tick1, int tick2);
+      void setPlayEventsDirty();
 
       BeatType tick2beatType(int tick);
 
@@ -42,7 +42,12 @@ class MscxModeDiff {
             Tag(int l, TagType t, const QString& n) : line(l), type(t), name(n) {}
             };
 
+      typedef std::pair<QStringRef, dtl::edit_t> LineEdit;
+
       static DiffType fromDtlDiffType(dtl::edit_t dtlType);
+      static void lineEdits(const std::vector<QStringRef>& lines1, int start1, int end1,
+         const std::vector<QStringRef>& lines2, int start2, int end2, std::vector<LineEdit>& edits);
+      static std::vector<TextDiff> diffsFromEdits(const std::vector<LineEdit>& edits);
 
       void adjustSemanticsMscx(std::vector<TextDiff>&);
       int adjustSemanticsMscxOneDiff(std::vector<TextDiff>& diffs, int index);
@@ -57,6 +62,7 @@ class MscxModeDiff {
       MscxModeDiff();
 
       std::vector<TextDiff> lineModeDiff(const QString& s1, const QString& s2);
+      std::vector<TextDiff> measureModeDiff(const QString& s1, const QString& s2);
       std::vector<TextDiff> mscxModeDiff(const QString& s1, const QString& s2);
       };
 
@@ -112,33 +118,154 @@ DiffType MscxModeDiff::fromDtlDiffType(dtl::edit_t dtlType)
       }
 
 //---------------------------------------------------------
-//   MscxModeDiff::lineModeDiff
+//   MscxModeDiff::lineEdits
+//    Append the line edit script for the line ranges
+//    [start1, end1) and [start2, end2) to edits.
 //---------------------------------------------------------
 
-std::vector<TextDiff> MscxModeDiff::lineModeDiff(const QString& s1, const QString& s2)
+void MscxModeDiff::lineEdits(const std::vector<QStringRef>& lines1, int start1, int end1,
+   const std::vector<QStringRef>& lines2, int start2, int end2, std::vector<LineEdit>& edits)
       {
       // type declarations for dtl library
       typedef QStringRef elem;
       typedef std::pair<elem, dtl::elemInfo> sesElem;
       typedef std::vector<sesElem> sesElemVec;
 
+      if (start1 == end1 || start2 == end2) {
+            // nothing to compare, no need to run dtl
+            for (int i = start1; i < end1; ++i)
+                  edits.emplace_back(lines1[i], dtl::SES_DELETE);
+            for (int i = start2; i < end2; ++i)
+                  edits.emplace_back(lines2[i], dtl::SES_ADD);
+            return;
+            }
+
+      std::vector<QStringRef> l1(lines1.begin() + start1, lines1.begin() + end1);
+      std::vector<QStringRef> l2(lines2.begin() + start2, lines2.begin() + end2);
+      dtl::Diff<QStringRef, std::vector<QStringRef>> diff(l1, l2);
+
+      diff.compose();
+
+      const sesElemVec changes = diff.getSes().getSequence();
+      for (const sesElem& ch : changes)
+            edits.emplace_back(ch.first, ch.second.type);
+      }
+
+//---------------------------------------------------------
+//   MscxModeDiff::lineModeDiff
+//---------------------------------------------------------
+
+std::vector<TextDiff> MscxModeDiff::lineModeDiff(const QString& s1, const QString& s2)
+      {
       // QVector does not contain range constructor used inside dtl
       // so we have to convert to std::vector.
       std::vector<QStringRef> lines1 = s1.splitRef('\n').toStdVector();
       std::vector<QStringRef> lines2 = s2.splitRef('\n').toStdVector();
-      dtl::Diff<QStringRef, std::vector<QStringRef>> diff(lines1, lines2);
 
+      std::vector<LineEdit> edits;
+      lineEdits(lines1, 0, int(lines1.size()), lines2, 0, int(lines2.size()), edits);
+      return diffsFromEdits(edits);
+      }
+
+//---------------------------------------------------------
+//   measureChunks
+//    Split MSCX lines into chunks ending after a
+//    </Measure> line, so that every measure of every
+//    staff gets its own chunk. Returns the end line of
+//    each chunk, the hash of its text goes to hashes.
+//---------------------------------------------------------
+
+static std::vector<int> measureChunks(const std::vector<QStringRef>& lines, std::vector<uint>& hashes)
+      {
+      std::vector<int> ends;
+      uint h = 0;
+      const int n = int(lines.size());
+      for (int i = 0; i < n; ++i) {
+            h = qHash(lines[i], h * 31);
+            if (i == n - 1 || lines[i].trimmed() == QLatin1String("</Measure>")) {
+                  ends.push_back(i + 1);
+                  hashes.push_back(h);
+                  h = 0;
+                  }
+            }
+      return ends;
+      }
+
+//---------------------------------------------------------
+//   MscxModeDiff::measureModeDiff
+//    Line diff which compares the hashes of measure chunks
+//    first and runs the line diff only on the chunks
+//    which differ. Gives the same kind of result as
+//    lineModeDiff but is much cheaper for large scores
+//    with few changes.
+//---------------------------------------------------------
+
+std::vector<TextDiff> MscxModeDiff::measureModeDiff(const QString& s1, const QString& s2)
+      {
+      std::vector<QStringRef> lines1 = s1.splitRef('\n').toStdVector();
+      std::vector<QStringRef> lines2 = s2.splitRef('\n').toStdVector();
+      std::vector<uint> hashes1;
+      std::vector<uint> hashes2;
+      const std::vector<int> ends1 = measureChunks(lines1, hashes1);
+      const std::vector<int> ends2 = measureChunks(lines2, hashes2);
+
+      dtl::Diff<uint, std::vector<uint>> diff(hashes1, hashes2);
       diff.compose();
+      const std::vector<std::pair<uint, dtl::elemInfo>> chunkChanges = diff.getSes().getSequence();
+
+      std::vector<LineEdit> edits;
+      edits.reserve(std::max(lines1.size(), lines2.size()));
+      int chunk[2]   { 0, 0 };      // next chunk in both texts
+      int changed[2] { 0, 0 };      // first line of the pending changed region
+      auto chunkStart = [&ends1, &ends2](int score, int c) {
+            return c == 0 ? 0 : (score == 0 ? ends1 : ends2)[c - 1];
+            };
 
-      const sesElemVec changes = diff.getSes().getSequence();
+      for (const auto& ch : chunkChanges) {
+            switch (ch.second.type) {
+                  case dtl::SES_DELETE:
+                        ++chunk[0];
+                        break;
+                  case dtl::SES_ADD:
+                        ++chunk[1];
+                        break;
+                  case dtl::SES_COMMON: {
+                        const int start1 = chunkStart(0, chunk[0]);
+                        const int start2 = chunkStart(1, chunk[1]);
+                        const int end1   = ends1[chunk[0]++];
+                        const int end2   = ends2[chunk[1]++];
+                        // equal hashes: compare the text to rule out collisions
+                        if (end1 - start1 != end2 - start2
+                           || !std::equal(lines1.begin() + start1, lines1.begin() + end1, lines2.begin() + start2))
+                              break;
+                        lineEdits(lines1, changed[0], start1, lines2, changed[1], start2, edits);
+                        for (int i = start1; i < end1; ++i)
+                              edits.emplace_back(lines1[i], dtl::SES_COMMON);
+                        changed[0] = end1;
+                        changed[1] = end2;
+                        }
+                        break;
+                  }
+            }
+      lineEdits(lines1, changed[0], int(lines1.size()), lines2, changed[1], int(lines2.size()), edits);
+      return diffsFromEdits(edits);
+      }
+
+//---------------------------------------------------------
+//   MscxModeDiff::diffsFromEdits
+//    Collect a line edit script into TextDiffs
+//---------------------------------------------------------
+
+std::vector<TextDiff> MscxModeDiff::diffsFromEdits(const std::vector<LineEdit>& edits)
+      {
       std::vector<TextDiff> diffs;
       int line[2][2] {{1, 1}, {1, 1}}; // for correct assigning line numbers to
                                        // DELETE and INSERT diffs we need to
                                        // count lines separately for these diff
                                        // types (EQUAL can use both counters).
 
-      for (const sesElem& ch : changes) {
-            DiffType type = fromDtlDiffType(ch.second.type);
+      for (const LineEdit& ch : edits) {
+            DiffType type = fromDtlDiffType(ch.second);
             const int iThis = (type == DiffType::DELETE) ? 0 : 1; // for EQUAL doesn't matter
 
             if (diffs.empty() || diffs.back().type != type) {
@@ -185,7 +312,7 @@ std::vector<TextDiff> MscxModeDiff::lineModeDiff(const QString& s1, const QStrin
 
 std::vector<TextDiff> MscxModeDiff::mscxModeDiff(const QString& s1, const QString& s2)
       {
-      std::vector<TextDiff> diffs = lineModeDiff(s1, s2);
+      std::vector<TextDiff> diffs = measureModeDiff(s1, s2);
       adjustSemanticsMscx(diffs);
       return diffs;
       }
@@ -522,17 +522,15 @@ QImage Score::createThumbnail()
       pm.setDotsPerMeterY(dpm);
       pm.fill(0xffffffff);
 
-      double pr = MScore::pixelRatio;
-      MScore::pixelRatio = 1.0;
-
+      {
+      RenderContext rc(1.0);
       QPainter p(&pm);
       p.setRenderHint(QPainter::Antialiasing, true);
       p.setRenderHint(QPainter::TextAntialiasing, true);
       p.scale(mag, mag);
       print(&p, 0);
       p.end();
-
-      MScore::pixelRatio = pr;
+      }
 
       if (layoutMode() != mode) {
             setLayoutMode(mode);
@@ -995,6 +993,55 @@ void Score::print(QPainter* painter, int pageNo)
       _printing = false;
       }
 
+//---------------------------------------------------------
+//   renderPage
+//    rasterize page pageNo at dpi; with trimMargin >= 0 the
+//    image is cropped to the page content plus the margin.
+//    The score is not changed, so several threads may
+//    render pages of the same score at once.
+//---------------------------------------------------------
+
+QImage Score::renderPage(int pageNo, qreal dpi, int trimMargin, bool transparent) const
+      {
+      qreal mag = dpi / DPI;
+      RenderContext rc(1.0 / mag);        // don’t print page break symbols etc.
+
+      Page* page = pages().at(pageNo);
+      QRectF r;
+      if (trimMargin >= 0) {
+            QMarginsF margins(trimMargin, trimMargin, trimMargin, trimMargin);
+            r = page->tbbox() + margins;
+            }
+      else
+            r = page->abbox();
+      int w = lrint(r.width()  * mag);
+      int h = lrint(r.height() * mag);
+
+      QImage image(w, h, QImage::Format_ARGB32_Premultiplied);
+      image.setDotsPerMeterX(lrint((dpi * 1000) / INCH));
+      image.setDotsPerMeterY(lrint((dpi * 1000) / INCH));
+      image.fill(transparent ? 0 : 0xffffffff);
+
+      QPainter p(&image);
+      p.setRenderHint(QPainter::Antialiasing, true);
+      p.setRenderHint(QPainter::TextAntialiasing, true);
+      p.scale(mag, mag);
+      if (trimMargin >= 0)
+            p.translate(-r.topLeft());
+      QList<Element*> el = page->elements();
+      qStableSort(el.begin(), el.end(), elementLessThan);
+      for (const Element* e : el) {
+            if (!e->visible())
+                  continue;
+            QPointF pos(e->pagePos());
+            p.translate(pos);
+            e->draw(&p);
+            p.translate(-pos);
+            }
+      p.end();
+      return image;
+      }
+
 //---------------------------------------------------------
 //   readCompressedToBuffer
 //---------------------------------------------------------
@@ -78,11 +78,11 @@ void Segment::setElement(int track, Element* el)
       {
       if (el) {
             el->setParent(this);
-            _elist[track] = el;
+            _elist.set(track, el);
             setEmpty(false);
             }
       else {
-            _elist[track] = 0;
+            _elist.remove(track);
             checkEmpty();
             }
       }
@@ -141,14 +141,10 @@ Segment::Segment(const Segment& s)
       for (Element* e : s._annotations)
             add(e->clone());
 
-      _elist.reserve(s._elist.size());
-      for (Element* e : s._elist) {
-            Element* ne = 0;
-            if (e) {
-                  ne = e->clone();
-                  ne->setParent(this);
-                  }
-            _elist.push_back(ne);
+      _elist = s._elist;
+      for (Element*& e : _elist.values()) {
+            e = e->clone();
+            e->setParent(this);
             }
       _dotPosX = s._dotPosX;
       _shapes  = s._shapes;
@@ -171,19 +167,15 @@ void Segment::setSegmentType(SegmentType t)
 void Segment::setScore(Score* score)
       {
       Element::setScore(score);
-      for (Element* e : _elist) {
-            if (e)
-                  e->setScore(score);
-            }
+      for (Element* e : _elist.values())
+            e->setScore(score);
       for (Element* e : _annotations)
             e->setScore(score);
       }
 
 Segment::~Segment()
       {
-      for (Element* e : _elist) {
-            if (!e)
-                  continue;
+      for (Element* e : _elist.values()) {
             if (e->isTimeSig())
                   e->staff()->removeTimeSig(toTimeSig(e));
             delete e;
@@ -198,9 +190,9 @@ void Segment::init()
       {
       int staves = score()->nstaves();
       int tracks = staves * VOICES;
-      _elist.assign(tracks, 0);
+      _elist.assign(tracks);
       _dotPosX.assign(staves, 0.0);
-      _shapes.assign(staves, Shape());
+      _shapes.assign(staves);
       _prev = 0;
       _next = 0;
       }
@@ -403,11 +395,9 @@ ChordRest* Segment::nextChordRest(int track, bool backwards) const
 
 void Segment::insertStaff(int staff)
       {
-      int track = staff * VOICES;
-      for (int voice = 0; voice < VOICES; ++voice)
-            _elist.insert(_elist.begin() + track, 0);
-      _dotPosX.insert(_dotPosX.begin()+staff, 0.0);
-      _shapes.insert(_shapes.begin()+staff, Shape());
+      _elist.insert(staff * VOICES, VOICES);
+      _dotPosX.insert(_dotPosX.begin() + staff, 0.0);
+      _shapes.insert(staff, 1);
 
       for (Element* e : _annotations) {
             int staffIdx = e->staffIdx();
@@ -423,10 +413,9 @@ void Segment::insertStaff(int staff)
 
 void Segment::removeStaff(int staff)
       {
-      int track = staff * VOICES;
-      _elist.erase(_elist.begin() + track, _elist.begin() + track + VOICES);
+      _elist.erase(staff * VOICES, VOICES);
       _dotPosX.erase(_dotPosX.begin() + staff);
-      _shapes.erase(_shapes.begin()+staff);
+      _shapes.erase(staff, 1);
 
       for (Element* e : _annotations) {
             int staffIdx = e->staffIdx();
@@ -444,9 +433,10 @@ void Segment::removeStaff(int staff)
 void Segment::checkElement(Element* el, int track)
       {
       // generated elements can be overwritten
-      if (_elist[track] && !_elist[track]->generated()) {
+      Element* e = _elist.value(track);
+      if (e && !e->generated()) {
             qDebug("add(%s): there is already a %s at %s(%d) track %d. score %p %s",
-               el->name(), _elist[track]->name(),
+               el->name(), e->name(),
                qPrintable(score()->sigmap()->pos(tick())), tick(), track, score(), score()->isMaster() ? "Master" : "Part");
 //            abort();
             }
@@ -465,11 +455,11 @@ void Segment::add(Element* el)
       int track = el->track();
       Q_ASSERT(track != -1);
       Q_ASSERT(el->score() == score());
-      Q_ASSERT(score()->nstaves() * VOICES == int(_elist.size()));
+      Q_ASSERT(score()->nstaves() * VOICES == _elist.size());
 
       switch (el->type()) {
             case ElementType::REPEAT_MEASURE:
-                  _elist[track] = el;
+                  _elist.set(track, el);
                   setEmpty(false);
                   break;
 
@@ -511,7 +501,7 @@ void Segment::add(Element* el)
             case ElementType::CLEF:
                   Q_ASSERT(_segmentType == SegmentType::Clef || _segmentType == SegmentType::HeaderClef);
                   checkElement(el, track);
-                  _elist[track] = el;
+                  _elist.set(track, el);
                   if (!el->generated()) {
                         el->staff()->setClef(toClef(el));
 //                        updateNoteLines(this, el->track());   TODO::necessary?
@@ -522,7 +512,7 @@ void Segment::add(Element* el)
             case ElementType::TIMESIG:
                   Q_ASSERT(segmentType() == SegmentType::TimeSig || segmentType() == SegmentType::TimeSigAnnounce);
                   checkElement(el, track);
-                  _elist[track] = el;
+                  _elist.set(track, el);
                   el->staff()->addTimeSig(toTimeSig(el));
                   setEmpty(false);
                   break;
@@ -530,7 +520,7 @@ void Segment::add(Element* el)
             case ElementType::KEYSIG:
                   Q_ASSERT(_segmentType == SegmentType::KeySig || _segmentType == SegmentType::KeySigAnnounce);
                   checkElement(el, track);
-                  _elist[track] = el;
+                  _elist.set(track, el);
                   if (!el->generated())
                         el->staff()->setKey(tick(), toKeySig(el)->keySigEvent());
                   setEmpty(false);
@@ -571,7 +561,7 @@ void Segment::add(Element* el)
             case ElementType::BREATH:
                   if (track < score()->nstaves() * VOICES) {
                         checkElement(el, track);
-                        _elist[track] = el;
+                        _elist.set(track, el);
                         }
                   setEmpty(false);
                   break;
@@ -579,7 +569,7 @@ void Segment::add(Element* el)
             case ElementType::AMBITUS:
                   Q_ASSERT(_segmentType == SegmentType::Ambitus);
                   checkElement(el, track);
-                  _elist[track] = el;
+                  _elist.set(track, el);
                   setEmpty(false);
                   break;
 
@@ -602,7 +592,7 @@ void Segment::remove(Element* el)
             case ElementType::CHORD:
             case ElementType::REST:
                   {
-                  _elist[track] = 0;
+                  _elist.remove(track);
                   int staffIdx = el->staffIdx();
                   measure()->checkMultiVoices(staffIdx);
                   // spanners with this cr as start or end element will need relayout
@@ -623,7 +613,7 @@ void Segment::remove(Element* el)
                   break;
 
             case ElementType::REPEAT_MEASURE:
-                  _elist[track] = 0;
+                  _elist.remove(track);
                   break;
 
             case ElementType::DYNAMIC:
@@ -662,14 +652,14 @@ void Segment::remove(Element* el)
                   break;
 
             case ElementType::TIMESIG:
-                  _elist[track] = 0;
+                  _elist.remove(track);
                   el->staff()->removeTimeSig(toTimeSig(el));
                   break;
 
             case ElementType::KEYSIG:
-                  Q_ASSERT(_elist[track] == el);
+                  Q_ASSERT(_elist.value(track) == el);
 
-                  _elist[track] = 0;
+                  _elist.remove(track);
                   if (!el->generated())
                         el->staff()->removeKey(tick());
                   break;
@@ -681,11 +671,11 @@ void Segment::remove(Element* el)
 
             case ElementType::BAR_LINE:
             case ElementType::AMBITUS:
-                  _elist[track] = 0;
+                  _elist.remove(track);
                   break;
 
             case ElementType::BREATH:
-                  _elist[track] = 0;
+                  _elist.remove(track);
                   score()->setPause(tick(), 0);
                   break;
 
@@ -733,16 +723,18 @@ SegmentType Segment::segmentType(ElementType type)
 
 void Segment::sortStaves(QList<int>& dst)
       {
-      std::vector<Element*> dl;
-      dl.reserve(dst.size());
+      SparseArray<Element*> dl;
+      dl.assign(dst.size() * VOICES);
 
       for (int i = 0; i < dst.size(); ++i) {
             int startTrack = dst[i] * VOICES;
-            int endTrack   = startTrack + VOICES;
-            for (int k = startTrack; k < endTrack; ++k)
-                  dl.push_back(_elist[k]);
+            for (int voice = 0; voice < VOICES; ++voice) {
+                  Element* e = _elist.value(startTrack + voice);
+                  if (e)
+                        dl.append(i * VOICES + voice, e);
+                  }
             }
-      std::swap(_elist, dl);
+      _elist.swap(dl);
       QMap<int, int> map;
       for (int k = 0; k < dst.size(); ++k) {
             map.insert(dst[k], k);
@@ -760,12 +752,7 @@ void Segment::sortStaves(QList<int>& dst)
 
 void Segment::fixStaffIdx()
       {
-      int track = 0;
-      for (Element* e : _elist) {
-            if (e)
-                  e->setTrack(track);
-            ++track;
-            }
+      _elist.forEach([](int track, Element* e) { e->setTrack(track); });
       }
 
 //---------------------------------------------------------
@@ -778,13 +765,7 @@ void Segment::checkEmpty() const
             setEmpty(false);
             return;
             }
-      setEmpty(true);
-      for (const Element* e : _elist) {
-            if (e) {
-                  setEmpty(false);
-                  break;
-                  }
-            }
+      setEmpty(_elist.empty());
       }
 
 //---------------------------------------------------------
@@ -813,11 +794,18 @@ Fraction Segment::afrac() const
 
 void Segment::swapElements(int i1, int i2)
       {
-      std::iter_swap(_elist.begin() + i1, _elist.begin() + i2);
-      if (_elist[i1])
-            _elist[i1]->setTrack(i1);
-      if (_elist[i2])
-            _elist[i2]->setTrack(i2);
+      Element* e1 = _elist.value(i1);
+      Element* e2 = _elist.value(i2);
+      _elist.remove(i1);
+      _elist.remove(i2);
+      if (e2) {
+            _elist.set(i1, e2);
+            e2->setTrack(i1);
+            }
+      if (e1) {
+            _elist.set(i2, e1);
+            e1->setTrack(i2);
+            }
       score()->setLayout(tick());
       }
 
@@ -913,8 +901,8 @@ bool Segment::setProperty(Pid propertyId, const QVariant& v)
 
 bool Segment::splitsTuplet() const
       {
-      for (Element* e : _elist) {
-            if (!(e && e->isChordRest()))
+      for (Element* e : _elist.values()) {
+            if (!e->isChordRest())
                   continue;
             ChordRest* cr = toChordRest(e);
             Tuplet* t = cr->tuplet();
@@ -971,11 +959,21 @@ bool Segment::operator>(const Segment& s) const
 
 bool Segment::hasElements() const
       {
-      for (const Element* e : _elist) {
-            if (e)
-                  return true;
-            }
-      return false;
+      return !_elist.empty();
+      }
+
+//---------------------------------------------------------
+//   storageBytes
+///  return the memory used for the per track and per staff
+///  storage of this segment, including the shapes
+//---------------------------------------------------------
+
+size_t Segment::storageBytes() const
+      {
+      size_t n = _elist.bytes() + _shapes.bytes() + _dotPosX.capacity() * sizeof(qreal);
+      for (const Shape& s : _shapes.values())
+            n += s.capacity() * sizeof(ShapeElement);
+      return n;
       }
 
 //---------------------------------------------------------
@@ -1054,7 +1052,7 @@ void Segment::clearAnnotations()
 
 Ms::Element* Segment::elementAt(int track) const
       {
-      Element* e = track < int(_elist.size()) ? _elist[track] : 0;
+      Element* e = _elist.value(track);
 
 #ifdef SCRIPT_INTERFACE
 // if called from QML/JS, tell QML engine not to garbage collect this object
@@ -1872,9 +1870,32 @@ void Segment::createShapes()
 
 void Segment::createShape(int staffIdx)
       {
-      Shape& s = _shapes[staffIdx];
-      s.clear();
+      Shape s;
+      addShapes(s, staffIdx);
+      if (s.empty())
+            _shapes.remove(staffIdx);
+      else
+            std::swap(_shapes.get(staffIdx), s);
+      }
+
+//---------------------------------------------------------
+//   staffShape
+//---------------------------------------------------------
+
+const Shape& Segment::staffShape(int staffIdx) const
+      {
+      static const Shape empty;
+      const Shape* s = _shapes.find(staffIdx);
+      return s ? *s : empty;
+      }
+
+//---------------------------------------------------------
+//   addShapes
+//    add the shapes of all elements of staff staffIdx to s
+//---------------------------------------------------------
 
+void Segment::addShapes(Shape& s, int staffIdx) const
+      {
       if (segmentType() & (SegmentType::BarLine | SegmentType::EndBarLine | SegmentType::StartRepeatBarLine | SegmentType::BeginBarLine)) {
             BarLine* bl = toBarLine(element(0));
             if (bl) {
@@ -1889,16 +1910,14 @@ void Segment::createShape(int staffIdx)
             }
 #if 0
       for (int track = staffIdx * VOICES; track < (staffIdx + 1) * VOICES; ++track) {
-            Element* e = _elist[track];
+            Element* e = element(track);
             if (e)
                   s.add(e->shape().translated(e->pos()));
             }
 #endif
       int strack = staffIdx * VOICES;
       int etrack = strack + VOICES;
-      for (Element* e : _elist) {
-            if (!e)
-                  continue;
+      for (Element* e : _elist.values()) {
             int effectiveTrack = e->vStaffIdx() * VOICES + e->voice();
             if (effectiveTrack >= strack && effectiveTrack < etrack)
                   s.add(e->shape().translated(e->pos()));
@@ -1974,10 +1993,12 @@ qreal Segment::minLeft() const
 qreal Segment::minHorizontalCollidingDistance(Segment* ns) const
       {
       qreal w = 0.0;
-      for (unsigned staffIdx = 0; staffIdx < _shapes.size(); ++staffIdx) {
-            qreal d = staffShape(staffIdx).minHorizontalDistance(ns->staffShape(staffIdx));
-            w       = qMax(w, d);
-            }
+      // an empty shape on either side does not add to the distance
+      _shapes.forEach([ns, &w](int staffIdx, const Shape& sh) {
+            const Shape* nsh = ns->_shapes.find(staffIdx);
+            if (nsh)
+                  w = qMax(w, sh.minHorizontalDistance(*nsh));
+            });
       return w;
       }
 
@@ -1989,10 +2010,12 @@ qreal Segment::minHorizontalCollidingDistance(Segment* ns) const
 qreal Segment::minHorizontalDistance(Segment* ns, bool systemHeaderGap) const
       {
       qreal w = 0.0;
-      for (unsigned staffIdx = 0; staffIdx < _shapes.size(); ++staffIdx) {
-            qreal d = staffShape(staffIdx).minHorizontalDistance(ns->staffShape(staffIdx));
-            w       = qMax(w, d);
-            }
+      // an empty shape on either side does not add to the distance
+      _shapes.forEach([ns, &w](int staffIdx, const Shape& sh) {
+            const Shape* nsh = ns->_shapes.find(staffIdx);
+            if (nsh)
+                  w = qMax(w, sh.minHorizontalDistance(*nsh));
+            });
 
       SegmentType st  = segmentType();
       SegmentType nst = ns ? ns->segmentType() : SegmentType::Invalid;
@@ -15,6 +15,7 @@
 
 #include "element.h"
 #include "shape.h"
+#include "sparsearray.h"
 #include "mscore.h"
 
 namespace Ms {
@@ -67,7 +68,12 @@ constexpr bool operator& (const SegmentType t1, const SegmentType t2) {
 //    All Elements in a segment start at the same tick. The Segment can store one Element for
 //    each voice in each staff in the score.
 //    Some elements (Clef, KeySig, TimeSig etc.) are assumed to always have voice zero
-//    and can be found in _elist[staffIdx * VOICES];
+//    and can be found in element(staffIdx * VOICES).
+//
+//    Most tracks of a segment are empty in larger scores, so elements
+//    and shapes are kept in SparseArrays which store only the occupied
+//    tracks and staves. Dot positions stay dense: they are set while the
+//    staves of a measure are laid out concurrently.
 
 //    Segments are children of Measures and store Clefs, KeySigs, TimeSigs,
 //    BarLines and ChordRests.
@@ -92,14 +98,15 @@ class Segment final : public Element {
       Segment* _prev;
 
       std::vector<Element*> _annotations;
-      std::vector<Element*> _elist;       // Element storage, size = staves * VOICES.
-      std::vector<Shape>    _shapes;      // size = staves
-      std::vector<qreal>    _dotPosX;     // size = staves
+      SparseArray<Element*> _elist;       // Element storage, size = staves * VOICES.
+      SparseArray<Shape>    _shapes;      // non empty shapes, size = staves
+      std::vector<qreal>    _dotPosX;     // size = staves, dense: written by concurrent staff layout
 
 
       void init();
       void checkEmpty() const;
       void checkElement(Element*, int track);
+      void addShapes(Shape&, int staffIdx) const;
       void setEmpty(bool val) const { setFlag(ElementFlag::EMPTY, val); }
 
    protected:
@@ -145,14 +152,15 @@ class Segment final : public Element {
 
       ChordRest* nextChordRest(int track, bool backwards = false) const;
 
-      Element* element(int track) const { return _elist[track];  }
+      Element* element(int track) const { return _elist.value(track);  }
+      int tracks() const                { return _elist.size();        }
 
       // a variant of the above function, specifically designed to be called from QML
       //@ returns the element at track 'track' (null if none)
       Q_INVOKABLE Ms::Element* elementAt(int track) const;
 
-      const std::vector<Element*>& elist() const { return _elist; }
-      std::vector<Element*>& elist()             { return _elist; }
+      // all elements of the segment in track order, empty tracks are skipped
+      const std::vector<Element*>& elist() const { return _elist.values(); }
 
       void removeElement(int track);
       void setElement(int track, Element* el);
@@ -205,6 +213,7 @@ class Segment final : public Element {
       Element* findAnnotation(ElementType type, int minTrack, int maxTrack);
       std::vector<Element*> findAnnotations(ElementType type, int minTrack, int maxTrack);
       bool hasElements() const;
+      size_t storageBytes() const;
 
 
       qreal dotPosX(int staffIdx) const          { return _dotPosX[staffIdx];  }
@@ -246,10 +255,9 @@ class Segment final : public Element {
       using Element::prevElement;
       Element* prevElement(int activeStaff);
 
-      std::vector<Shape> shapes()                     { return _shapes; }
-      const std::vector<Shape>& shapes() const        { return _shapes; }
-      const Shape& staffShape(int staffIdx) const     { return _shapes[staffIdx]; }
-      Shape& staffShape(int staffIdx)                 { return _shapes[staffIdx]; }
+      // the non empty staff shapes; empty staves have no shape
+      const std::vector<Shape>& shapes() const        { return _shapes.values(); }
+      const Shape& staffShape(int staffIdx) const;
       void createShapes();
       void createShape(int staffIdx);
       qreal minRight() const;
@@ -259,7 +267,7 @@ class Segment final : public Element {
       qreal minHorizontalCollidingDistance(Segment* ns) const;
 
       // some helper function
-      ChordRest* cr(int track) const        { return toChordRest(_elist[track]); }
+      ChordRest* cr(int track) const        { return toChordRest(_elist.value(track)); }
       bool isType(const SegmentType t) const{ return int(_segmentType) & int(t); }
       bool isBeginBarLineType() const       { return _segmentType == SegmentType::BeginBarLine; }
       bool isClefType() const               { return _segmentType == SegmentType::Clef; }
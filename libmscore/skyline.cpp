@@ -63,86 +63,131 @@ void Skyline::add(const Shape& s)
 
 void SkylineLine::add(qreal x, qreal y, qreal w)
       {
+      updateX(addSegment(x, y, w));
+      }
+
+//---------------------------------------------------------
+//   insert
+//    the start position is set by updateX()
+//---------------------------------------------------------
+
+void SkylineLine::insert(size_t idx, qreal y, qreal w)
+      {
+      _x.insert(_x.begin() + idx, 0.0);
+      _y.insert(_y.begin() + idx, y);
+      _w.insert(_w.begin() + idx, w);
+      }
+
+//---------------------------------------------------------
+//   updateX
+//    recompute segment start positions from segment from
+//    on, after add() changed its width or inserted it
+//---------------------------------------------------------
+
+void SkylineLine::updateX(size_t from)
+      {
+      if (from >= _w.size())
+            return;
+      qreal x = from ? _x[from - 1] + _w[from - 1] : 0.0;
+      for (size_t i = from; i < _w.size(); ++i) {
+            _x[i] = x;
+            x += _w[i];
+            }
+      }
+
+//---------------------------------------------------------
+//   addSegment
+//    return the first segment whose width changed or which
+//    was inserted, size() if there is none
+//---------------------------------------------------------
+
+size_t SkylineLine::addSegment(qreal x, qreal y, qreal w)
+      {
 //      Q_ASSERT(w >= 0.0);
       if (x < 0.0) {
             w -= -x;
             x = 0.0;
             if (w <= 0.0)
-                  return;
+                  return size();
             }
 
       DP("===add  %f %f %f\n", x, y, w);
+      size_t first = size();
       qreal cx = 0.0;
-      for (auto i = begin(); i != end(); ++i) {
-            qreal cy = i->y;
+      for (size_t i = 0; i < _y.size(); ++i) {
+            qreal cy = _y[i];
             if ((x + w) <= cx)                                          // A
-                  return; // break;
-            if (x > (cx + i->w)) {                                      // B
-                  cx += i->w;
+                  return first; // break;
+            if (x > (cx + _w[i])) {                                     // B
+                  cx += _w[i];
                   continue;
                   }
             if ((north && (cy <= y)) || (!north && (cy >= y))) {
-                  cx += i->w;
+                  cx += _w[i];
                   continue;
                   }
-            if ((x >= cx) && ((x+w) < (cx+i->w))) {                     // (E) insert segment
-                  DP("    insert at %f %f   x:%f w:%f\n", cx, i->w, x, w);
+            if ((x >= cx) && ((x+w) < (cx+_w[i]))) {                    // (E) insert segment
+                  DP("    insert at %f %f   x:%f w:%f\n", cx, _w[i], x, w);
                   qreal w1 = x - cx;
                   qreal w2 = w;
-                  qreal w3 = i->w - (w1 + w2);
+                  qreal w3 = _w[i] - (w1 + w2);
+                  first = qMin(first, i);
                   if (w1 > 0.0000001) {
-                        i->w = w1;
+                        _w[i] = w1;
                         ++i;
-                        i = insert(i, SkylineSegment(y, w2));
+                        insert(i, y, w2);
                         DP("       A w1 %f w2 %f\n", w1, w2);
                         }
                   else {
-                        i->w = w2;
-                        i->y = y;
+                        _w[i] = w2;
+                        _y[i] = y;
                         DP("       B w2 %f\n", w2);
                         }
                   if (w3 > 0.0000001) {
                         ++i;
                         DP("       C w3 %f\n", w3);
-                        insert(i, SkylineSegment(cy, w3));
+                        insert(i, cy, w3);
                         }
-                  return;
+                  return first;
                   }
-            else if ((x <= cx) && ((x + w) >= (cx + i->w))) {               // F
+            else if ((x <= cx) && ((x + w) >= (cx + _w[i]))) {              // F
                   DP("    change(F) cx %f y %f\n", cx, y);
-                  i->y = y;
+                  _y[i] = y;
                   }
             else if (x < cx) {                                          // C
                   qreal w1 = x + w - cx;
-                  i->w    -= w1;
-                  DP("    add(C) cx %f y %f w %f w1 %f\n", cx, y, w1, i->w);
-                  insert(i, SkylineSegment(y, w1));
-                  return;
+                  _w[i]   -= w1;
+                  DP("    add(C) cx %f y %f w %f w1 %f\n", cx, y, w1, _w[i]);
+                  insert(i, y, w1);
+                  return qMin(first, i);
                   }
             else {                                                      // D
                   qreal w1 = x - cx;
-                  qreal w2 = i->w - w1;
+                  qreal w2 = _w[i] - w1;
                   if (w2 > 0.0000001) {
-                        i->w = w1;
-                        cx  += w1;
+                        first = qMin(first, i);
+                        _w[i] = w1;
+                        cx   += w1;
                         DP("    add(D) %f %f\n", y, w2);
                         ++i;
-                        i = insert(i, SkylineSegment(y, w2));
+                        insert(i, y, w2);
                         }
                   }
-            cx += i->w;
+            cx += _w[i];
             }
+      first = qMin(first, size());
       if (x >= cx) {
             if (x > cx) {
                   qreal cy = north ? MAXIMUM_Y : MINIMUM_Y;
                   DP("    append1 %f %f\n", cy, x - cx);
-                  push_back(SkylineSegment(cy, x - cx));
+                  append(cy, x - cx);
                   }
             DP("    append2 %f %f\n", y, w);
-            push_back(SkylineSegment(y, w));
+            append(y, w);
             }
       else if (x + w > cx)
-            push_back(SkylineSegment(y, x + w - cx));
+            append(y, x + w - cx);
+      return first;
       }
 
 //---------------------------------------------------------
@@ -155,6 +200,13 @@ void Skyline::clear()
       _south.clear();
       }
 
+void SkylineLine::clear()
+      {
+      _x.clear();
+      _y.clear();
+      _w.clear();
+      }
+
 //-------------------------------------------------------------------
 //   minDistance
 //    a is located below this skyline.
@@ -170,31 +222,35 @@ qreal SkylineLine::minDistance(const SkylineLine& sl) const
       {
       qreal dist = MINIMUM_Y;
 
-      qreal x1 = 0.0;
-      qreal x2 = 0.0;
-      auto k   = sl.begin();
-      for (auto i = begin(); i != end(); ++i) {
-            while (k != sl.end() && (x2 + k->w) < x1) {
-                  x2 += k->w;
+      const size_t n1 = size();
+      const size_t n2 = sl.size();
+      const qreal* x2 = sl._x.data();
+      const qreal* y2 = sl._y.data();
+      const qreal* w2 = sl._w.data();
+      size_t k = 0;
+      for (size_t i = 0; i < n1; ++i) {
+            const qreal x1 = _x[i];
+            const qreal e1 = x1 + _w[i];
+            while (k < n2 && (x2[k] + w2[k]) < x1)
                   ++k;
-                  }
-            if (k == sl.end())
+            if (k == n2)
                   break;
-            for (;;) {
-                  if ((x1 + i->w > x2) && (x1 < x2 + k->w))
-                        dist = qMax(dist, i->y - k->y);
-                  if (x2 + k->w < x1 + i->w) {
-                        x2 += k->w;
-                        ++k;
-                        if (k == sl.end())
-                              break;
-                        }
-                  else
-                        break;
+            // segments k...l of sl can overlap segment i
+            size_t l = k;
+            while (l < n2 - 1 && (x2[l] + w2[l]) < e1)
+                  ++l;
+            // branch free minimum over a contiguous range, the compiler
+            // can vectorize this loop
+            qreal ymin = qInf();
+            for (size_t j = k; j <= l; ++j) {
+                  const bool overlap = (e1 > x2[j]) && (x1 < x2[j] + w2[j]);
+                  ymin = qMin(ymin, overlap ? y2[j] : qInf());
                   }
-            if (k == sl.end())
+            if (ymin != qInf())
+                  dist = qMax(dist, _y[i] - ymin);
+            if ((x2[l] + w2[l]) < e1)     // sl ends inside segment i
                   break;
-            x1 += i->w;
+            k = l;
             }
       return dist;
       }
@@ -218,29 +274,27 @@ void Skyline::paint(QPainter& p) const
 
 void SkylineLine::paint(QPainter& p) const
       {
-      qreal x1 = 0.0;
-      qreal x2;
       qreal y = 0.0;
 
       bool pvalid = false;
-      for (const SkylineSegment& s : *this) {
-            x2 = x1 + s.w;
-            if (valid(s)) {
+      for (size_t i = 0; i < size(); ++i) {
+            qreal x1 = _x[i];
+            qreal x2 = x1 + _w[i];
+            if (valid(_y[i])) {
                   if (pvalid)
-                        p.drawLine(QLineF(x1, y, x1, s.y));
-                  y  = s.y;
+                        p.drawLine(QLineF(x1, y, x1, _y[i]));
+                  y  = _y[i];
                   p.drawLine(QLineF(x1, y, x2, y));
                   pvalid = true;
                   }
             else
                   pvalid = false;
-            x1 = x2;
             }
       }
 
-bool SkylineLine::valid(const SkylineSegment& s) const
+bool SkylineLine::valid(qreal y) const
       {
-      return north ? (s.y != MAXIMUM_Y) : (s.y != MINIMUM_Y);
+      return north ? (y != MAXIMUM_Y) : (y != MINIMUM_Y);
       }
 
 //---------------------------------------------------------
@@ -258,11 +312,8 @@ void Skyline::dump(const char* p, bool n) const
 
 void SkylineLine::dump() const
       {
-      qreal x = 0.0;
-      for (const SkylineSegment& s : *this) {
-            printf("   x %f y %f w %f\n", x, s.y, s.w);
-            x += s.w;
-            }
+      for (size_t i = 0; i < size(); ++i)
+            printf("   x %f y %f w %f\n", _x[i], _y[i], _w[i]);
       }
 
 //---------------------------------------------------------
@@ -274,17 +325,16 @@ qreal SkylineLine::max() const
       qreal val;
       if (north) {
             val = MAXIMUM_Y;
-            for (const SkylineSegment& s : *this)
-                  val = qMin(val, s.y);
+            for (qreal y : _y)
+                  val = qMin(val, y);
             }
       else {
             val = MINIMUM_Y;
-            for (const SkylineSegment& s : *this)
-                  val = qMax(val, s.y);
+            for (qreal y : _y)
+                  val = qMax(val, y);
             }
       return val;
       }
 
 
 } // namespace Ms
-
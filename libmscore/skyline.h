@@ -22,35 +22,43 @@ namespace Ms {
 class Segment;
 class Shape;
 
-//---------------------------------------------------------
-//   SkylineSegment
-//---------------------------------------------------------
-
-struct SkylineSegment {
-      qreal y;
-      qreal w;
-
-      SkylineSegment(qreal _y, qreal _w) : y(_y), w(_w) {}
-      };
-
 //---------------------------------------------------------
 //   SkylineLine
+//    piecewise constant line starting at x = 0.0;
+//    segments are kept as parallel arrays with the start
+//    position of every segment precomputed; add() updates
+//    the start positions from the first changed segment on
 //---------------------------------------------------------
 
-struct SkylineLine : public std::vector<SkylineSegment> {
+class SkylineLine {
       const bool north;
+      std::vector<qreal> _x;        // start of segment
+      std::vector<qreal> _y;
+      std::vector<qreal> _w;
+
+      void insert(size_t idx, qreal y, qreal w);
+      void append(qreal y, qreal w) { insert(_y.size(), y, w); }
+      size_t addSegment(qreal x, qreal y, qreal w);
+      void updateX(size_t from);
 
    public:
       SkylineLine(bool n) : north(n) {}
       void add(qreal x, qreal y, qreal w);
       void add(const Shape& s);
       void add(const QRectF& r);
+      void clear();
       void paint(QPainter&) const;
       void dump() const;
       qreal minDistance(const SkylineLine&) const;
       qreal max() const;
-      bool valid(const SkylineSegment& s) const;
+      bool valid(qreal y) const;
       bool isNorth() const { return north; }
+
+      size_t size() const      { return _y.size();  }
+      bool empty() const       { return _y.empty(); }
+      qreal x(size_t i) const  { return _x[i]; }
+      qreal y(size_t i) const  { return _y[i]; }
+      qreal w(size_t i) const  { return _w[i]; }
       };
 
 //---------------------------------------------------------
@@ -0,0 +1,196 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2
+//  as published by the Free Software Foundation and appearing in
+//  the file LICENCE.GPL
+//=============================================================================
+
+#ifndef __SPARSEARRAY_H__
+#define __SPARSEARRAY_H__
+
+#include <utility>
+#include <vector>
+#include <QtGlobal>
+#include <QtAlgorithms>
+
+namespace Ms {
+
+//---------------------------------------------------------
+//   SparseArray
+//    Array of size() logical slots which stores only the
+//    occupied ones. A bitmask marks the occupied slots, the
+//    values are packed in slot order, so values() can be
+//    walked like a dense vector without the empty slots.
+//---------------------------------------------------------
+
+template <class T>
+class SparseArray {
+      std::vector<quint64> _mask;   // bit i set if slot i holds a value
+      std::vector<T> _values;       // values of the occupied slots in slot order
+      int _size { 0 };
+
+      bool bit(int idx) const { return _mask[idx >> 6] & (quint64(1) << (idx & 63)); }
+
+      //---------------------------------------------------
+      //   rank
+      //    number of occupied slots below idx, this is the
+      //    position of slot idx in _values
+      //---------------------------------------------------
+
+      int rank(int idx) const {
+            int w = idx >> 6;
+            int n = 0;
+            for (int i = 0; i < w; ++i)
+                  n += qPopulationCount(_mask[i]);
+            quint64 below = (quint64(1) << (idx & 63)) - 1;
+            return n + qPopulationCount(_mask[w] & below);
+            }
+
+   public:
+      //---------------------------------------------------
+      //   assign
+      //    resize to n empty slots
+      //---------------------------------------------------
+
+      void assign(int n) {
+            _size = n;
+            _mask.assign((n + 63) >> 6, 0);
+            _values.clear();
+            }
+
+      int size() const                       { return _size;           }
+      int count() const                      { return int(_values.size()); }
+      bool empty() const                     { return _values.empty(); }
+      const std::vector<T>& values() const   { return _values;         }
+      std::vector<T>& values()               { return _values;         }
+
+      bool contains(int idx) const           { return idx >= 0 && idx < _size && bit(idx); }
+
+      //---------------------------------------------------
+      //   value
+      //    return the value in slot idx or def if the slot
+      //    is empty
+      //---------------------------------------------------
+
+      T value(int idx, const T& def = T()) const {
+            return contains(idx) ? _values[rank(idx)] : def;
+            }
+
+      //---------------------------------------------------
+      //   find
+      //    return a pointer to the value in slot idx or null
+      //---------------------------------------------------
+
+      const T* find(int idx) const {
+            return contains(idx) ? &_values[rank(idx)] : 0;
+            }
+
+      //---------------------------------------------------
+      //   get
+      //    return the value in slot idx, a default value is
+      //    inserted if the slot is empty
+      //---------------------------------------------------
+
+      T& get(int idx) {
+            Q_ASSERT(idx >= 0 && idx < _size);
+            int r = rank(idx);
+            if (!bit(idx)) {
+                  _mask[idx >> 6] |= quint64(1) << (idx & 63);
+                  _values.insert(_values.begin() + r, T());
+                  }
+            return _values[r];
+            }
+
+      void set(int idx, const T& val)        { get(idx) = val; }
+
+      //---------------------------------------------------
+      //   remove
+      //    empty slot idx
+      //---------------------------------------------------
+
+      void remove(int idx) {
+            if (!contains(idx))
+                  return;
+            _values.erase(_values.begin() + rank(idx));
+            _mask[idx >> 6] &= ~(quint64(1) << (idx & 63));
+            }
+
+      //---------------------------------------------------
+      //   forEach
+      //    call f(idx, value) for all occupied slots in
+      //    slot order
+      //---------------------------------------------------
+
+      template <class F>
+      void forEach(F f) const {
+            int k = 0;
+            for (int w = 0; w < int(_mask.size()); ++w) {
+                  for (quint64 bits = _mask[w]; bits; bits &= bits - 1)
+                        f((w << 6) + qCountTrailingZeroBits(bits), _values[k++]);
+                  }
+            }
+
+      //---------------------------------------------------
+      //   insert
+      //    insert n empty slots before slot idx
+      //---------------------------------------------------
+
+      void insert(int idx, int n) {
+            SparseArray a;
+            a.assign(_size + n);
+            a._values.reserve(_values.size());
+            forEach([&a, idx, n](int i, const T& v) { a.append(i < idx ? i : i + n, v); });
+            swap(a);
+            }
+
+      //---------------------------------------------------
+      //   erase
+      //    remove the n slots starting at idx
+      //---------------------------------------------------
+
+      void erase(int idx, int n) {
+            SparseArray a;
+            a.assign(_size - n);
+            a._values.reserve(_values.size());
+            forEach([&a, idx, n](int i, const T& v) {
+                  if (i < idx)
+                        a.append(i, v);
+                  else if (i >= idx + n)
+                        a.append(i - n, v);
+                  });
+            swap(a);
+            }
+
+      //---------------------------------------------------
+      //   append
+      //    set slot idx which must be behind all occupied
+      //    slots
+      //---------------------------------------------------
+
+      void append(int idx, const T& val) {
+            _mask[idx >> 6] |= quint64(1) << (idx & 63);
+            _values.push_back(val);
+            }
+
+      void swap(SparseArray& a) {
+            std::swap(_mask, a._mask);
+            std::swap(_values, a._values);
+            std::swap(_size, a._size);
+            }
+
+      //---------------------------------------------------
+      //   bytes
+      //    memory used by the array including its heap
+      //    blocks
+      //---------------------------------------------------
+
+      size_t bytes() const {
+            return sizeof(*this) + _mask.capacity() * sizeof(quint64) + _values.capacity() * sizeof(T);
+            }
+      };
+
+}     // namespace Ms
+#endif
@@ -918,6 +918,62 @@ void Staff::setSlashStyle(int tick, bool val)
       staffType(tick)->setSlashStyle(val);
       }
 
+//---------------------------------------------------------
+//   playbackKey
+//    the staff state the rendered midi events depend on
+//    besides the content of the measures; if it changes,
+//    the cached measure play events of this staff are
+//    stale. The whole state is kept, as a hash of it
+//    could stay the same.
+//---------------------------------------------------------
+
+QVector<int> Staff::playbackKey() const
+      {
+      QVector<int> key;
+      auto add = [&key](int v) { key.append(v); };
+
+      add(idx());
+      add(primaryStaff());
+      for (int voice = 0; voice < VOICES; ++voice) {
+            add(_playbackVoice[voice]);
+            add(_channelList[voice].size());    // the lists are told apart by their sizes
+            for (auto i = _channelList[voice].cbegin(); i != _channelList[voice].cend(); ++i) {
+                  add(i.key());
+                  add(i.value());
+                  }
+            }
+      add(_swingList.size());
+      for (auto i = _swingList.cbegin(); i != _swingList.cend(); ++i) {
+            add(i.key());
+            add(i.value().swingUnit);
+            add(i.value().swingRatio);
+            }
+      add(_capoList.size());
+      for (auto i = _capoList.cbegin(); i != _capoList.cend(); ++i) {
+            add(i.key());
+            add(i.value());
+            }
+      add(_velocities.size());
+      for (auto i = _velocities.cbegin(); i != _velocities.cend(); ++i) {
+            add(i.key());
+            add(int(i.value().type));
+            add(i.value().val);
+            }
+      add(_pitchOffsets.size());
+      for (auto i = _pitchOffsets.cbegin(); i != _pitchOffsets.cend(); ++i) {
+            add(i.key());
+            add(i.value());
+            }
+      add(int(part()->instruments()->size()));
+      for (const auto& i : *part()->instruments()) {
+            add(i.first);
+            add(i.second->channel().size());
+            for (const Channel* c : i.second->channel())
+                  add(c->channel());
+            }
+      return key;
+      }
+
 //---------------------------------------------------------
 //   primaryStaff
 ///   if there are linked staves, the primary staff is
@@ -95,6 +95,7 @@ class Staff final : public ScoreElement {
 
       VeloList _velocities;         ///< cached value
       PitchList _pitchOffsets;      ///< cached value
+      QVector<int> _playEventsKey;  ///< playbackKey() of the cached measure play events
 
       void scaleChanged(double oldValue, double newValue);
       void fillBrackets(int);
@@ -223,6 +224,9 @@ class Staff final : public ScoreElement {
 
       VeloList& velocities()           { return _velocities;     }
       PitchList& pitchOffsets()        { return _pitchOffsets;   }
+      QVector<int> playbackKey() const;
+      const QVector<int>& playEventsKey() const   { return _playEventsKey; }
+      void setPlayEventsKey(const QVector<int>& k) { _playEventsKey = k;    }
 
       int pitchOffset(int tick)        { return _pitchOffsets.pitchOffset(tick);   }
       void updateOttava();
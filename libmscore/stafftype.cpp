@@ -771,7 +771,7 @@ void StaffType::drawInputStringMarks(QPainter *p, int string, int voice, QRectF
       // draw the text, if any
       if (!text.isEmpty()) {
             QFont f = fretFont();
-            f.setPointSizeF(f.pointSizeF() * MScore::pixelRatio);
+            f.setPointSizeF(f.pointSizeF() * MScore::pixelRatio());
             p->setFont(f);
             p->drawText(QPointF(rect.left(), rect.top() + lineDist), text);
             }
@@ -991,7 +991,7 @@ void TabDurationSymbol::draw(QPainter* painter) const
       if (_beamGrid == TabBeamGrid::NONE) {
             // if no beam grid, draw symbol
             QFont f(_tab->durationFont());
-            f.setPointSizeF(f.pointSizeF() * MScore::pixelRatio);
+            f.setPointSizeF(f.pointSizeF() * MScore::pixelRatio());
             painter->setFont(f);
             painter->drawText(QPointF(0.0, 0.0), _text);
             }
@@ -5641,12 +5641,6 @@ void ScoreFont::draw(SymId id, QPainter* painter, const QSizeF& mag, const QPoin
                   qDebug("ScoreFont::draw: invalid sym %d", int(id));
             return;
             }
-      int rv = FT_Load_Glyph(face, sym(id).index(), FT_LOAD_DEFAULT);
-      if (rv) {
-            qDebug("load glyph id %d, failed: 0x%x", int(id), rv);
-            return;
-            }
-
       if (MScore::pdfPrinting) {
             if (font == 0) {
                   QString s(_fontPath+_filename);
@@ -5661,7 +5655,7 @@ void ScoreFont::draw(SymId id, QPainter* painter, const QSizeF& mag, const QPoin
                   font->setStyleStrategy(QFont::NoFontMerging);
                   font->setHintingPreference(QFont::PreferVerticalHinting);
                   }
-            qreal size = 20.0 * MScore::pixelRatio;
+            qreal size = 20.0 * MScore::pixelRatio();
             font->setPointSize(size);
             QSizeF imag = QSizeF(1.0 / mag.width(), 1.0 / mag.height());
             painter->scale(mag.width(), mag.height());
@@ -5678,55 +5672,143 @@ void ScoreFont::draw(SymId id, QPainter* painter, const QSizeF& mag, const QPoin
       worldScale      *= pixelRatio;
 //      if (worldScale < 1.0)
 //            worldScale = 1.0;
-      int scale16X      = lrint(worldScale * 6553.6 * mag.width() * DPI_F);
-      int scale16Y      = lrint(worldScale * 6553.6 * mag.height() * DPI_F);
 
+      // pixmaps must not be used outside the gui thread,
+      // other threads cache and paint tinted images
+      QCoreApplication* app = QCoreApplication::instance();
+      bool guiThread        = app && QThread::currentThread() == app->thread();
+
+      QMutexLocker lock(&cache->mutex);
       GlyphKey gk(face, id, mag.width(), mag.height(), worldScale, color);
-      GlyphPixmap* pm = cache->object(gk);
-
-      if (!pm) {
-            FT_Matrix matrix {
-                  scale16X, 0,
-                  0,       scale16Y
-                  };
-
-            FT_Glyph glyph;
-            FT_Get_Glyph(face->glyph, &glyph);
-            FT_Glyph_Transform(glyph, &matrix, 0);
-            rv = FT_Glyph_To_Bitmap(&glyph, FT_RENDER_MODE_NORMAL, 0, 1);
-            if (rv) {
-                  qDebug("glyph to bitmap failed: 0x%x", rv);
+      if (guiThread) {
+            GlyphPixmap* gp = cache->pixmaps.object(gk);
+            if (gp) {
+                  ++cache->hits;
+                  QPixmap pm     = gp->pm;
+                  QPointF offset = gp->offset;
+                  lock.unlock();
+                  painter->drawPixmap(pos + offset, pm);
                   return;
                   }
-
-            FT_BitmapGlyph gb = (FT_BitmapGlyph)glyph;
-            FT_Bitmap* bm     = &gb->bitmap;
-
-            if (bm->width == 0 || bm->rows == 0) {
-                  qDebug("zero glyph, id %d", int(id));
+            }
+      else {
+            GlyphImage* gi = cache->images.object(gk);
+            if (gi) {
+                  ++cache->hits;
+                  QImage img     = gi->image;
+                  QPointF offset = gi->offset;
+                  lock.unlock();
+                  painter->drawImage(pos + offset, img);
                   return;
                   }
-            QImage img(QSize(bm->width, bm->rows), QImage::Format_ARGB32);
-            img.fill(Qt::transparent);
-
-            for (int y = 0; y < int(bm->rows); ++y) {
-                  unsigned* dst      = (unsigned*)img.scanLine(y);
-                  unsigned char* src = (unsigned char*)(bm->buffer) + bm->pitch * y;
-                  for (int x = 0; x < int(bm->width); ++x) {
-                        unsigned val = *src++;
-                        color.setAlpha(val);
-                        *dst++ = color.rgba();
-                        }
-                  }
-            pm = new GlyphPixmap;
-            pm->pm = QPixmap::fromImage(img, Qt::NoFormatConversion);
-            pm->pm.setDevicePixelRatio(worldScale);
-            pm->offset = QPointF(qreal(gb->left), -qreal(gb->top)) / worldScale;
-            if (!cache->insert(gk, pm))
-                  qDebug("cannot cache glyph");
+            }
+      GlyphKey mk(face, id, mag.width(), mag.height(), worldScale, QColor());
+      GlyphMask* gm = cache->masks.object(mk);
+      bool newMask  = !gm;
+      if (newMask) {
+            gm = rasterize(id, mag, worldScale);
+            if (!gm)
+                  return;
+            ++cache->rasterized;
+            }
+      else
+            ++cache->tinted;
+      // the copy shares the data of the mask, it stays valid without
+      // the lock and when insert() drops the mask for exceeding the budget
+      QImage mask    = gm->mask;
+      QPointF offset = gm->offset;
+      if (newMask)
+            cache->masks.insert(mk, gm, mask.width() * mask.height());
+      lock.unlock();
+      drawTinted(painter, pos, gk, mask, offset, guiThread);
+      }
+
+//---------------------------------------------------------
+//   drawTinted
+//    tint the glyph mask in the color of key, cache the
+//    result and paint it; called without the cache lock
+//---------------------------------------------------------
+
+void ScoreFont::drawTinted(QPainter* painter, const QPointF& pos, const GlyphKey& key, const QImage& mask, const QPointF& offset, bool guiThread) const
+      {
+      // premultiplied, so pixmaps and images are painted alike
+      QImage img(mask.size(), QImage::Format_ARGB32_Premultiplied);
+      QRgb rgb = key.color.rgb() & RGB_MASK;
+      for (int y = 0; y < mask.height(); ++y) {
+            QRgb* dst        = (QRgb*)img.scanLine(y);
+            const uchar* src = mask.constScanLine(y);
+            for (int x = 0; x < mask.width(); ++x)
+                  dst[x] = qPremultiply(rgb | (QRgb(src[x]) << 24));
+            }
+      img.setDevicePixelRatio(key.worldScale);
+      int bytes = img.width() * img.height() * 4;
+
+      if (!guiThread) {
+            GlyphImage* gi = new GlyphImage;
+            gi->image      = img;
+            gi->offset     = offset;
+            {
+            QMutexLocker lock(&cache->mutex);
+            cache->images.insert(key, gi, bytes);
+            }
+            painter->drawImage(pos + offset, img);
+            return;
+            }
+      QPixmap pm      = QPixmap::fromImage(img, Qt::NoFormatConversion);
+      GlyphPixmap* gp = new GlyphPixmap;
+      gp->pm          = pm;
+      gp->offset      = offset;
+      {
+      QMutexLocker lock(&cache->mutex);
+      cache->pixmaps.insert(key, gp, bytes);
+      }
+      painter->drawPixmap(pos + offset, pm);
+      }
+
+//---------------------------------------------------------
+//   rasterize
+//    render a glyph with FreeType into an alpha mask
+//---------------------------------------------------------
+
+GlyphMask* ScoreFont::rasterize(SymId id, const QSizeF& mag, qreal worldScale) const
+      {
+      int rv = FT_Load_Glyph(face, sym(id).index(), FT_LOAD_DEFAULT);
+      if (rv) {
+            qDebug("load glyph id %d, failed: 0x%x", int(id), rv);
+            return 0;
+            }
+      int scale16X      = lrint(worldScale * 6553.6 * mag.width() * DPI_F);
+      int scale16Y      = lrint(worldScale * 6553.6 * mag.height() * DPI_F);
+      FT_Matrix matrix {
+            scale16X, 0,
+            0,       scale16Y
+            };
+
+      FT_Glyph glyph;
+      FT_Get_Glyph(face->glyph, &glyph);
+      FT_Glyph_Transform(glyph, &matrix, 0);
+      rv = FT_Glyph_To_Bitmap(&glyph, FT_RENDER_MODE_NORMAL, 0, 1);
+      if (rv) {
+            qDebug("glyph to bitmap failed: 0x%x", rv);
             FT_Done_Glyph(glyph);
+            return 0;
             }
-      painter->drawPixmap(pos + pm->offset, pm->pm);
+
+      FT_BitmapGlyph gb = (FT_BitmapGlyph)glyph;
+      FT_Bitmap* bm     = &gb->bitmap;
+
+      if (bm->width == 0 || bm->rows == 0) {
+            qDebug("zero glyph, id %d", int(id));
+            FT_Done_Glyph(glyph);
+            return 0;
+            }
+      GlyphMask* gm = new GlyphMask;
+      gm->mask = QImage(QSize(bm->width, bm->rows), QImage::Format_Alpha8);
+      for (int y = 0; y < int(bm->rows); ++y)
+            memcpy(gm->mask.scanLine(y), bm->buffer + bm->pitch * y, bm->width);
+      gm->offset = QPointF(qreal(gb->left), -qreal(gb->top)) / worldScale;
+      FT_Done_Glyph(glyph);
+      return gm;
       }
 
 void ScoreFont::draw(SymId id, QPainter* painter, qreal mag, const QPointF& pos, int n) const
@@ -5863,28 +5945,13 @@ void ScoreFont::computeMetrics(Sym* sym, int code)
       }
 
 //---------------------------------------------------------
-//   load
+//   computeMetrics
+//    compute the metrics of all symbols with FreeType and
+//    from the font metadata
 //---------------------------------------------------------
 
-void ScoreFont::load()
+void ScoreFont::computeMetrics(const QByteArray& metadata)
       {
-      QString facePath = _fontPath + _filename;
-      QFile f(facePath);
-      if (!f.open(QIODevice::ReadOnly)) {
-            qDebug("ScoreFont::load(): open failed <%s>", qPrintable(facePath));
-            return;
-            }
-      fontImage = f.readAll();
-      int rval = FT_New_Memory_Face(ftlib, (FT_Byte*)fontImage.data(), fontImage.size(), 0, &face);
-      if (rval) {
-            qDebug("freetype: cannot create face <%s>: %d", qPrintable(facePath), rval);
-            return;
-            }
-      cache = new QCache<GlyphKey, GlyphPixmap>(100);
-
-      qreal pixelSize = 200.0;
-      FT_Set_Pixel_Sizes(face, 0, int(pixelSize+.5));
-
       for (size_t id = 0; id < _mainSymCodeTable.size(); ++id) {
             uint code = _mainSymCodeTable[id];
             if (code == 0)
@@ -5895,12 +5962,9 @@ void ScoreFont::load()
             }
 
       QJsonParseError error;
-      QFile fi(_fontPath + "metadata.json");
-      if (!fi.open(QIODevice::ReadOnly))
-            qDebug("ScoreFont: open glyph metadata file <%s> failed", qPrintable(fi.fileName()));
-      QJsonObject metadataJson = QJsonDocument::fromJson(fi.readAll(), &error).object();
+      QJsonObject metadataJson = QJsonDocument::fromJson(metadata, &error).object();
       if (error.error != QJsonParseError::NoError)
-            qDebug("Json parse error in <%s>(offset: %d): %s", qPrintable(fi.fileName()),
+            qDebug("Json parse error in <%s>(offset: %d): %s", qPrintable(_fontPath + "metadata.json"),
                error.offset, qPrintable(error.errorString()));
 
       QJsonObject oo = metadataJson.value("glyphsWithAnchors").toObject();
@@ -5911,7 +5975,7 @@ void ScoreFont::load()
             if (symId == SymId::noSym) {
                   // currently, Bravura contains a bunch of entries in glyphsWithAnchors
                   // for glyph names that will not be found - flag32ndUpStraight, etc.
-                  //qDebug("ScoreFont: symId not found <%s> in <%s>", qPrintable(i), qPrintable(fi.fileName()));
+                  //qDebug("ScoreFont: symId not found <%s> in <%s>", qPrintable(i), qPrintable(_fontPath + "metadata.json"));
                   continue;
                   }
             Sym* sym = &_symbols[int(symId)];
@@ -5981,87 +6045,6 @@ void ScoreFont::load()
                         _textEnclosureThickness = oo.value(i).toDouble();
                   }
             }
-      _engravingDefaults.push_back(std::make_pair(Sid::MusicalTextFont, QString("%1 Text").arg(_family)));
-
-      // create missing composed glyphs
-      struct Composed {
-            SymId id;
-            std::vector<SymId> rids;
-            } composed[] = {
-
-            { SymId::ornamentPrallMordent,
-                  {
-                  SymId::ornamentZigZagLineNoRightEnd,
-                  SymId::ornamentZigZagLineNoRightEnd,
-                  SymId::ornamentMiddleVerticalStroke,
-                  SymId::ornamentZigZagLineWithRightEnd
-                  } },
-            { SymId::ornamentUpPrall,
-                  {
-                  SymId::ornamentBottomLeftConcaveStroke,
-                  SymId::ornamentZigZagLineNoRightEnd,
-                  SymId::ornamentZigZagLineNoRightEnd,
-                  SymId::ornamentZigZagLineWithRightEnd
-                  }},
-            { SymId::ornamentUpMordent,
-                  {
-                  SymId::ornamentBottomLeftConcaveStroke,
-                  SymId::ornamentZigZagLineNoRightEnd,
-                  SymId::ornamentZigZagLineNoRightEnd,
-                  SymId::ornamentMiddleVerticalStroke,
-                  SymId::ornamentZigZagLineWithRightEnd
-                  }},
-            { SymId::ornamentPrallDown,
-                  {
-                  SymId::ornamentZigZagLineNoRightEnd,
-                  SymId::ornamentZigZagLineNoRightEnd,
-                  SymId::ornamentZigZagLineNoRightEnd,
-                  SymId::ornamentBottomRightConcaveStroke,
-                  }},
-#if 0
-            { SymId::ornamentDownPrall,
-                  {
-                  SymId::ornamentTopLeftConvexStroke,
-                  SymId::ornamentZigZagLineNoRightEnd,
-                  SymId::ornamentZigZagLineNoRightEnd,
-                  SymId::ornamentZigZagLineWithRightEnd
-                  }},
-#endif
-            { SymId::ornamentDownMordent,
-                  {
-                  SymId::ornamentLeftVerticalStroke,
-                  SymId::ornamentZigZagLineNoRightEnd,
-                  SymId::ornamentZigZagLineNoRightEnd,
-                  SymId::ornamentMiddleVerticalStroke,
-                  SymId::ornamentZigZagLineWithRightEnd
-                  }},
-            { SymId::ornamentPrallUp,
-                  {
-                  SymId::ornamentZigZagLineNoRightEnd,
-                  SymId::ornamentZigZagLineNoRightEnd,
-                  SymId::ornamentZigZagLineNoRightEnd,
-                  SymId::ornamentTopRightConvexStroke,
-                  }},
-            { SymId::ornamentLinePrall,
-                  {
-                  SymId::ornamentLeftVerticalStroke,
-                  SymId::ornamentZigZagLineNoRightEnd,
-                  SymId::ornamentZigZagLineNoRightEnd,
-                  SymId::ornamentZigZagLineWithRightEnd
-                  }}
-            };
-
-      for (const Composed& c : composed) {
-            if (!_symbols[int(c.id)].isValid()) {
-                  Sym* sym = &_symbols[int(c.id)];
-                  std::vector<SymId> s;
-                  for (SymId id : c.rids)
-                        s.push_back(id);
-                  sym->setSymList(s);
-                  sym->setBbox(bbox(s, 1.0));
-                  }
-            }
-
       // access needed stylistic alternates
 
       struct StylisticAlternate {
@@ -6156,6 +6139,284 @@ void ScoreFont::load()
       // add space symbol
       Sym* sym = &_symbols[int(SymId::space)];
       computeMetrics(sym, 32);
+      }
+
+//---------------------------------------------------------
+//   Font metrics cache
+//    The metrics of all symbols of a font are stored after
+//    computing them once, so that loading a font does not need
+//    to load all glyphs with FreeType and parse metadata.json.
+//    The cache is only used if MScore::fontMetricsCacheDir
+//    is set. There is one file per font, which holds the
+//    hash of the data the metrics were computed from.
+//---------------------------------------------------------
+
+static const quint32 METRICS_CACHE_MAGIC   = 0x4d434653;    // "SFCM"
+static const quint32 METRICS_CACHE_VERSION = 1;
+
+struct MetricsCacheHeader {
+      quint32 magic;
+      quint32 version;
+      char hash[20];                // sha1 of font, metadata and code table
+      quint32 symbols;
+      quint32 engravingDefaults;
+      double textEnclosureThickness;
+      };
+
+struct MetricsCacheSym {
+      qint32 code;
+      quint32 index;
+      double bbox[4];
+      double advance;
+      double anchors[12];           // stemDownNW, stemUpSE, cutOutNE, cutOutNW, cutOutSE, cutOutSW
+      };
+
+struct MetricsCacheDefault {
+      qint32 sid;
+      double value;
+      };
+
+//---------------------------------------------------------
+//   metricsCacheFile
+//---------------------------------------------------------
+
+QString ScoreFont::metricsCacheFile() const
+      {
+      if (MScore::fontMetricsCacheDir.isEmpty())
+            return QString();
+      return QString("%1/%2.metrics").arg(MScore::fontMetricsCacheDir).arg(_name);
+      }
+
+//---------------------------------------------------------
+//   metricsCacheKey
+//    identify the data the metrics are computed from
+//---------------------------------------------------------
+
+QByteArray ScoreFont::metricsCacheKey(const QByteArray& metadata) const
+      {
+      QCryptographicHash h(QCryptographicHash::Sha1);
+      h.addData(fontImage);
+      h.addData(metadata);
+      h.addData((const char*)_mainSymCodeTable.data(), int(_mainSymCodeTable.size() * sizeof(uint)));
+      return h.result();
+      }
+
+//---------------------------------------------------------
+//   readMetricsCache
+//    return false if there is no valid cache for key
+//---------------------------------------------------------
+
+bool ScoreFont::readMetricsCache(const QByteArray& key)
+      {
+      QString path = metricsCacheFile();
+      if (path.isEmpty())
+            return false;
+      QFile f(path);
+      if (!f.open(QIODevice::ReadOnly) || f.size() < qint64(sizeof(MetricsCacheHeader)))
+            return false;
+      const uchar* p = f.map(0, f.size());
+      if (!p)
+            return false;
+      MetricsCacheHeader h;
+      memcpy(&h, p, sizeof(h));
+      bool ok = h.magic == METRICS_CACHE_MAGIC && h.version == METRICS_CACHE_VERSION
+         && key.size() == int(sizeof(h.hash)) && memcmp(h.hash, key.constData(), sizeof(h.hash)) == 0
+         && h.symbols == uint(_symbols.size())
+         && f.size() == qint64(sizeof(h) + h.symbols * sizeof(MetricsCacheSym)
+                                + h.engravingDefaults * sizeof(MetricsCacheDefault));
+      if (ok) {
+            const uchar* data = p + sizeof(h);
+            for (Sym& sym : _symbols) {
+                  MetricsCacheSym ms;
+                  memcpy(&ms, data, sizeof(ms));
+                  data += sizeof(ms);
+                  sym._code    = ms.code;
+                  sym._index   = ms.index;
+                  sym._bbox    = QRectF(ms.bbox[0], ms.bbox[1], ms.bbox[2], ms.bbox[3]);
+                  sym._advance = ms.advance;
+                  sym._stemDownNW = QPointF(ms.anchors[0],  ms.anchors[1]);
+                  sym._stemUpSE   = QPointF(ms.anchors[2],  ms.anchors[3]);
+                  sym._cutOutNE   = QPointF(ms.anchors[4],  ms.anchors[5]);
+                  sym._cutOutNW   = QPointF(ms.anchors[6],  ms.anchors[7]);
+                  sym._cutOutSE   = QPointF(ms.anchors[8],  ms.anchors[9]);
+                  sym._cutOutSW   = QPointF(ms.anchors[10], ms.anchors[11]);
+                  }
+            for (quint32 i = 0; i < h.engravingDefaults; ++i) {
+                  MetricsCacheDefault d;
+                  memcpy(&d, data, sizeof(d));
+                  data += sizeof(d);
+                  _engravingDefaults.push_back(std::make_pair(Sid(d.sid), d.value));
+                  }
+            _textEnclosureThickness = h.textEnclosureThickness;
+            }
+      f.unmap(const_cast<uchar*>(p));
+      return ok;
+      }
+
+//---------------------------------------------------------
+//   writeMetricsCache
+//---------------------------------------------------------
+
+void ScoreFont::writeMetricsCache(const QByteArray& key) const
+      {
+      QString path = metricsCacheFile();
+      if (path.isEmpty() || key.size() != 20 || !QDir().mkpath(MScore::fontMetricsCacheDir))
+            return;
+      QByteArray ba;
+      MetricsCacheHeader h;
+      memset(&h, 0, sizeof(h));
+      h.magic                  = METRICS_CACHE_MAGIC;
+      h.version                = METRICS_CACHE_VERSION;
+      memcpy(h.hash, key.constData(), sizeof(h.hash));
+      h.symbols                = _symbols.size();
+      h.engravingDefaults      = uint(_engravingDefaults.size());
+      h.textEnclosureThickness = _textEnclosureThickness;
+      ba.append((const char*)&h, sizeof(h));
+      for (const Sym& sym : _symbols) {
+            MetricsCacheSym ms;
+            memset(&ms, 0, sizeof(ms));
+            ms.code    = sym._code;
+            ms.index   = sym._code == -1 ? 0 : sym._index;
+            ms.bbox[0] = sym._bbox.x();
+            ms.bbox[1] = sym._bbox.y();
+            ms.bbox[2] = sym._bbox.width();
+            ms.bbox[3] = sym._bbox.height();
+            ms.advance = sym._code == -1 ? 0.0 : sym._advance;
+            const QPointF anchors[6] = { sym._stemDownNW, sym._stemUpSE, sym._cutOutNE,
+                                         sym._cutOutNW, sym._cutOutSE, sym._cutOutSW };
+            for (int i = 0; i < 6; ++i) {
+                  ms.anchors[i * 2]     = anchors[i].x();
+                  ms.anchors[i * 2 + 1] = anchors[i].y();
+                  }
+            ba.append((const char*)&ms, sizeof(ms));
+            }
+      for (const auto& d : _engravingDefaults) {
+            MetricsCacheDefault md;
+            memset(&md, 0, sizeof(md));
+            md.sid   = int(d.first);
+            md.value = d.second.toDouble();
+            ba.append((const char*)&md, sizeof(md));
+            }
+      QSaveFile f(path);
+      if (!f.open(QIODevice::WriteOnly))
+            return;
+      f.write(ba);
+      if (!f.commit())
+            qDebug("ScoreFont: cannot write metrics cache <%s>", qPrintable(path));
+      }
+
+//---------------------------------------------------------
+//   load
+//---------------------------------------------------------
+
+void ScoreFont::load()
+      {
+      QString facePath = _fontPath + _filename;
+      QFile f(facePath);
+      if (!f.open(QIODevice::ReadOnly)) {
+            qDebug("ScoreFont::load(): open failed <%s>", qPrintable(facePath));
+            return;
+            }
+      fontImage = f.readAll();
+      int rval = FT_New_Memory_Face(ftlib, (FT_Byte*)fontImage.data(), fontImage.size(), 0, &face);
+      if (rval) {
+            qDebug("freetype: cannot create face <%s>: %d", qPrintable(facePath), rval);
+            return;
+            }
+      cache = new GlyphCache;
+
+      qreal pixelSize = 200.0;
+      FT_Set_Pixel_Sizes(face, 0, int(pixelSize+.5));
+
+      QFile fi(_fontPath + "metadata.json");
+      if (!fi.open(QIODevice::ReadOnly))
+            qDebug("ScoreFont: open glyph metadata file <%s> failed", qPrintable(fi.fileName()));
+      QByteArray metadata = fi.readAll();
+      QByteArray key = metricsCacheKey(metadata);
+      if (!readMetricsCache(key)) {
+            computeMetrics(metadata);
+            writeMetricsCache(key);
+            }
+      _engravingDefaults.push_back(std::make_pair(Sid::MusicalTextFont, QString("%1 Text").arg(_family)));
+
+      // create missing composed glyphs
+      struct Composed {
+            SymId id;
+            std::vector<SymId> rids;
+            } composed[] = {
+
+            { SymId::ornamentPrallMordent,
+                  {
+                  SymId::ornamentZigZagLineNoRightEnd,
+                  SymId::ornamentZigZagLineNoRightEnd,
+                  SymId::ornamentMiddleVerticalStroke,
+                  SymId::ornamentZigZagLineWithRightEnd
+                  } },
+            { SymId::ornamentUpPrall,
+                  {
+                  SymId::ornamentBottomLeftConcaveStroke,
+                  SymId::ornamentZigZagLineNoRightEnd,
+                  SymId::ornamentZigZagLineNoRightEnd,
+                  SymId::ornamentZigZagLineWithRightEnd
+                  }},
+            { SymId::ornamentUpMordent,
+                  {
+                  SymId::ornamentBottomLeftConcaveStroke,
+                  SymId::ornamentZigZagLineNoRightEnd,
+                  SymId::ornamentZigZagLineNoRightEnd,
+                  SymId::ornamentMiddleVerticalStroke,
+                  SymId::ornamentZigZagLineWithRightEnd
+                  }},
+            { SymId::ornamentPrallDown,
+                  {
+                  SymId::ornamentZigZagLineNoRightEnd,
+                  SymId::ornamentZigZagLineNoRightEnd,
+                  SymId::ornamentZigZagLineNoRightEnd,
+                  SymId::ornamentBottomRightConcaveStroke,
+                  }},
+#if 0
+            { SymId::ornamentDownPrall,
+                  {
+                  SymId::ornamentTopLeftConvexStroke,
+                  SymId::ornamentZigZagLineNoRightEnd,
+                  SymId::ornamentZigZagLineNoRightEnd,
+                  SymId::ornamentZigZagLineWithRightEnd
+                  }},
+#endif
+            { SymId::ornamentDownMordent,
+                  {
+                  SymId::ornamentLeftVerticalStroke,
+                  SymId::ornamentZigZagLineNoRightEnd,
+                  SymId::ornamentZigZagLineNoRightEnd,
+                  SymId::ornamentMiddleVerticalStroke,
+                  SymId::ornamentZigZagLineWithRightEnd
+                  }},
+            { SymId::ornamentPrallUp,
+                  {
+                  SymId::ornamentZigZagLineNoRightEnd,
+                  SymId::ornamentZigZagLineNoRightEnd,
+                  SymId::ornamentZigZagLineNoRightEnd,
+                  SymId::ornamentTopRightConvexStroke,
+                  }},
+            { SymId::ornamentLinePrall,
+                  {
+                  SymId::ornamentLeftVerticalStroke,
+                  SymId::ornamentZigZagLineNoRightEnd,
+                  SymId::ornamentZigZagLineNoRightEnd,
+                  SymId::ornamentZigZagLineWithRightEnd
+                  }}
+            };
+
+      for (const Composed& c : composed) {
+            if (!_symbols[int(c.id)].isValid()) {
+                  Sym* sym = &_symbols[int(c.id)];
+                  std::vector<SymId> s;
+                  for (SymId id : c.rids)
+                        s.push_back(id);
+                  sym->setSymList(s);
+                  sym->setBbox(bbox(s, 1.0));
+                  }
+            }
 
 #if 0
       //
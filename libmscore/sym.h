@@ -2755,11 +2755,53 @@ struct GlyphPixmap {
       QPointF offset;
       };
 
+struct GlyphMask {
+      QImage mask;                  // coverage, Format_Alpha8
+      QPointF offset;
+      };
+
+struct GlyphImage {
+      QImage image;                 // tinted mask, shared by the painting threads
+      QPointF offset;
+      };
+
 inline uint qHash(const GlyphKey& k)
       {
-      return (int(k.id) << 16) + (int(k.magX * 100) << 8) + k.magY * 100;
+      uint h = ::qHash(quintptr(k.face));
+      h = h * 31 + uint(k.id);
+      h = h * 31 + ::qHash(k.magX);
+      h = h * 31 + ::qHash(k.magY);
+      h = h * 31 + ::qHash(k.worldScale);
+      return h * 31 + k.color.rgba();
       }
 
+//---------------------------------------------------------
+//   GlyphCache
+//    Rasterized glyphs of a score font, budgeted in bytes.
+//    FreeType renders a glyph once per size into an alpha
+//    mask; pixmaps in the colors the glyph is drawn with
+//    are made from the mask.
+//    The cache is shared by all painting threads; pixmaps
+//    are only made and cached in the gui thread, the other
+//    threads cache tinted images.
+//---------------------------------------------------------
+
+struct GlyphCache {
+      static const int MASK_BYTES   = 8 * 1024 * 1024;
+      static const int PIXMAP_BYTES = 32 * 1024 * 1024;
+      static const int IMAGE_BYTES  = 32 * 1024 * 1024;
+
+      QCache<GlyphKey, GlyphMask> masks { MASK_BYTES };         // key color is invalid
+      QCache<GlyphKey, GlyphPixmap> pixmaps { PIXMAP_BYTES };
+      QCache<GlyphKey, GlyphImage> images { IMAGE_BYTES };
+      QMutex mutex;                 // protects the caches, counters and the FreeType face
+                                    // but is not held while tinting or painting
+
+      quint64 hits       { 0 };     // pixmap or tinted image was cached
+      quint64 tinted     { 0 };     // pixmap or image made from a cached mask
+      quint64 rasterized { 0 };     // glyph rendered by FreeType
+      };
+
 //---------------------------------------------------------
 //   ScoreFont
 //---------------------------------------------------------
@@ -2772,7 +2814,7 @@ class ScoreFont {
       QString _fontPath;
       QString _filename;
       QByteArray fontImage;
-      QCache<GlyphKey, GlyphPixmap>* cache { 0 };
+      GlyphCache* cache { 0 };
       std::list<std::pair<Sid, QVariant>> _engravingDefaults;
       double _textEnclosureThickness = 0;
       mutable QFont* font { 0 };
@@ -2781,6 +2823,13 @@ class ScoreFont {
       static std::array<uint, size_t(SymId::lastSym)+1> _mainSymCodeTable;
       void load();
       void computeMetrics(Sym* sym, int code);
+      void computeMetrics(const QByteArray& metadata);
+      GlyphMask* rasterize(SymId id, const QSizeF& mag, qreal worldScale) const;
+      void drawTinted(QPainter*, const QPointF& pos, const GlyphKey&, const QImage& mask, const QPointF& offset, bool guiThread) const;
+      QString metricsCacheFile() const;
+      QByteArray metricsCacheKey(const QByteArray& metadata) const;
+      bool readMetricsCache(const QByteArray& key);
+      void writeMetricsCache(const QByteArray& key) const;
 
    public:
       ScoreFont() {}
@@ -2837,6 +2886,7 @@ class ScoreFont {
       bool useFallbackFont(SymId id) const;
 
       const Sym& sym(SymId id) const { return _symbols[int(id)]; }
+      const GlyphCache* glyphCache() const { return cache; }
 
       friend void initScoreFonts();
       };
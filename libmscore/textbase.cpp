@@ -485,7 +485,7 @@ bool TextFragment::operator ==(const TextFragment& f) const
 void TextFragment::draw(QPainter* p, const TextBase* t) const
       {
       QFont f(font(t));
-      f.setPointSizeF(f.pointSizeF() * MScore::pixelRatio);
+      f.setPointSizeF(f.pointSizeF() * MScore::pixelRatio());
       p->setFont(f);
       p->drawText(pos, text);
       }
@@ -1479,7 +1479,7 @@ void TextBase::layoutFrame()
 
 qreal TextBase::lineSpacing() const
       {
-      return fontMetrics().lineSpacing() * MScore::pixelRatio;
+      return fontMetrics().lineSpacing() * MScore::pixelRatio();
       }
 
 //---------------------------------------------------------
@@ -2173,6 +2173,7 @@ void InsertTime::undo(EditData*)
 void ChangeNoteEvent::flip(EditData*)
       {
       note->score()->setPlaylistDirty();
+      note->score()->setPlayEventsDirty(note->chord()->tick(), note->chord()->tick());
       NoteEvent e = *oldEvent;
       *oldEvent   = newEvent;
       newEvent    = e;
@@ -31,6 +31,175 @@
 
 namespace Ms {
 
+//---------------------------------------------------------
+//   renderAudio
+//    synthesize the score into interleaved stereo frames
+//    and pass them block by block to write()
+//
+//    With normalize the synthesizer output is spilled to
+//    a temporary file until the peak is known and then
+//    written scaled, so the score is synthesized only once
+//    and memory use does not grow with the score length.
+//    Only local state is used, exports of different
+//    scores can run on several threads at the same time.
+//
+//    Return false if there is nothing to render, or if
+//    updateProgress or write canceled the export.
+//---------------------------------------------------------
+
+bool MuseScore::renderAudio(Score* score, int sampleRate, bool normalize,
+   std::function<bool(const float*, unsigned)> write, std::function<bool(float)> updateProgress)
+      {
+      EventMap events;
+      score->renderMidi(&events);
+      if (events.size() == 0)
+            return false;
+
+      MasterSynthesizer* synth = synthesizerFactory();
+      synth->init();
+      synth->setSampleRate(sampleRate);
+      if (MScore::noGui) { // use score settings if possible
+            bool r = synth->setState(score->synthesizerState());
+            if (!r)
+                  synth->init();
+            }
+      else { // use current synth settings
+            bool r = synth->setState(synthesizerState());
+            if (!r)
+                  synth->init();
+            }
+
+      //
+      // init instruments
+      //
+      synth->allSoundsOff(-1);
+      foreach(Part* part, score->parts()) {
+            const InstrumentList* il = part->instruments();
+            for(auto i = il->begin(); i!= il->end(); i++) {
+                  for (const Channel* a : i->second->channel()) {
+                        a->updateInitList();
+                        for (MidiCoreEvent e : a->init) {
+                              if (e.type() == ME_INVALID)
+                                    continue;
+                              e.setChannel(a->channel());
+                              int syntiIdx = synth->index(score->masterScore()->midiMapping(a->channel())->articulation->synti());
+                              synth->play(e, syntiIdx);
+                              }
+                        }
+                  }
+            }
+
+      static const unsigned FRAMES = 512;
+      float buffer[FRAMES * 2];
+      QTemporaryFile spill;               // unscaled output if normalizing
+      if (normalize && !spill.open()) {
+            qDebug("renderAudio: cannot open temporary file");
+            delete synth;
+            return false;
+            }
+
+      EventMap::const_iterator endPos = events.cend();
+      --endPos;
+      const int et = (score->utick2utime(endPos->first) + 1) * sampleRate;
+      const int maxEndTime = (score->utick2utime(endPos->first) + 3) * sampleRate;
+      const float progressScale = normalize ? 0.5 : 1.0;
+
+      bool cancelled = false;
+      float peak     = 0.0;
+      int playTime   = 0;
+      EventMap::const_iterator playPos = events.cbegin();
+
+      for (;;) {
+            unsigned frames = FRAMES;
+            //
+            // collect events for one segment
+            //
+            float max = 0.0;
+            memset(buffer, 0, sizeof(float) * FRAMES * 2);
+            int endTime = playTime + frames;
+            float* p = buffer;
+            for (; playPos != events.cend(); ++playPos) {
+                  int f = score->utick2utime(playPos->first) * sampleRate;
+                  if (f >= endTime)
+                        break;
+                  int n = f - playTime;
+                  if (n) {
+                        synth->process(n, p);
+                        p += 2 * n;
+                        }
+
+                  playTime  += n;
+                  frames    -= n;
+                  const NPlayEvent& e = playPos->second;
+                  if (e.isChannelEvent()) {
+                        int channelIdx = e.channel();
+                        Channel* c = score->masterScore()->midiMapping(channelIdx)->articulation;
+                        if (!c->mute()) {
+                              synth->play(e, synth->index(c->synti()));
+                              }
+                        }
+                  }
+            if (frames) {
+                  synth->process(frames, p);
+                  playTime += frames;
+                  }
+            for (unsigned i = 0; i < FRAMES * 2; ++i)
+                  max = qMax(max, qAbs(buffer[i]));
+            peak = qMax(peak, max);
+
+            if (normalize) {
+                  if (spill.write(reinterpret_cast<const char*>(buffer), sizeof(buffer)) != qint64(sizeof(buffer))) {
+                        qDebug("renderAudio: cannot write temporary file");
+                        cancelled = true;
+                        break;
+                        }
+                  }
+            else if (!write(buffer, FRAMES)) {
+                  cancelled = true;
+                  break;
+                  }
+            playTime = endTime;
+            if (updateProgress) {
+                  // normalize to [0, 1] range
+                  if (!updateProgress(qMin(float(playTime) / et, 1.0f) * progressScale)) {
+                        cancelled = true;
+                        break;
+                        }
+                  }
+            if (playTime >= et)
+                  synth->allNotesOff(-1);
+            // create sound until the sound decays
+            if (playTime >= et && max*peak < 0.000001)
+                  break;
+            // hard limit
+            if (playTime > maxEndTime)
+                  break;
+            }
+      delete synth;
+
+      if (cancelled)
+            return false;
+      if (!normalize)
+            return true;
+      double gain = peak > 0.0 ? 0.99 / peak : 1.0;
+      qint64 size = spill.size();
+      if (!spill.seek(0))
+            return false;
+      for (qint64 pos = 0; pos < size; pos += sizeof(buffer)) {
+            if (spill.read(reinterpret_cast<char*>(buffer), sizeof(buffer)) != qint64(sizeof(buffer))) {
+                  qDebug("renderAudio: cannot read temporary file");
+                  return false;
+                  }
+            for (unsigned i = 0; i < FRAMES * 2; ++i)
+                  buffer[i] *= gain;
+            if (!write(buffer, FRAMES))
+                  return false;
+            if (updateProgress && !updateProgress(0.5 + 0.5 * double(pos + sizeof(buffer)) / size))
+                  return false;
+            }
+      return true;
+      }
+
 ///
 /// \brief Function to synthesize audio and output it into a generic QIODevice
 /// \param The score to output
@@ -52,146 +221,16 @@ bool MuseScore::saveAudio(Score* score, QIODevice *device, std::function<bool(fl
         return false;
     }
 
-    EventMap events;
-    score->renderMidi(&events);
-    if(events.size() == 0)
-          return false;
-
-    MasterSynthesizer* synth = synthesizerFactory();
-    synth->init();
     int sampleRate = preferences.getInt(PREF_EXPORT_AUDIO_SAMPLERATE);
-    synth->setSampleRate(sampleRate);
-    if (MScore::noGui) { // use score settings if possible
-          bool r = synth->setState(score->synthesizerState());
-          if (!r)
-                synth->init();
-          }
-    else { // use current synth settings
-          bool r = synth->setState(mscore->synthesizerState());
-          if (!r)
-                synth->init();
-          }
-
-    int oldSampleRate  = MScore::sampleRate;
-    MScore::sampleRate = sampleRate;
-
-    float peak  = 0.0;
-    double gain = 1.0;
-    EventMap::const_iterator endPos = events.cend();
-    --endPos;
-    const int et = (score->utick2utime(endPos->first) + 1) * MScore::sampleRate;
-    const int maxEndTime = (score->utick2utime(endPos->first) + 3) * MScore::sampleRate;
-
-    bool cancelled = false;
-    int passes = preferences.getBool(PREF_EXPORT_AUDIO_NORMALIZE) ? 2 : 1;
-    for (int pass = 0; pass < passes; ++pass) {
-          EventMap::const_iterator playPos;
-          playPos = events.cbegin();
-          synth->allSoundsOff(-1);
-
-          //
-          // init instruments
-          //
-          foreach(Part* part, score->parts()) {
-                const InstrumentList* il = part->instruments();
-                for(auto i = il->begin(); i!= il->end(); i++) {
-                      for (const Channel* a : i->second->channel()) {
-                            a->updateInitList();
-                            for (MidiCoreEvent e : a->init) {
-                                  if (e.type() == ME_INVALID)
-                                        continue;
-                                  e.setChannel(a->channel());
-                                  int syntiIdx = synth->index(score->masterScore()->midiMapping(a->channel())->articulation->synti());
-								  synth->play(e, syntiIdx);
-                                  }
-                            }
-                      }
-                }
-
-          static const unsigned FRAMES = 512;
-          float buffer[FRAMES * 2];
-          int playTime = 0;
-
-          for (;;) {
-                unsigned frames = FRAMES;
-                //
-                // collect events for one segment
-                //
-                float max = 0.0;
-                memset(buffer, 0, sizeof(float) * FRAMES * 2);
-                int endTime = playTime + frames;
-                float* p = buffer;
-                for (; playPos != events.cend(); ++playPos) {
-                      int f = score->utick2utime(playPos->first) * MScore::sampleRate;
-                      if (f >= endTime)
-                            break;
-                      int n = f - playTime;
-                      if (n) {
-                            synth->process(n, p);
-                            p += 2 * n;
-                            }
-
-                      playTime  += n;
-                      frames    -= n;
-                      const NPlayEvent& e = playPos->second;
-                      if (e.isChannelEvent()) {
-                            int channelIdx = e.channel();
-                            Channel* c = score->masterScore()->midiMapping(channelIdx)->articulation;
-                            if (!c->mute()) {
-                                  synth->play(e, synth->index(c->synti()));
-                                  }
-                            }
-                      }
-                if (frames) {
-                      synth->process(frames, p);
-                      playTime += frames;
-                      }
-                if (pass == 1) {
-                      for (unsigned i = 0; i < FRAMES * 2; ++i) {
-                            max = qMax(max, qAbs(buffer[i]));
-                            buffer[i] *= gain;
-                            }
-                      }
-                else {
-                      for (unsigned i = 0; i < FRAMES * 2; ++i) {
-                            max = qMax(max, qAbs(buffer[i]));
-                            peak = qMax(peak, qAbs(buffer[i]));
-                            }
-                      }
-                if (pass == (passes - 1))
-                      device->write(reinterpret_cast<const char*>(buffer), 2 * FRAMES * sizeof(float));
-                playTime = endTime;
-                if (updateProgress) {
-                    // normalize to [0, 1] range
-                    if (!updateProgress((pass * et + playTime) / passes / et)) {
-                        cancelled = true;
-                        break;
-                    }
-                      }
-                if (playTime >= et)
-                      synth->allNotesOff(-1);
-                // create sound until the sound decays
-                if (playTime >= et && max*peak < 0.000001)
-                      break;
-                // hard limit
-                if (playTime > maxEndTime)
-                      break;
-                }
-          if (cancelled)
-                break;
-          if (pass == 0 && peak == 0.0) {
-                qDebug("song is empty");
-                break;
-                }
-          gain = 0.99 / peak;
-          }
-
-    MScore::sampleRate = oldSampleRate;
-    delete synth;
+    bool normalize = preferences.getBool(PREF_EXPORT_AUDIO_NORMALIZE);
+    auto write = [device](const float* p, unsigned frames) {
+          return device->write(reinterpret_cast<const char*>(p), 2 * frames * sizeof(float)) >= 0;
+          };
+    bool result = renderAudio(score, sampleRate, normalize, write, updateProgress);
 
     device->close();
 
-    return !cancelled;
+    return result;
 }
 
 #ifdef HAS_AUDIOFILE
@@ -267,22 +306,7 @@ bool MuseScore::saveAudio(Score* score, const QString& name)
             return false;
             }
 
-      EventMap events;
-      score->renderMidi(&events);
-      if(events.size() == 0)
-            return false;
-
-      MasterSynthesizer* synth = synthesizerFactory();
-	  synth->init();
       int sampleRate = preferences.getInt(PREF_EXPORT_AUDIO_SAMPLERATE);
-	  synth->setSampleRate(sampleRate);
-      bool r = synth->setState(score->synthesizerState());
-      if (!r)
-          synth->init();
-
-      int oldSampleRate  = MScore::sampleRate;
-      MScore::sampleRate = sampleRate;
-
 
       SoundFileDevice device(sampleRate, format, name);
 
@@ -322,9 +346,6 @@ bool MuseScore::saveAudio(Score* score, const QString& name)
       bool wasCanceled = progress.wasCanceled();
       progress.close();
 
-      MScore::sampleRate = oldSampleRate;
-      delete synth;
-
       if (wasCanceled)
             QFile::remove(name);
 
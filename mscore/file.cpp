@@ -96,7 +96,7 @@ extern void importSoundfont(QString name);
 extern MasterSynthesizer* synti;
 
 //---------------------------------------------------------
-//   paintElement(s)
+//   paintElement
 //---------------------------------------------------------
 
 static void paintElement(QPainter& p, const Element* e)
@@ -107,15 +107,6 @@ static void paintElement(QPainter& p, const Element* e)
       p.translate(-pos);
       }
 
-static void paintElements(QPainter& p, const QList<Element*>& el)
-      {
-      for (Element* e : el) {
-            if (!e->visible())
-                  continue;
-            paintElement(p, e);
-            }
-      }
-
 //---------------------------------------------------------
 //   createDefaultFileName
 //---------------------------------------------------------
@@ -1623,8 +1614,8 @@ void MuseScore::printFile()
             p.setRenderHint(QPainter::TextAntialiasing, true);
             double mag_ = printerDev.logicalDpiX() / DPI;
 
-            double pr = MScore::pixelRatio;
-            MScore::pixelRatio = 1.0 / mag_;
+            double pr = MScore::pixelRatio();
+            MScore::setPixelRatio(1.0 / mag_);
             p.scale(mag_, mag_);
 
             int fromPage = printerDev.fromPage() - 1;
@@ -1647,7 +1638,7 @@ void MuseScore::printFile()
                         }
                   }
             p.end();
-            MScore::pixelRatio = pr;
+            MScore::setPixelRatio(pr);
             }
 
       if (layoutMode != cs->layoutMode()) {
@@ -2082,8 +2073,8 @@ bool MuseScore::savePdf(Score* cs_, QPdfWriter& pdfWriter)
          size.height() * pdfWriter.logicalDpiY()));
       p.setWindow(QRect(0.0, 0.0, size.width() * DPI, size.height() * DPI));
 
-      double pr = MScore::pixelRatio;
-      MScore::pixelRatio = DPI / pdfWriter.logicalDpiX();
+      double pr = MScore::pixelRatio();
+      MScore::setPixelRatio(DPI / pdfWriter.logicalDpiX());
 
       const QList<Page*> pl = cs_->pages();
       int pages = pl.size();
@@ -2097,7 +2088,7 @@ bool MuseScore::savePdf(Score* cs_, QPdfWriter& pdfWriter)
       p.end();
       cs_->setPrinting(false);
 
-      MScore::pixelRatio = pr;
+      MScore::setPixelRatio(pr);
       MScore::pdfPrinting = false;
       return true;
       }
@@ -2137,8 +2128,8 @@ bool MuseScore::savePdf(QList<Score*> cs_, const QString& saveName)
          size.height() * pdfWriter.logicalDpiY()));
       p.setWindow(QRect(0.0, 0.0, size.width() * DPI, size.height() * DPI));
 
-      double pr = MScore::pixelRatio;
-      MScore::pixelRatio = DPI / pdfWriter.logicalDpiX();
+      double pr = MScore::pixelRatio();
+      MScore::setPixelRatio(DPI / pdfWriter.logicalDpiX());
       MScore::pdfPrinting = true;
 
       bool firstPage = true;
@@ -2169,7 +2160,7 @@ bool MuseScore::savePdf(QList<Score*> cs_, const QString& saveName)
             }
       p.end();
       MScore::pdfPrinting = false;
-      MScore::pixelRatio = pr;
+      MScore::setPixelRatio(pr);
       return true;
       }
 
@@ -2541,6 +2532,8 @@ bool MuseScore::savePng(Score* score, const QString& name)
       int padding = QString("%1").arg(pages).size();
       bool overwrite = false;
       bool noToAll = false;
+      QList<int> pageNumbers;
+      QStringList fileNames;
       for (int pageNumber = 0; pageNumber < pages; ++pageNumber) {
             QString fileName(name);
             if (fileName.endsWith(".png"))
@@ -2570,14 +2563,15 @@ bool MuseScore::savePng(Score* score, const QString& name)
                               continue;
                         }
                   }
-            QFile f(fileName);
+            pageNumbers.append(pageNumber);
+            fileNames.append(fileName);
+            }
+      return renderPngs(score, pageNumbers, [&fileNames](int i, const QByteArray& png) {
+            QFile f(fileNames[i]);
             if (!f.open(QIODevice::WriteOnly))
                   return false;
-            bool rv = savePng(score, &f, pageNumber);
-            if (!rv)
-                  return false;
-            }
-      return true;
+            return !png.isEmpty() && f.write(png) == png.size();
+            });
       }
 
 //---------------------------------------------------------
@@ -2587,70 +2581,52 @@ bool MuseScore::savePng(Score* score, const QString& name)
 
 bool MuseScore::savePng(Score* score, QIODevice* device, int pageNumber)
       {
-      const bool screenshot = false;
-      const bool transparent = preferences.getBool(PREF_EXPORT_PNG_USETRANSPARENCY);
-      const double convDpi = preferences.getDouble(PREF_EXPORT_PNG_RESOLUTION);
-      const int localTrimMargin = trimMargin;
-      const QImage::Format format = QImage::Format_ARGB32_Premultiplied;
-
-      bool rv = true;
-      score->setPrinting(!screenshot);    // don’t print page break symbols etc.
-      double pr = MScore::pixelRatio;
-
-      QImage::Format f;
-      if (format != QImage::Format_Indexed8)
-          f = format;
-      else
-          f = QImage::Format_ARGB32_Premultiplied;
-
-      const QList<Page*>& pl = score->pages();
-
-      Page* page = pl.at(pageNumber);
-      QRectF r;
-      if (localTrimMargin >= 0) {
-            QMarginsF margins(localTrimMargin, localTrimMargin, localTrimMargin, localTrimMargin);
-            r = page->tbbox() + margins;
-            }
-      else
-            r = page->abbox();
-      int w = lrint(r.width()  * convDpi / DPI);
-      int h = lrint(r.height() * convDpi / DPI);
-
-      QImage printer(w, h, f);
-      printer.setDotsPerMeterX(lrint((convDpi * 1000) / INCH));
-      printer.setDotsPerMeterY(lrint((convDpi * 1000) / INCH));
+      return renderPngs(score, QList<int>() << pageNumber, [device](int, const QByteArray& png) {
+            return !png.isEmpty() && device->write(png) == png.size();
+            });
+      }
 
-      printer.fill(transparent ? 0 : 0xffffffff);
-      double mag_ = convDpi / DPI;
-      MScore::pixelRatio = 1.0 / mag_;
+//---------------------------------------------------------
+//   renderPngs
+//    Rasterize and encode the given pages with the png export
+//    options and pass them to write(index in pageNumbers, png)
+//    in the order of pageNumbers; an empty png marks a page
+//    which could not be encoded. The pages are rendered on the
+//    worker pool a window of one page per thread at a time, so
+//    only that many pages are in memory. Stops and returns
+//    false as soon as write() fails.
+//---------------------------------------------------------
 
-      QPainter p(&printer);
-      p.setRenderHint(QPainter::Antialiasing, true);
-      p.setRenderHint(QPainter::TextAntialiasing, true);
-      p.scale(mag_, mag_);
-      if (localTrimMargin >= 0)
-            p.translate(-r.topLeft());
-      QList< Element*> pel = page->elements();
-      qStableSort(pel.begin(), pel.end(), elementLessThan);
-      paintElements(p, pel);
-       if (format == QImage::Format_Indexed8) {
-            //convert to grayscale & respect alpha
-            QVector<QRgb> colorTable;
-            colorTable.push_back(QColor(0, 0, 0, 0).rgba());
-            if (!transparent) {
-                  for (int i = 1; i < 256; i++)
-                        colorTable.push_back(QColor(i, i, i).rgb());
-                  }
-            else {
-                  for (int i = 1; i < 256; i++)
-                        colorTable.push_back(QColor(0, 0, 0, i).rgba());
+bool MuseScore::renderPngs(Score* score, const QList<int>& pageNumbers, std::function<bool(int, const QByteArray&)> write)
+      {
+      const bool transparent = preferences.getBool(PREF_EXPORT_PNG_USETRANSPARENCY);
+      const double convDpi   = preferences.getDouble(PREF_EXPORT_PNG_RESOLUTION);
+      const int margin       = trimMargin;
+
+      std::function<QByteArray(int)> render = [score, convDpi, margin, transparent](int pageNumber) {
+            QImage image = score->renderPage(pageNumber, convDpi, margin, transparent);
+            QByteArray png;
+            QBuffer buffer(&png);
+            buffer.open(QIODevice::WriteOnly);
+            if (!image.save(&buffer, "png"))
+                  png.clear();
+            return png;
+            };
+      const int window = qMax(QThread::idealThreadCount(), 1);
+      for (int i = 0; i < pageNumbers.size(); i += window) {
+            QList<int> pages = pageNumbers.mid(i, window);
+            QList<QByteArray> pngs;
+            if (pages.size() == 1)
+                  pngs.append(render(pages[0]));
+            else
+                  pngs = QtConcurrent::blockingMapped<QList<QByteArray>>(pages, render);
+            for (int k = 0; k < pngs.size(); ++k) {
+                  if (!write(i + k, pngs[k]))
+                        return false;
+                  pngs[k].clear();
                   }
-            printer = printer.convertToFormat(QImage::Format_Indexed8, colorTable);
             }
-      printer.save(device, "png");
-      score->setPrinting(false);
-      MScore::pixelRatio = pr;
-      return rv;
+      return true;
       }
 
 //---------------------------------------------------------
@@ -2814,15 +2790,14 @@ bool MuseScore::saveSvg(Score* score, const QString& saveName)
 bool MuseScore::saveSvg(Score* score, QIODevice* device, int pageNumber)
       {
       QString title(score->title());
-      score->setPrinting(true);
       MScore::pdfPrinting = true;
       MScore::svgPrinting = true;
       const QList<Page*>& pl = score->pages();
       int pages = pl.size();
-      double pr = MScore::pixelRatio;
 
       Page* page = pl.at(pageNumber);
       SvgGenerator printer;
+      RenderContext rc(DPI / printer.logicalDpiX());
       printer.setTitle(pages > 1 ? QString("%1 (%2)").arg(title).arg(pageNumber + 1) : title);
       printer.setOutputDevice(device);
 
@@ -2842,7 +2817,6 @@ bool MuseScore::saveSvg(Score* score, QIODevice* device, int pageNumber)
       p.setRenderHint(QPainter::TextAntialiasing, true);
       if (trimMargin >= 0 && score->npages() == 1)
             p.translate(-r.topLeft());
-      MScore::pixelRatio = DPI / printer.logicalDpiX();
       if (trimMargin >= 0)
              p.translate(-r.topLeft());
       // 1st pass: StaffLines
@@ -2927,8 +2901,6 @@ bool MuseScore::saveSvg(Score* score, QIODevice* device, int pageNumber)
       p.end(); // Writes MuseScore SVG file to disk, finally
 
       // Clean up and return
-      MScore::pixelRatio = pr;
-      score->setPrinting(false);
       MScore::pdfPrinting = false;
       MScore::svgPrinting = false;
       return true;
@@ -3140,8 +3112,141 @@ bool MuseScore::exportMp3AsJSON(const QString& inFilePath, const QString& outFil
       return true;
       }
       
+//---------------------------------------------------------
+//   MediaJsonWriter
+//    Writes a JSON document while its parts are produced.
+//    Binary data is base64 encoded into the output on a
+//    worker thread, which overlaps with producing the next
+//    part; at most one encoding is pending at a time.
+//---------------------------------------------------------
+
+class MediaJsonWriter {
+      QIODevice* _out;
+      QFuture<bool> _pending;
+      bool _ok { true };
+      std::vector<bool> _first;     // per open object/array: nothing written yet
+
+      bool write(const QByteArray& ba) { return _out->write(ba) == ba.size(); }
+      void wait();
+      void separator(const char* key);
+
+   public:
+      MediaJsonWriter(QIODevice* out) : _out(out) {}
+      ~MediaJsonWriter() { wait(); }
+
+      void beginObject(const char* key = 0);
+      void endObject();
+      void beginArray(const char* key = 0);
+      void endArray();
+      void writeBase64(const char* key, const QByteArray& data);
+      void writeJson(const char* key, const QJsonObject& obj);
+      bool finish();
+      };
+
+//---------------------------------------------------------
+//   wait
+//---------------------------------------------------------
+
+void MediaJsonWriter::wait()
+      {
+      if (_pending.isStarted()) {
+            _ok = _pending.result() && _ok;
+            _pending = QFuture<bool>();
+            }
+      }
+
+//---------------------------------------------------------
+//   separator
+//    write comma and key of the next value
+//---------------------------------------------------------
+
+void MediaJsonWriter::separator(const char* key)
+      {
+      wait();
+      if (!_first.empty()) {
+            if (!_first.back())
+                  _ok = write(",") && _ok;
+            _first.back() = false;
+            }
+      if (key)
+            _ok = write(QByteArray("\"") + key + "\":") && _ok;
+      }
+
+void MediaJsonWriter::beginObject(const char* key)
+      {
+      separator(key);
+      _ok = write("{") && _ok;
+      _first.push_back(true);
+      }
+
+void MediaJsonWriter::endObject()
+      {
+      wait();
+      _first.pop_back();
+      _ok = write("}") && _ok;
+      }
+
+void MediaJsonWriter::beginArray(const char* key)
+      {
+      separator(key);
+      _ok = write("[") && _ok;
+      _first.push_back(true);
+      }
+
+void MediaJsonWriter::endArray()
+      {
+      wait();
+      _first.pop_back();
+      _ok = write("]") && _ok;
+      }
+
+//---------------------------------------------------------
+//   writeBase64
+//    base64 characters need no escaping in JSON strings;
+//    encoding in multiples of three bytes gives the same
+//    result as encoding all data at once
+//---------------------------------------------------------
+
+void MediaJsonWriter::writeBase64(const char* key, const QByteArray& data)
+      {
+      separator(key);
+      _ok = write("\"") && _ok;
+      QIODevice* out = _out;
+      _pending = QtConcurrent::run([out, data]() {
+            static const int CHUNK = 3 * 16384;
+            bool ok = true;
+            for (int i = 0; i < data.size() && ok; i += CHUNK) {
+                  QByteArray b64 = QByteArray::fromRawData(data.constData() + i, qMin(CHUNK, data.size() - i)).toBase64();
+                  ok = out->write(b64) == b64.size();
+                  }
+            return ok && out->write("\"") == 1;
+            });
+      }
+
+void MediaJsonWriter::writeJson(const char* key, const QJsonObject& obj)
+      {
+      separator(key);
+      _ok = write(QJsonDocument(obj).toJson(QJsonDocument::Compact)) && _ok;
+      }
+
+//---------------------------------------------------------
+//   finish
+//    return false if anything could not be written
+//---------------------------------------------------------
+
+bool MediaJsonWriter::finish()
+      {
+      wait();
+      return _ok;
+      }
+
 //---------------------------------------------------------
 //   exportAllMediaFiles
+//    The JSON document is written while the media are
+//    produced, so that only the artifact being written and
+//    the one being produced are held in memory. The keys
+//    are written in the sorted order QJsonObject used, so
+//    the document is unchanged.
 //---------------------------------------------------------
       
 bool MuseScore::exportAllMediaFiles(const QString& inFilePath, const QString& outFilePath)
@@ -3163,77 +3268,91 @@ bool MuseScore::exportAllMediaFiles(const QString& inFilePath, const QString& ou
       //jsonForMedia["metadata"] = mdJson;
       ///////////////////////////////////////////////////
       
-      QJsonObject jsonForMedia;
+      const QString& jsonPath{outFilePath};
+      QFile file(jsonPath);
+      if (!file.open(QIODevice::WriteOnly))
+            return false;
+
       bool res = true;
+      MediaJsonWriter json(&file);
+      json.beginObject();
+
+      //export metadata
+      json.writeJson("metadata", mscore->saveMetadataJSON(score.get()));
 
+      //export score midi
       {
-      //export score pngs and svgs
-      QJsonArray pngsJsonArray;
-      QJsonArray svgsJsonArray;
-      for (int i = 0; i < score->pages().size(); ++i) {
-            QByteArray pngData;
-            QBuffer pngDevice(&pngData);
-            pngDevice.open(QIODevice::ReadWrite);
-            res &= mscore->savePng(score.get(), &pngDevice, i);
-            QJsonValue pngJson(QString::fromLatin1(pngData.toBase64()));
-            pngsJsonArray.append(pngJson);
-            QByteArray svgData;
-            QBuffer svgDevice(&svgData);
-            svgDevice.open(QIODevice::ReadWrite);
-            res &= mscore->saveSvg(score.get(), &svgDevice, i);
-            QJsonValue svgJson(QString::fromLatin1(svgData.toBase64()));
-            svgsJsonArray.append(svgJson);
-            }
-      jsonForMedia["pngs"] = pngsJsonArray;
-      jsonForMedia["svgs"] = svgsJsonArray;
+      QByteArray midiData;
+      QBuffer midiDevice(&midiData);
+      midiDevice.open(QIODevice::ReadWrite);
+      res &= mscore->saveMidi(score.get(), &midiDevice);
+      json.writeBase64("midi", midiData);
       }
-      
-      //export score .spos
-      QByteArray partDataPos;
-      QBuffer partPosDevice(&partDataPos);
-      partPosDevice.open(QIODevice::ReadWrite);
-      savePositions(score.get(), &partPosDevice, true);
-      jsonForMedia["sposXML"] = QString::fromLatin1(partDataPos.toBase64());
-      partPosDevice.close();
-      partDataPos.clear();
 
       //export score .mpos
+      {
+      QByteArray partDataPos;
+      QBuffer partPosDevice(&partDataPos);
       partPosDevice.open(QIODevice::ReadWrite);
       savePositions(score.get(), &partPosDevice, false);
-      jsonForMedia["mposXML"] = QString::fromLatin1(partDataPos.toBase64());
+      json.writeBase64("mposXML", partDataPos);
+      }
+
+      //export musicxml
+      {
+      QByteArray mxmlData;
+      QBuffer mxmlDevice(&mxmlData);
+      mxmlDevice.open(QIODevice::ReadWrite);
+      res &= saveMxl(score.get(), &mxmlDevice);
+      json.writeBase64("mxml", mxmlData);
+      }
 
       //export score pdf
+      {
       QByteArray pdfData;
       QBuffer pdfDevice(&pdfData);
       pdfDevice.open(QIODevice::ReadWrite);
+      {
       QPdfWriter writer(&pdfDevice);
       res &= mscore->savePdf(score.get(), writer);
-      jsonForMedia["pdf"] = QString::fromLatin1(pdfData.toBase64());
+      }
+      json.writeBase64("pdf", pdfData);
+      }
 
-      //export score midi
-      QByteArray midiData;
-      QBuffer midiDevice(&midiData);
-      midiDevice.open(QIODevice::ReadWrite);
-      res &= mscore->saveMidi(score.get(), &midiDevice);
-      jsonForMedia["midi"] = QString::fromLatin1(midiData.toBase64());
+      //export score pngs
+      json.beginArray("pngs");
+      QList<int> pageNumbers;
+      for (int i = 0; i < score->pages().size(); ++i)
+            pageNumbers.append(i);
+      mscore->renderPngs(score.get(), pageNumbers, [&json, &res](int, const QByteArray& pngData) {
+            res &= !pngData.isEmpty();
+            json.writeBase64(0, pngData);
+            return true;
+            });
+      json.endArray();
 
-      //export musicxml
-      QByteArray mxmlData;
-      QBuffer mxmlDevice(&mxmlData);
-      mxmlDevice.open(QIODevice::ReadWrite);
-      res &= saveMxl(score.get(), &mxmlDevice);
-      jsonForMedia["mxml"] = QString::fromLatin1(mxmlData.toBase64());
+      //export score .spos
+      {
+      QByteArray partDataPos;
+      QBuffer partPosDevice(&partDataPos);
+      partPosDevice.open(QIODevice::ReadWrite);
+      savePositions(score.get(), &partPosDevice, true);
+      json.writeBase64("sposXML", partDataPos);
+      }
 
-      //export metadata
-      jsonForMedia["metadata"] = mscore->saveMetadataJSON(score.get());
+      //export score svgs
+      json.beginArray("svgs");
+      for (int i = 0; i < score->pages().size(); ++i) {
+            QByteArray svgData;
+            QBuffer svgDevice(&svgData);
+            svgDevice.open(QIODevice::ReadWrite);
+            res &= mscore->saveSvg(score.get(), &svgDevice, i);
+            json.writeBase64(0, svgData);
+            }
+      json.endArray();
 
-      QJsonDocument jsonDoc(jsonForMedia);
-      const QString& jsonPath{outFilePath};
-      QFile file(jsonPath);
-      if (!file.open(QIODevice::WriteOnly))
-            return false;
-      
-      file.write(jsonDoc.toJson(QJsonDocument::Compact));
+      json.endObject();
+      res &= json.finish();
       file.close();
       
       return res;
@@ -514,7 +514,7 @@ bool ScoreView::saveFotoAs(bool printMode, const QRectF& r)
       int w = lrint(r.width()  * mag);
       int h = lrint(r.height() * mag);
 
-      double pr = MScore::pixelRatio;
+      double pr = MScore::pixelRatio();
       if (ext == "pdf") {
             QPdfWriter pdfWriter(fn);
             pdfWriter.setResolution(preferences.getInt(PREF_EXPORT_PDF_DPI));
@@ -525,7 +525,7 @@ bool ScoreView::saveFotoAs(bool printMode, const QRectF& r)
             pdfWriter.setPageMargins(QMarginsF(0.0, 0.0, 0.0, 0.0));
             pdfWriter.setCreator("MuseScore Version: " VERSION);
             pdfWriter.setTitle(fn);
-            MScore::pixelRatio = DPI / pdfWriter.logicalDpiX();
+            MScore::setPixelRatio(DPI / pdfWriter.logicalDpiX());
             QPainter p(&pdfWriter);
             MScore::pdfPrinting = true;
             paintRect(printMode, p, r, mag);
@@ -539,7 +539,7 @@ bool ScoreView::saveFotoAs(bool printMode, const QRectF& r)
             printer.setTitle(_score->title());
             printer.setSize(QSize(w, h));
             printer.setViewBox(QRect(0, 0, w, h));
-            MScore::pixelRatio = DPI / printer.logicalDpiX();
+            MScore::setPixelRatio(DPI / printer.logicalDpiX());
             QPainter p(&printer);
             MScore::pdfPrinting = true;
             paintRect(printMode, p, r, mag);
@@ -551,14 +551,14 @@ bool ScoreView::saveFotoAs(bool printMode, const QRectF& r)
             printer.setDotsPerMeterX(lrint((convDpi * 1000) / INCH));
             printer.setDotsPerMeterY(lrint((convDpi * 1000) / INCH));
             printer.fill(transparent ? 0 : 0xffffffff);
-            MScore::pixelRatio = 1.0 / mag;
+            MScore::setPixelRatio(1.0 / mag);
             QPainter p(&printer);
             paintRect(printMode, p, r, mag);
             printer.save(fn, "png");
             }
       else
             qDebug("unknown extension <%s>", qPrintable(ext));
-      MScore::pixelRatio = pr;
+      MScore::setPixelRatio(pr);
       return true;
       }
 
@@ -33,7 +33,14 @@
 
 namespace Ms {
 
-Score::FileError importMusicXMLfromBuffer(Score* score, const QString& /*name*/, QIODevice* dev)
+//---------------------------------------------------------
+//   importMusicXMLfromBuffer
+//    pass1Done, if set, is called after a successful pass 1;
+//    the import stops if it returns an error
+//---------------------------------------------------------
+
+Score::FileError importMusicXMLfromBuffer(Score* score, const QString& /*name*/, QIODevice* dev,
+   std::function<Score::FileError()> pass1Done)
       {
       //qDebug("importMusicXMLfromBuffer(score %p, name '%s', dev %p)",
       //       score, qPrintable(name), dev);
@@ -42,17 +49,30 @@ Score::FileError importMusicXMLfromBuffer(Score* score, const QString& /*name*/,
       logger.setLoggingLevel(MxmlLogger::Level::MXML_INFO);
       //logger.setLoggingLevel(MxmlLogger::Level::MXML_TRACE); // also include tracing
 
+      MusicXmlImportTimes& times = musicXmlImportTimes();
+      QElapsedTimer t;
+
       // pass 1
+      t.start();
       dev->seek(0);
       MusicXMLParserPass1 pass1(score, &logger);
       Score::FileError res = pass1.parse(dev);
+      times.pass1 += t.elapsed();
       if (res != Score::FileError::FILE_NO_ERROR)
             return res;
+      if (pass1Done) {
+            res = pass1Done();
+            if (res != Score::FileError::FILE_NO_ERROR)
+                  return res;
+            }
 
       // pass 2
+      t.start();
       dev->seek(0);
       MusicXMLParserPass2 pass2(score, pass1, &logger);
-      return pass2.parse(dev);
+      res = pass2.parse(dev);
+      times.pass2 += t.elapsed();
+      return res;
       }
 
 } // namespace Ms
@@ -27,7 +27,34 @@
 
 namespace Ms {
 
-Score::FileError importMusicXMLfromBuffer(Score* score, const QString&, QIODevice* dev);
+//---------------------------------------------------------
+//   MusicXmlValidation
+//    when imported files are validated against the schema
+//---------------------------------------------------------
+
+enum class MusicXmlValidation : char {
+      BEFORE,           // validate, then import
+      PARALLEL,         // validate on another thread during pass 1
+      ON_ERROR          // validate only if the import fails
+      };
+
+//---------------------------------------------------------
+//   MusicXmlImportTimes
+//    time in ms spent in the phases of all MusicXML
+//    imports of this process
+//---------------------------------------------------------
+
+struct MusicXmlImportTimes {
+      qint64 schema   { 0 };      // loading the schema, done once
+      qint64 validate { 0 };
+      qint64 pass1    { 0 };
+      qint64 pass2    { 0 };
+      int imports     { 0 };
+      };
+
+Score::FileError importMusicXMLfromBuffer(Score* score, const QString&, QIODevice* dev,
+   std::function<Score::FileError()> pass1Done = std::function<Score::FileError()>());
+MusicXmlImportTimes& musicXmlImportTimes();
 
 } // namespace Ms
 #endif
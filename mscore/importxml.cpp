@@ -26,6 +26,37 @@
 
 namespace Ms {
 
+static MusicXmlValidation validationMode = MusicXmlValidation::BEFORE;
+
+//---------------------------------------------------------
+//   musicXmlImportTimes
+//---------------------------------------------------------
+
+MusicXmlImportTimes& musicXmlImportTimes()
+      {
+      static MusicXmlImportTimes times;
+      return times;
+      }
+
+//---------------------------------------------------------
+//   setMusicXmlValidation
+//    set the validation mode from its command line name,
+//    return false if the name is unknown
+//---------------------------------------------------------
+
+bool setMusicXmlValidation(const QString& mode)
+      {
+      if (mode == "before")
+            validationMode = MusicXmlValidation::BEFORE;
+      else if (mode == "parallel")
+            validationMode = MusicXmlValidation::PARALLEL;
+      else if (mode == "on-error")
+            validationMode = MusicXmlValidation::ON_ERROR;
+      else
+            return false;
+      return true;
+      }
+
 //---------------------------------------------------------
 //   tupletAssert -- check assertions for tuplet handling
 //---------------------------------------------------------
@@ -92,6 +123,38 @@ static bool initMusicXmlSchema(QXmlSchema& schema)
       return true;
       }
 
+//---------------------------------------------------------
+//   musicXmlSchema
+//    return the MusicXML schema, loaded and compiled once
+//    per process, or null on error; the schema keeps its
+//    message handler, which must live as long
+//---------------------------------------------------------
+
+static const QXmlSchema* musicXmlSchema()
+      {
+      static QXmlSchema* schema = 0;
+      static ValidatorMessageHandler messageHandler;
+      static QString error;
+      static bool loaded = false;
+      if (!loaded) {
+            QElapsedTimer t;
+            t.start();
+            schema = new QXmlSchema;
+            schema->setMessageHandler(&messageHandler);
+            if (!initMusicXmlSchema(*schema)) {
+                  qDebug("musicXmlSchema() errors:\n%s", qPrintable(messageHandler.getErrors()));
+                  delete schema;
+                  schema = 0;
+                  error = MScore::lastError;
+                  }
+            musicXmlImportTimes().schema += t.elapsed();
+            loaded = true;
+            }
+      if (!schema)
+            MScore::lastError = error;
+      return schema;
+      }
+
 
 //---------------------------------------------------------
 //   musicXMLValidationErrorDialog
@@ -173,36 +236,49 @@ static bool extractRootfile(QFile* qf, QByteArray& data)
 
 
 //---------------------------------------------------------
-//   doValidate
+//   validate
 //---------------------------------------------------------
 
 /**
- Validate MusicXML data from file \a name contained in QIODevice \a dev.
+ Validate MusicXML data from file \a name contained in QIODevice \a dev,
+ set \a valid and return the validator messages in \a errors.
+ May run on another thread than the import.
  */
 
-static Score::FileError doValidate(const QString& name, QIODevice* dev)
+static Score::FileError validate(const QString& name, QIODevice* dev, bool& valid, QString& errors)
       {
-      QTime t;
-      t.start();
+      const QXmlSchema* schema = musicXmlSchema();
+      if (!schema)
+            return Score::FileError::FILE_BAD_FORMAT;  // appropriate error message has been printed by initMusicXmlSchema
 
-      // initialize the schema
+      QElapsedTimer t;
+      t.start();
       ValidatorMessageHandler messageHandler;
-      QXmlSchema schema;
-      schema.setMessageHandler(&messageHandler);
-      if (!initMusicXmlSchema(schema))
-            return Score::FileError::FILE_BAD_FORMAT;  // appropriate error message has been printed by initMusicXmlSchema
+      QXmlSchemaValidator validator(*schema);
+      validator.setMessageHandler(&messageHandler);
+      dev->seek(0);
+      valid = validator.validate(dev, QUrl::fromLocalFile(name));
+      errors = messageHandler.getErrors();
+      musicXmlImportTimes().validate += t.elapsed();
+      return Score::FileError::FILE_NO_ERROR;
+      }
 
-      // validate the data
-      QXmlSchemaValidator validator(schema);
-      bool valid = validator.validate(dev, QUrl::fromLocalFile(name));
-      //qDebug("Validation time elapsed: %d ms", t.elapsed());
+//---------------------------------------------------------
+//   checkValidation
+//---------------------------------------------------------
 
+/**
+ Report a failed validation of file \a name and ask the user whether to import it anyway.
+ */
+
+static Score::FileError checkValidation(const QString& name, bool valid, const QString& errors)
+      {
       if (!valid) {
             qDebug("importMusicXml() file '%s' is not a valid MusicXML file", qPrintable(name));
             MScore::lastError = QObject::tr("File '%1' is not a valid MusicXML file").arg(name);
             if (MScore::noGui)
                   return Score::FileError::FILE_NO_ERROR;   // might as well try anyhow in converter mode
-            if (musicXMLValidationErrorDialog(MScore::lastError, messageHandler.getErrors()) != QMessageBox::Yes)
+            if (musicXMLValidationErrorDialog(MScore::lastError, errors) != QMessageBox::Yes)
                   return Score::FileError::FILE_USER_ABORT;
             }
 
@@ -210,6 +286,70 @@ static Score::FileError doValidate(const QString& name, QIODevice* dev)
       return Score::FileError::FILE_NO_ERROR;
       }
 
+//---------------------------------------------------------
+//   doValidate
+//---------------------------------------------------------
+
+/**
+ Validate MusicXML data from file \a name contained in QIODevice \a dev.
+ */
+
+static Score::FileError doValidate(const QString& name, QIODevice* dev)
+      {
+      bool valid = false;
+      QString errors;
+      Score::FileError res = validate(name, dev, valid, errors);
+      if (res != Score::FileError::FILE_NO_ERROR)
+            return res;
+      return checkValidation(name, valid, errors);
+      }
+
+//---------------------------------------------------------
+//   doValidateParallelAndImport
+//---------------------------------------------------------
+
+/**
+ Import MusicXML data from file \a name contained in QIODevice \a dev into score \a score
+ while a copy of the data is validated on another thread. The validation result is
+ checked before pass 2, which is the first pass changing the score beyond its measures.
+ */
+
+static Score::FileError doValidateParallelAndImport(Score* score, const QString& name, QIODevice* dev)
+      {
+      // load the schema here, the validation thread only uses it
+      if (!musicXmlSchema())
+            return Score::FileError::FILE_BAD_FORMAT;  // appropriate error message has been printed by initMusicXmlSchema
+
+      dev->seek(0);
+      const QByteArray data = dev->readAll();
+      bool valid = false;
+      QString errors;
+      QFuture<Score::FileError> validation = QtConcurrent::run([&name, &data, &valid, &errors]() {
+            QBuffer buffer;
+            buffer.setData(data);
+            buffer.open(QIODevice::ReadOnly);
+            return validate(name, &buffer, valid, errors);
+            });
+
+      bool checked = false;
+      Score::FileError res = importMusicXMLfromBuffer(score, name, dev, [&]() {
+            checked = true;
+            Score::FileError vres = validation.result();
+            if (vres == Score::FileError::FILE_NO_ERROR)
+                  vres = checkValidation(name, valid, errors);
+            return vres;
+            });
+      if (!checked) {
+            // pass 1 failed, report the validation as if it had run first
+            Score::FileError vres = validation.result();
+            if (vres == Score::FileError::FILE_NO_ERROR)
+                  vres = checkValidation(name, valid, errors);
+            if (vres != Score::FileError::FILE_NO_ERROR)
+                  return vres;
+            }
+      return res;
+      }
+
 //---------------------------------------------------------
 //   doValidateAndImport
 //---------------------------------------------------------
@@ -223,14 +363,42 @@ static Score::FileError doValidateAndImport(Score* score, const QString& name, Q
       // verify tuplet TDuration::DurationType dependencies
       tupletAssert();
 
-      // validate the file
-      Score::FileError res;
-      res = doValidate(name, dev);
-      if (res != Score::FileError::FILE_NO_ERROR)
-            return res;
+      MusicXmlImportTimes& times = musicXmlImportTimes();
+      ++times.imports;
+
+      Score::FileError res = Score::FileError::FILE_NO_ERROR;
+      switch (validationMode) {
+            case MusicXmlValidation::BEFORE:
+                  // validate the file
+                  res = doValidate(name, dev);
+                  if (res != Score::FileError::FILE_NO_ERROR)
+                        return res;
+
+                  // actually do the import
+                  res = importMusicXMLfromBuffer(score, name, dev);
+                  break;
+
+            case MusicXmlValidation::PARALLEL:
+                  res = doValidateParallelAndImport(score, name, dev);
+                  break;
+
+            case MusicXmlValidation::ON_ERROR:
+                  res = importMusicXMLfromBuffer(score, name, dev);
+                  if (res != Score::FileError::FILE_NO_ERROR) {
+                        // find out whether the file is to blame
+                        bool valid = true;
+                        QString errors;
+                        if (validate(name, dev, valid, errors) == Score::FileError::FILE_NO_ERROR && !valid) {
+                              qDebug("importMusicXml() file '%s' is not a valid MusicXML file:\n%s", qPrintable(name), qPrintable(errors));
+                              MScore::lastError = QObject::tr("File '%1' is not a valid MusicXML file").arg(name);
+                              }
+                        }
+                  break;
+            }
 
-      // actually do the import
-      importMusicXMLfromBuffer(score, name, dev);
+      if (MScore::debugMode)
+            qDebug("MusicXML import times after %d files: schema %lld validate %lld pass1 %lld pass2 %lld ms",
+               times.imports, times.schema, times.validate, times.pass1, times.pass2);
       //qDebug("importMusicXml() return %d", int(res));
       return res;
       }
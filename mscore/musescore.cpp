@@ -139,6 +139,7 @@ extern Ms::Synthesizer* createAeolus();
 
 #ifdef ZERBERUS
 extern Ms::Synthesizer* createZerberus();
+extern void setZerberusSampleStreaming(bool);
 #endif
 
 #ifdef QT_NO_DEBUG
@@ -166,6 +167,7 @@ bool processJob = false;
 bool externalIcons = false;
 bool pluginMode = false;
 static bool startWithNewScore = false;
+static bool parallelSynthesizers = false;
 double guiScaling = 0.0;
 static double userDPI = 0.0;
 int trimMargin = -1;
@@ -180,6 +182,8 @@ QString mscoreGlobalShare;
 
 static QString outFileName;
 static QString jsonFileName;
+static QString jobReportFile;
+static int jobWorkers = 1;
 static QString audioDriver;
 static QString pluginName;
 static QString styleFile;
@@ -1000,7 +1004,7 @@ MuseScore::MuseScore()
                   guiScaling = 1.0;
             }
 
-      MScore::pixelRatio = DPI / screen->logicalDotsPerInch();
+      MScore::setPixelRatio(DPI / screen->logicalDotsPerInch());
 
       setObjectName("MuseScore");
       _sstate = STATE_INIT;
@@ -3241,19 +3245,13 @@ static void loadScores(const QStringList& argv)
       }
 
 //---------------------------------------------------------
-//   doConvert
+//   convertScore
+//    cs is in page layout mode
 //---------------------------------------------------------
 
-static bool doConvert(Score* cs, QString fn, QString plugin = "")
+static bool convertScore(Score* cs, QString fn, QString plugin)
       {
       bool rv = true;
-      LayoutMode layoutMode = cs->layoutMode();
-      cs->setLayoutMode(LayoutMode::PAGE);
-      if (cs->layoutMode() != layoutMode) {
-            cs->setLayoutMode(LayoutMode::PAGE);
-            cs->doLayout();
-            }
-
       if (!styleFile.isEmpty()) {
             QFile f(styleFile);
             if (f.open(QIODevice::ReadOnly))
@@ -3377,7 +3375,25 @@ static bool doConvert(Score* cs, QString fn, QString plugin = "")
             qDebug("don't know how to convert to %s", qPrintable(outFileName));
             return false;
             }
-      if (layoutMode != cs->layoutMode()) {
+      return rv;
+      }
+
+//---------------------------------------------------------
+//   doConvert
+//    convert in page layout mode and restore the layout
+//    mode afterwards on every path, a job file converts
+//    the same score to several outputs
+//---------------------------------------------------------
+
+static bool doConvert(Score* cs, QString fn, QString plugin = "")
+      {
+      LayoutMode layoutMode = cs->layoutMode();
+      if (layoutMode != LayoutMode::PAGE) {
+            cs->setLayoutMode(LayoutMode::PAGE);
+            cs->doLayout();
+            }
+      bool rv = convertScore(cs, fn, plugin);
+      if (cs->layoutMode() != layoutMode) {
             cs->setLayoutMode(layoutMode);
             cs->doLayout();
             }
@@ -3407,10 +3423,38 @@ static bool convert(const QString& inFile, const QString& outFile, const QString
       }
 
 //---------------------------------------------------------
-//   doProcessJob
+//   ConvertJob
+//    one entry of a conversion job file
 //---------------------------------------------------------
 
-static bool doProcessJob(QString jsonFile)
+struct ConvertJob {
+      QString inFile;
+      QString outFile;
+      QString plugin;
+      bool ok        { false };
+      bool done      { false };
+      qint64 loadMs  { 0 };         // reading and layout of inFile, 0 if the score was reused
+      qint64 timeMs  { 0 };         // conversion
+      };
+
+//---------------------------------------------------------
+//   changesScore
+//    return true if the conversion modifies the score, so
+//    that it can not be reused for the next output
+//---------------------------------------------------------
+
+static bool changesScore(const ConvertJob& job)
+      {
+      if (!job.plugin.isEmpty())
+            return true;
+      return exportScoreParts && (job.outFile.endsWith(".pdf") || job.outFile.endsWith(".png"));
+      }
+
+//---------------------------------------------------------
+//   readJobFile
+//---------------------------------------------------------
+
+static bool readJobFile(const QString& jsonFile, std::vector<ConvertJob>& jobs)
       {
       QFile f(jsonFile);
       if (!f.open(QIODevice::ReadOnly)) {
@@ -3430,9 +3474,7 @@ static bool doProcessJob(QString jsonFile)
             }
       QJsonArray a = doc.array();
       for (const auto i : a) {
-            QString inFile;
-            QString outFile;
-            QString plugin;
+            ConvertJob job;
             if (!i.isObject()) {
                   fprintf(stderr, "array value is not an object\n");
                   return false;
@@ -3441,22 +3483,238 @@ static bool doProcessJob(QString jsonFile)
             for (const auto& key : obj.keys()) {
                   QString val = obj.value(key).toString();
                   if (key == "in")
-                        inFile = val;
+                        job.inFile = val;
                   else if (key == "out")
-                        outFile = val;
+                        job.outFile = val;
                   else if (key == "plugin")
-                        plugin = val;
+                        job.plugin = val;
                   else {
                         fprintf(stderr, "unknown key <%s>\n", qPrintable(key));
                         return false;
                         }
                   }
-            if (!convert(inFile, outFile, plugin))
-                  return false;
+            jobs.push_back(job);
             }
       return true;
       }
 
+//---------------------------------------------------------
+//   writeJobFile
+//    write the jobs with the given indices
+//---------------------------------------------------------
+
+static bool writeJobFile(const QString& jsonFile, const std::vector<ConvertJob>& jobs, const std::vector<int>& indices)
+      {
+      QJsonArray a;
+      for (int i : indices) {
+            QJsonObject obj;
+            obj["in"] = jobs[i].inFile;
+            if (!jobs[i].outFile.isEmpty())
+                  obj["out"] = jobs[i].outFile;
+            if (!jobs[i].plugin.isEmpty())
+                  obj["plugin"] = jobs[i].plugin;
+            a.append(obj);
+            }
+      QFile f(jsonFile);
+      if (!f.open(QIODevice::WriteOnly))
+            return false;
+      return f.write(QJsonDocument(a).toJson()) != -1;
+      }
+
+//---------------------------------------------------------
+//   writeJobReport
+//    status and timing of every job, in job file order
+//---------------------------------------------------------
+
+static bool writeJobReport(const QString& reportFile, const std::vector<ConvertJob>& jobs)
+      {
+      QJsonArray a;
+      for (const ConvertJob& job : jobs) {
+            QJsonObject obj;
+            obj["in"] = job.inFile;
+            if (!job.outFile.isEmpty())
+                  obj["out"] = job.outFile;
+            if (!job.plugin.isEmpty())
+                  obj["plugin"] = job.plugin;
+            obj["status"] = job.done ? (job.ok ? "ok" : "failed") : "skipped";
+            obj["loadTime"] = job.loadMs;
+            obj["time"] = job.timeMs;
+            a.append(obj);
+            }
+      QFile f(reportFile);
+      if (!f.open(QIODevice::WriteOnly)) {
+            fprintf(stderr, "cannot write job report <%s>\n", qPrintable(reportFile));
+            return false;
+            }
+      return f.write(QJsonDocument(a).toJson()) != -1;
+      }
+
+//---------------------------------------------------------
+//   readJobReport
+//    take status and timing from the report of a worker
+//---------------------------------------------------------
+
+static void readJobReport(const QString& reportFile, std::vector<ConvertJob>& jobs, const std::vector<int>& indices)
+      {
+      QFile f(reportFile);
+      if (!f.open(QIODevice::ReadOnly))
+            return;
+      QJsonArray a = QJsonDocument::fromJson(f.readAll()).array();
+      for (int i = 0; i < a.size() && i < int(indices.size()); ++i) {
+            QJsonObject obj = a.at(i).toObject();
+            ConvertJob& job = jobs[indices[i]];
+            QString status  = obj.value("status").toString();
+            job.done   = status != "skipped";
+            job.ok     = status == "ok";
+            job.loadMs = qint64(obj.value("loadTime").toDouble());
+            job.timeMs = qint64(obj.value("time").toDouble());
+            }
+      }
+
+//---------------------------------------------------------
+//   runJobs
+//    convert in this process, reading every input file
+//    once for all of its outputs
+//---------------------------------------------------------
+
+static void runJobs(std::vector<ConvertJob>& jobs, const std::vector<int>& indices)
+      {
+      MasterScore* score = 0;
+      QString scoreFile;
+      for (int i : indices) {
+            ConvertJob& job = jobs[i];
+            job.done = true;
+            if (job.inFile.isEmpty() || (job.outFile.isEmpty() && job.plugin.isEmpty())) {
+                  fprintf(stderr, "cannot convert <%s> to <%s>\n", qPrintable(job.inFile), qPrintable(job.outFile));
+                  continue;
+                  }
+            fprintf(stderr, "convert <%s> to <%s>\n", qPrintable(job.inFile), qPrintable(job.outFile));
+            QElapsedTimer timer;
+            timer.start();
+            if (!score || scoreFile != job.inFile) {
+                  delete score;
+                  score     = mscore->readScore(job.inFile);
+                  scoreFile = job.inFile;
+                  job.loadMs = timer.restart();
+                  if (!score)
+                        continue;
+                  }
+            job.ok     = doConvert(score, job.outFile, job.plugin);
+            job.timeMs = timer.elapsed();
+            if (changesScore(job)) {
+                  delete score;
+                  score = 0;
+                  }
+            }
+      delete score;
+      }
+
+//---------------------------------------------------------
+//   runJobWorkers
+//    distribute the jobs by input file over worker
+//    processes and wait for them
+//---------------------------------------------------------
+
+static void runJobWorkers(std::vector<ConvertJob>& jobs, const std::vector<std::vector<int>>& groups, int workers)
+      {
+      // biggest groups first, each to the worker with the least jobs
+      std::vector<const std::vector<int>*> sorted;
+      for (const auto& g : groups)
+            sorted.push_back(&g);
+      std::stable_sort(sorted.begin(), sorted.end(), [](const std::vector<int>* a, const std::vector<int>* b) {
+            return a->size() > b->size();
+            });
+      std::vector<std::vector<int>> buckets(workers);
+      for (const std::vector<int>* g : sorted) {
+            auto b = std::min_element(buckets.begin(), buckets.end(), [](const std::vector<int>& a, const std::vector<int>& b) {
+                  return a.size() < b.size();
+                  });
+            b->insert(b->end(), g->begin(), g->end());
+            }
+
+      // the workers get all options of this process except the job ones
+      QStringList options;
+      QStringList args = QCoreApplication::arguments();
+      for (int i = 1; i < args.size(); ++i) {
+            const QString& a = args[i];
+            if (a == "-j" || a == "--job" || a == "--job-workers" || a == "--job-report")
+                  ++i;
+            else if (!a.startsWith("--job=") && !a.startsWith("--job-workers=") && !a.startsWith("--job-report="))
+                  options.append(a);
+            }
+
+      QTemporaryDir dir;
+      std::vector<QProcess*> processes;
+      for (int w = 0; w < workers; ++w) {
+            if (buckets[w].empty())
+                  continue;
+            QString jobFile = QString("%1/job%2.json").arg(dir.path()).arg(w);
+            if (!dir.isValid() || !writeJobFile(jobFile, jobs, buckets[w])) {
+                  fprintf(stderr, "cannot write job file for worker %d\n", w);
+                  continue;
+                  }
+            QProcess* p = new QProcess;
+            p->setProcessChannelMode(QProcess::ForwardedChannels);
+            p->setProperty("worker", w);
+            p->start(QCoreApplication::applicationFilePath(), QStringList(options)
+               << "-j" << jobFile << "--job-workers" << "1" << "--job-report" << QString("%1/report%2.json").arg(dir.path()).arg(w));
+            processes.push_back(p);
+            }
+      for (QProcess* p : processes) {
+            int w = p->property("worker").toInt();
+            if (!p->waitForFinished(-1) || p->exitStatus() != QProcess::NormalExit)
+                  fprintf(stderr, "conversion worker %d failed\n", w);
+            readJobReport(QString("%1/report%2.json").arg(dir.path()).arg(w), jobs, buckets[w]);
+            delete p;
+            }
+      }
+
+//---------------------------------------------------------
+//   doProcessJob
+//    Entries with the same input file are converted from
+//    one score. With --job-workers, the input files are
+//    distributed over that many worker processes; libmscore
+//    keeps global state, so scores are not converted on
+//    several threads of one process.
+//---------------------------------------------------------
+
+static bool doProcessJob(QString jsonFile)
+      {
+      std::vector<ConvertJob> jobs;
+      if (!readJobFile(jsonFile, jobs))
+            return false;
+
+      // group the entries by input file, in order of appearance
+      std::vector<std::vector<int>> groups;
+      QHash<QString, int> groupIndex;
+      for (int i = 0; i < int(jobs.size()); ++i) {
+            auto gi = groupIndex.find(jobs[i].inFile);
+            if (gi == groupIndex.end()) {
+                  gi = groupIndex.insert(jobs[i].inFile, int(groups.size()));
+                  groups.emplace_back();
+                  }
+            groups[gi.value()].push_back(i);
+            }
+
+      int workers = jobWorkers > 0 ? jobWorkers : QThread::idealThreadCount();
+      workers     = qMin(workers, int(groups.size()));
+      if (workers > 1)
+            runJobWorkers(jobs, groups, workers);
+      else {
+            std::vector<int> indices;
+            for (const auto& g : groups)
+                  indices.insert(indices.end(), g.begin(), g.end());
+            runJobs(jobs, indices);
+            }
+
+      bool ok = true;
+      for (const ConvertJob& job : jobs)
+            ok = ok && job.ok;
+      if (!jobReportFile.isEmpty() && !writeJobReport(jobReportFile, jobs))
+            ok = false;
+      return ok;
+      }
+
 //---------------------------------------------------------
 //   processNonGui
 //---------------------------------------------------------
@@ -6518,11 +6776,6 @@ bool MuseScore::saveMp3(Score* score, QIODevice* device, bool& wasCanceled)
       Q_UNUSED(name);
       return false;
 #else
-      EventMap events;
-      score->renderMidi(&events);
-      if(events.size() == 0)
-            return false;
-
       MP3Exporter exporter;
       if (!exporter.loadLibrary(MP3Exporter::AskUser::MAYBE)) {
             QSettings set;
@@ -6559,7 +6812,6 @@ bool MuseScore::saveMp3(Score* score, QIODevice* device, bool& wasCanceled)
 
       int channels = 2;
 
-      int oldSampleRate = MScore::sampleRate;
       int sampleRate = preferences.getInt(PREF_EXPORT_AUDIO_SAMPLERATE);
       exporter.setBitrate(preferences.getInt(PREF_EXPORT_MP3_BITRATE));
 
@@ -6571,27 +6823,11 @@ bool MuseScore::saveMp3(Score* score, QIODevice* device, bool& wasCanceled)
                      QString::null, QString::null);
                   }
             qDebug("Unable to initialize MP3 stream");
-            MScore::sampleRate = oldSampleRate;
             return false;
             }
 
       int bufferSize   = exporter.getOutBufferSize();
       uchar* bufferOut = new uchar[bufferSize];
-      MasterSynthesizer* synth = synthesizerFactory();
-      synth->init();
-      synth->setSampleRate(sampleRate);
-      if (MScore::noGui) { // use score settings if possible
-            bool r = synth->setState(score->synthesizerState());
-            if (!r)
-                  synth->init();
-            }
-      else { // use current synth settings
-            bool r = synth->setState(mscore->synthesizerState());
-            if (!r)
-                  synth->init();
-            }
-
-      MScore::sampleRate = sampleRate;
 
       QProgressDialog progress(this);
       progress.setWindowFlags(Qt::WindowFlags(Qt::Dialog | Qt::FramelessWindowHint | Qt::WindowTitleHint));
@@ -6599,180 +6835,58 @@ bool MuseScore::saveMp3(Score* score, QIODevice* device, bool& wasCanceled)
       //progress.setCancelButton(0);
       progress.setCancelButtonText(tr("Cancel"));
       progress.setLabelText(tr("Exporting..."));
+      progress.setRange(0, 1000);
       if (!MScore::noGui)
             progress.show();
 
+      std::function<bool(float)> progressCallback = nullptr;
+      if (!MScore::noGui) {
+            progressCallback = [&progress](float v) -> bool {
+                  if (progress.wasCanceled())
+                        return false;
+                  progress.setValue(v * 1000);
+                  qApp->processEvents();
+                  return true;
+                  };
+            }
+
       static const int FRAMES = 512;
       float bufferL[FRAMES];
       float bufferR[FRAMES];
-
-      float  peak = 0.0;
-      double gain = 1.0;
-      EventMap::const_iterator endPos = events.cend();
-      --endPos;
-      const int et = (score->utick2utime(endPos->first) + 1) * MScore::sampleRate;
-      const int maxEndTime = (score->utick2utime(endPos->first) + 3) * MScore::sampleRate;
-      progress.setRange(0, et);
-
-      for (int pass = 0; pass < 2; ++pass) {
-            EventMap::const_iterator playPos;
-            playPos = events.cbegin();
-            synth->allSoundsOff(-1);
-
-            //
-            // init instruments
-            //
-            foreach(Part* part, score->parts()) {
-                  const InstrumentList* il = part->instruments();
-                  for(auto i = il->begin(); i!= il->end(); i++) {
-                        for (const Channel* a : i->second->channel()) {
-                              a->updateInitList();
-                              for (MidiCoreEvent e : a->init) {
-                                    if (e.type() == ME_INVALID)
-                                          continue;
-                                    e.setChannel(a->channel());
-                                    int syntiIdx= synth->index(score->masterScore()->midiMapping(a->channel())->articulation->synti());
-									synth->play(e, syntiIdx);
-                                    }
-                              }
-                        }
+      auto encode = [&](const float* sp, unsigned frames) -> bool {
+            for (unsigned i = 0; i < frames; ++i) {
+                  bufferL[i] = *sp++;
+                  bufferR[i] = *sp++;
+                  }
+            long bytes;
+            if (FRAMES < inSamples)
+                  bytes = exporter.encodeRemainder(bufferL, bufferR,  FRAMES , bufferOut);
+            else
+                  bytes = exporter.encodeBuffer(bufferL, bufferR, bufferOut);
+            if (bytes < 0) {
+                  if (MScore::noGui)
+                        qDebug("exportmp3: error from encoder: %ld", bytes);
+                  else
+                        QMessageBox::warning(0,
+                           tr("Encoding Error"),
+                           tr("Error %1 returned from MP3 encoder").arg(bytes),
+                           QString::null, QString::null);
+                  return false;
                   }
+            device->write((char*)bufferOut, bytes);
+            return true;
+            };
 
-            int playTime = 0.0;
-
-            for (;;) {
-                  unsigned frames = FRAMES;
-                  float max = 0;
-                  //
-                  // collect events for one segment
-                  //
-                  memset(bufferL, 0, sizeof(float) * FRAMES);
-                  memset(bufferR, 0, sizeof(float) * FRAMES);
-                  double endTime = playTime + frames;
-
-                  float* l = bufferL;
-                  float* r = bufferR;
-
-                  for (; playPos != events.cend(); ++playPos) {
-                        double f = score->utick2utime(playPos->first) * MScore::sampleRate;
-                        if (f >= endTime)
-                              break;
-                        int n = f - playTime;
-                        if (n) {
-#if (!defined (_MSCVER) && !defined (_MSC_VER))
-                              float bu[n * 2];
-                              memset(bu, 0, sizeof(float) * 2 * n);
-#else
-                              // MSVC does not support VLA. Replace with std::vector. If profiling determines that the
-                              //    heap allocation is slow, an optimization might be used.
-                              std::vector<float> vBu(n * 2, 0);   // Default initialized, memset() not required.
-                              float* bu = vBu.data();
-#endif
-
-                              synth->process(n, bu);
-                              float* sp = bu;
-                              for (int i = 0; i < n; ++i) {
-                                    *l++ = *sp++;
-                                    *r++ = *sp++;
-                                    }
-                              playTime  += n;
-                              frames    -= n;
-                              }
-                        const NPlayEvent& e = playPos->second;
-                        if (e.isChannelEvent()) {
-                              int channelIdx = e.channel();
-                              Channel* c = score->masterScore()->midiMapping(channelIdx)->articulation;
-                              if (!c->mute()) {
-                                    synth->play(e, synth->index(c->synti()));
-                                    }
-                              }
-                        }
-                  if (frames) {
-#if (!defined (_MSCVER) && !defined (_MSC_VER))
-                        float bu[frames * 2];
-                        memset(bu, 0, sizeof(float) * 2 * frames);
-#else
-                        // MSVC does not support VLA. Replace with std::vector. If profiling determines that the
-                        //    heap allocation is slow, an optimization might be used.
-                        std::vector<float> vBu(frames * 2, 0);   // Default initialized, memset() not required.
-                        float* bu = vBu.data();
-#endif
-                        synth->process(frames, bu);
-                        float* sp = bu;
-                        for (unsigned i = 0; i < frames; ++i) {
-                              *l++ = *sp++;
-                              *r++ = *sp++;
-                              }
-                        playTime += frames;
-                        }
-
-                  if (pass == 1) {
-                        for (int i = 0; i < FRAMES; ++i) {
-                              max = qMax(max, qAbs(bufferL[i]));
-                              max = qMax(max, qAbs(bufferR[i]));
-                              bufferL[i] *= gain;
-                              bufferR[i] *= gain;
-                              }
-                        long bytes;
-                        if (FRAMES < inSamples)
-                              bytes = exporter.encodeRemainder(bufferL, bufferR,  FRAMES , bufferOut);
-                        else
-                              bytes = exporter.encodeBuffer(bufferL, bufferR, bufferOut);
-                        if (bytes < 0) {
-                              if (MScore::noGui)
-                                    qDebug("exportmp3: error from encoder: %ld", bytes);
-                              else
-                                    QMessageBox::warning(0,
-                                       tr("Encoding Error"),
-                                       tr("Error %1 returned from MP3 encoder").arg(bytes),
-                                       QString::null, QString::null);
-                              break;
-                              }
-                        else
-                              device->write((char*)bufferOut, bytes);
-                        }
-                  else {
-                        for (int i = 0; i < FRAMES; ++i) {
-                              max = qMax(max, qAbs(bufferL[i]));
-                              max = qMax(max, qAbs(bufferR[i]));
-                              peak = qMax(peak, qAbs(bufferL[i]));
-                              peak = qMax(peak, qAbs(bufferR[i]));
-                              }
-                        }
-                  playTime = endTime;
-                  if (!MScore::noGui) {
-                        if (progress.wasCanceled())
-                              break;
-                        progress.setValue((pass * et + playTime) / 2);
-                        qApp->processEvents();
-                        }
-                  if (playTime >= et)
-                        synth->allNotesOff(-1);
-                  // create sound until the sound decays
-                  if (playTime >= et && max * peak < 0.000001)
-                        break;
-                  // hard limit
-                  if (playTime > maxEndTime)
-                        break;
-                  }
-            if (progress.wasCanceled())
-                  break;
-            if (pass == 0 && peak == 0.0) {
-                  qDebug("song is empty");
-                  break;
-                  }
-            gain = 0.99 / peak;
-            }
+      // the encoder needs the peak of the whole song, so always normalize
+      bool res = renderAudio(score, sampleRate, true, encode, progressCallback);
 
       long bytes = exporter.finishStream(bufferOut);
       if (bytes > 0L)
             device->write((char*)bufferOut, bytes);
       wasCanceled = progress.wasCanceled();
       progress.close();
-      delete synth;
       delete[] bufferOut;
-      MScore::sampleRate = oldSampleRate;
-      return true;
+      return res || wasCanceled;
 #endif
       }
 
@@ -6913,6 +7027,8 @@ int main(int argc, char* av[])
       parser.addOption(QCommandLineOption({"R", "revert-settings"}, "Revert to default preferences"));
       parser.addOption(QCommandLineOption({"i", "load-icons"}, "Load icons from INSTALLPATH/icons"));
       parser.addOption(QCommandLineOption({"j", "job"}, "Process a conversion job", "file"));
+      parser.addOption(QCommandLineOption(      "job-workers", "Used with '-j <file>', number of worker processes, 0 for one per processor core", "count"));
+      parser.addOption(QCommandLineOption(      "job-report", "Used with '-j <file>', write status and time of every conversion to a JSON file", "file"));
       parser.addOption(QCommandLineOption({"e", "experimental"}, "Enable experimental features"));
       parser.addOption(QCommandLineOption({"c", "config-folder"}, "Override configuration and settings folder", "dir"));
       parser.addOption(QCommandLineOption({"t", "test-mode"}, "Set test mode flag for all files")); // this includes --template-mode
@@ -6921,6 +7037,10 @@ int main(int argc, char* av[])
       parser.addOption(QCommandLineOption({"w", "no-webview"}, "No web view in start center"));
       parser.addOption(QCommandLineOption({"P", "export-score-parts"}, "Used with '-o <file>.pdf', export score and parts"));
       parser.addOption(QCommandLineOption(      "no-fallback-font", "Don't use Bravura as fallback musical font"));
+      parser.addOption(QCommandLineOption(      "parallel-layout", "Lay out the staves of a measure on multiple threads"));
+      parser.addOption(QCommandLineOption(      "parallel-synthesizers", "Render the synthesizers on multiple threads during playback"));
+      parser.addOption(QCommandLineOption(      "stream-sfz-samples", "Keep only the head of SFZ samples in memory and stream the rest from disk"));
+      parser.addOption(QCommandLineOption(      "musicxml-validation", "Validate imported MusicXML files 'before' the import (default), in 'parallel' to it or only 'on-error'", "mode"));
       parser.addOption(QCommandLineOption({"f", "force"}, "Used with '-o <file>', ignore warnings reg. score being corrupted or from wrong version"));
       parser.addOption(QCommandLineOption({"b", "bitrate"}, "Used with '-o <file>.mp3', sets bitrate, in kbps", "bitrate"));
       parser.addOption(QCommandLineOption({"E", "install-extension"}, "Install an extension, load soundfont as default unless if -e is passed too", "extension file"));
@@ -6953,6 +7073,15 @@ int main(int argc, char* av[])
       midiInputTrace = parser.isSet("I");
       midiOutputTrace = parser.isSet("O");
       MScore::useFallbackFont = !parser.isSet("no-fallback-font");
+      MScore::parallelLayout = parser.isSet("parallel-layout");
+      parallelSynthesizers = parser.isSet("parallel-synthesizers");
+#ifdef ZERBERUS
+      setZerberusSampleStreaming(parser.isSet("stream-sfz-samples"));
+#endif
+      if (parser.isSet("musicxml-validation") && !setMusicXmlValidation(parser.value("musicxml-validation"))) {
+            fprintf(stderr, "unknown MusicXML validation mode '%s'\n", qPrintable(parser.value("musicxml-validation")));
+            parser.showHelp(EXIT_FAILURE);
+            }
 
       if ((converterMode = parser.isSet("o"))) {
             MScore::noGui = true;
@@ -6968,6 +7097,13 @@ int main(int argc, char* av[])
                   fprintf(stderr, "json file name missing\n");
                   parser.showHelp(EXIT_FAILURE);
                   }
+            if (parser.isSet("job-workers")) {
+                  bool ok;
+                  jobWorkers = parser.value("job-workers").toInt(&ok);
+                  if (!ok || jobWorkers < 0)
+                        parser.showHelp(EXIT_FAILURE);
+                  }
+            jobReportFile = parser.value("job-report");
             }
       if ((pluginMode = parser.isSet("p"))) {
             MScore::noGui = true;
@@ -7165,6 +7301,7 @@ int main(int argc, char* av[])
 
       QNetworkProxyFactory::setUseSystemConfiguration(true);
 
+      MScore::fontMetricsCacheDir = QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + "/fontmetrics";
       MScore::init();         // initialize libmscore
       updateExternalValuesFromPreferences();
 
@@ -7255,6 +7392,8 @@ int main(int argc, char* av[])
                   synti->setSampleRate(MScore::sampleRate);
                   synti->init();
                   }
+            synti->setParallel(parallelSynthesizers);
+            synti->setRealtime(true);
             seq->setMasterSynthesizer(synti);
             }
       else {
@@ -709,6 +709,8 @@ class MuseScore : public QMainWindow, public MuseScoreCore {
 
       bool saveAudio(Score*, QIODevice*, std::function<bool(float)> updateProgress = nullptr);
       bool saveAudio(Score*, const QString& name);
+      bool renderAudio(Score*, int sampleRate, bool normalize, std::function<bool(const float*, unsigned)> write,
+         std::function<bool(float)> updateProgress = nullptr);
       bool canSaveMp3();
       bool saveMp3(Score*, const QString& name);
       bool saveMp3(Score*, QIODevice*, bool& wasCanceled);
@@ -716,6 +718,7 @@ class MuseScore : public QMainWindow, public MuseScoreCore {
       bool saveSvg(Score*, QIODevice*, int pageNum = 0);
       bool savePng(Score*, QIODevice*, int pageNum = 0);
       bool savePng(Score*, const QString& name);
+      bool renderPngs(Score*, const QList<int>& pageNumbers, std::function<bool(int, const QByteArray&)> write);
       bool saveMidi(Score*, const QString& name);
       bool saveMidi(Score*, QIODevice*);
       bool savePositions(Score*, const QString& name, bool segments);
@@ -877,6 +880,7 @@ extern Score::FileError importGTP(MasterScore*, const QString& name);
 extern Score::FileError importBww(MasterScore*, const QString& path);
 extern Score::FileError importMusicXml(MasterScore*, const QString&);
 extern Score::FileError importCompressedMusicXml(MasterScore*, const QString&);
+extern bool setMusicXmlValidation(const QString& mode);
 extern Score::FileError importMuseData(MasterScore*, const QString& name);
 extern Score::FileError importLilypond(MasterScore*, const QString& name);
 extern Score::FileError importBB(MasterScore*, const QString& name);
@@ -29,6 +29,7 @@
 #include "textcursor.h"
 #include "textpalette.h"
 #include "texttools.h"
+#include "tilecache.h"
 #include "fotomode.h"
 #include "tourhandler.h"
 
@@ -138,6 +139,14 @@ ScoreView::ScoreView(QWidget* parent)
       _fgColor    = Qt::white;
       _fgPixmap    = 0;
       _bgPixmap    = 0;
+      _tileCache   = new TileCache(
+         [this](QPainter& p, Page* page, const QRectF& r) {
+               if (_score && _score->pages().contains(page))
+                     drawDisplayList(p, page, r, 0);
+               },
+         [this](Page* page, const QRectF& r) {
+               update(_matrix.mapRect(r.translated(page->pos())).toAlignedRect());
+               });
 
       editData.curGrip = Grip::NO_GRIP;
       editData.grips   = 0;
@@ -209,6 +218,7 @@ void ScoreView::setScore(Score* s)
             }
 
       _score = s;
+      _tileCache->cancel();
       if (_score) {
             if (_score->isMaster()) {
                   MasterScore* ms = static_cast<MasterScore*>(s);
@@ -255,6 +265,7 @@ ScoreView::~ScoreView()
       delete _curLoopOut;
       delete _bgPixmap;
       delete _fgPixmap;
+      delete _tileCache;
       delete shadowNote;
       }
 
@@ -503,12 +514,15 @@ void ScoreView::setBackground(const QColor& color)
 
 //---------------------------------------------------------
 //   setForeground
+//    called when the preferences change; the colors of
+//    the elements in the tiles may have changed as well
 //---------------------------------------------------------
 
 void ScoreView::setForeground(QPixmap* pm)
       {
       delete _fgPixmap;
       _fgPixmap = pm;
+      _tileCache->clear();
       update();
       }
 
@@ -517,6 +531,7 @@ void ScoreView::setForeground(const QColor& color)
       delete _fgPixmap;
       _fgPixmap = 0;
       _fgColor = color;
+      _tileCache->clear();
       update();
       }
 
@@ -526,9 +541,24 @@ void ScoreView::setForeground(const QColor& color)
 
 void ScoreView::dataChanged(const QRectF& r)
       {
+      for (Page* page : _score->pages()) {
+            QRectF pr(page->abbox().translated(page->pos()));
+            if (pr.intersects(r))
+                  _tileCache->invalidate(page, r.translated(-page->pos()));
+            }
       update(_matrix.mapRect(r).toRect());  // generate paint event
       }
 
+//---------------------------------------------------------
+//   updateAll
+//---------------------------------------------------------
+
+void ScoreView::updateAll()
+      {
+      _tileCache->clear();
+      update();
+      }
+
 //---------------------------------------------------------
 //   moveCursor
 //    move cursor during playback
@@ -1055,6 +1085,58 @@ void ScoreView::drawElements(QPainter& painter, QList<Element*>& el, Element* ed
             }
       }
 
+//---------------------------------------------------------
+//   drawDisplayList
+//    replay the display list of page for the elements which
+//    intersect r (page coordinates)
+//---------------------------------------------------------
+
+void ScoreView::drawDisplayList(QPainter& painter, Page* page, const QRectF& r, Element* editElement)
+      {
+      for (const DisplayItem& di : page->displayList()) {
+            if (!di.bbox.intersects(r))
+                  continue;
+            const Element* e = di.element;
+
+            // see drawElements()
+            if (e == editElement)
+                  continue;
+
+            if (!e->visible() && (score()->printing() || !score()->showInvisible()))
+                  continue;
+            if (e->isRest() && toRest(e)->isGap())
+                  continue;
+            painter.translate(di.pos);
+            e->draw(&painter);
+            painter.translate(-di.pos);
+#ifndef NDEBUG
+            if (e->selected())
+                  drawDebugInfo(painter, e);
+#endif
+            }
+      }
+
+//---------------------------------------------------------
+//   elementsMayMove
+//    return true if elements may be moved without a layout,
+//    as while they are dragged or edited; the positions in
+//    the display lists of the pages are not valid then
+//---------------------------------------------------------
+
+bool ScoreView::elementsMayMove() const
+      {
+      switch (state) {
+            case ViewState::DRAG_OBJECT:
+            case ViewState::EDIT:
+            case ViewState::DRAG_EDIT:
+            case ViewState::FOTO_DRAG_EDIT:
+            case ViewState::FOTO_DRAG_OBJECT:
+                  return true;
+            default:
+                  return false;
+            }
+      }
+
 //---------------------------------------------------------
 //   paint
 //---------------------------------------------------------
@@ -1103,8 +1185,17 @@ void ScoreView::paint(const QRect& r, QPainter& p)
             }
 
       QRegion r1(r);
+      bool retained = !elementsMayMove();
+      // page tiles are drawn without the edit element and only on screen
+      bool tiled    = retained && !editElement && p.device() == this && !score()->printing()
+                      && preferences.getBool(PREF_UI_CANVAS_MISC_TILEDDRAWING);
+      if (tiled)
+            _tileCache->setAntialias(preferences.getBool(PREF_UI_CANVAS_MISC_ANTIALIASEDDRAWING));
       if ((_score->layoutMode() == LayoutMode::LINE) || (_score->layoutMode() == LayoutMode::SYSTEM)) {
             if (_score->pages().size() > 0) {
+                  // the single page holds the whole score: query the bsp
+                  // tree, a display list would be scanned in full for every
+                  // paint and rebuilt for every edit
                   Page* page = _score->pages().front();
                   QList<Element*> ell = page->items(fr);
                   drawElements(p, ell, editElement);
@@ -1120,10 +1211,16 @@ void ScoreView::paint(const QRect& r, QPainter& p)
 
                   if (!score()->printing())
                         paintPageBorder(p, page);
-                  QList<Element*> ell = page->items(fr.translated(-page->pos()));
                   QPointF pos(page->pos());
                   p.translate(pos);
-                  drawElements(p, ell, editElement);
+                  if (tiled)
+                        _tileCache->paint(p, page, fr.translated(-pos) & page->bbox());
+                  else if (retained)
+                        drawDisplayList(p, page, fr.translated(-pos), editElement);
+                  else {
+                        QList<Element*> ell = page->items(fr.translated(-pos));
+                        drawElements(p, ell, editElement);
+                        }
 
 #ifndef NDEBUG
                   if (!score()->printing()) {
@@ -1149,7 +1246,7 @@ void ScoreView::paint(const QRect& r, QPainter& p)
                                                             QPointF pt(s->pos().x() + m->pos().x() + system->pos().x(),
                                                                system->staffYpage(i));
                                                             p.translate(pt);
-                                                            s->shapes().at(i).paint(p);
+                                                            s->staffShape(i).paint(p);
                                                             p.translate(-pt);
                                                             }
                                                       }
@@ -4165,6 +4262,7 @@ void ScoreView::layoutChanged()
       {
       if (mscore->navigator())
             mscore->navigator()->layoutChanged();
+      // the tiles of the pages laid out again are dropped by the tile cache
       _curLoopIn->move(_score->pos(POS::LEFT));
       Measure* lm = _score->lastMeasure();
       if (lm && _score->pos(POS::RIGHT) > lm->endTick())
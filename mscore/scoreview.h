@@ -46,6 +46,7 @@ class Tuplet;
 class FretDiagram;
 class Bend;
 class TremoloBar;
+class TileCache;
 
 #ifdef Q_OS_MAC
 #define CONTROL_MODIFIER Qt::AltModifier
@@ -106,6 +107,7 @@ class ScoreView : public QWidget, public MuseScoreView {
 
       QTransform _matrix, imatrix;
       MagIdx _magIdx;
+      TileCache* _tileCache;        ///< rasterized pages for scrolling and zooming
 
       QFocusFrame* focusFrame;
 
@@ -178,6 +180,8 @@ class ScoreView : public QWidget, public MuseScoreView {
 
       void setShadowNote(const QPointF&);
       void drawElements(QPainter& p,QList<Element*>& el, Element* editElement);
+      void drawDisplayList(QPainter& p, Page* page, const QRectF& r, Element* editElement);
+      bool elementsMayMove() const;
       bool dragTimeAnchorElement(const QPointF& pos);
       bool dragMeasureAnchorElement(const QPointF& pos);
       virtual void lyricsTab(bool back, bool end, bool moveOnly) override;
@@ -380,7 +384,7 @@ class ScoreView : public QWidget, public MuseScoreView {
 
       virtual void layoutChanged();
       virtual void dataChanged(const QRectF&);
-      virtual void updateAll()    { update(); }
+      virtual void updateAll();
       virtual void adjustCanvasPosition(const Element* el, bool playBack, int staff = -1) override;
       virtual void setCursor(const QCursor& c) { QWidget::setCursor(c); }
       virtual QCursor cursor() const { return QWidget::cursor(); }
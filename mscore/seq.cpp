@@ -63,6 +63,9 @@ Seq* seq;
 static const int guiRefresh   = 10;       // Hz
 static const int peakHoldTime = 1400;     // msec
 static const int peakHold     = (peakHoldTime * guiRefresh) / 1000;
+static const int MIDI_CHUNK_MEASURES = 8;   // minimal size of a rendered chunk
+static const size_t MIDI_CHUNKS_AHEAD = 2;  // chunks rendered ahead of the play position
+static const int GUI_TO_SEQ_TIMEOUT = 200;   // msec a message may wait for room in the fifo
 static OggVorbis_File vf;
 
 #if 0 // yet(?) unused
@@ -152,6 +155,7 @@ Seq::Seq()
       maxMidiOutPort  = 0;
 
       endUTick  = 0;
+      allRendered = true;
       state    = Transport::STOP;
       oggInit  = false;
       _driver  = 0;
@@ -558,39 +562,41 @@ void Seq::recomputeMaxMidiOutPort()
 
 void Seq::processMessages()
       {
+      // the latest tempo change and seek, see SeqMsgFifo
+      qreal relTempo;
+      if (toSeq.takeTempo(&relTempo) && cs) {
+            if (playFrame != 0) {
+                  int utick = cs->utime2utick(qreal(playFrame) / qreal(MScore::sampleRate));
+                  cs->tempomap()->setRelTempo(relTempo);
+                  playFrame = cs->utick2utime(utick) * MScore::sampleRate;
+                  if (preferences.getBool(PREF_IO_JACK_TIMEBASEMASTER) && preferences.getBool(PREF_IO_JACK_USEJACKTRANSPORT))
+                        _driver->seekTransport(utick + 2 * cs->utime2utick(qreal((_driver->bufferSize()) + 1) / qreal(MScore::sampleRate)));
+                  }
+            else
+                  cs->tempomap()->setRelTempo(relTempo);
+            cs->repeatList()->update();
+            prevTempo = curTempo();
+            emit tempoChanged();
+            }
+      int utick;
+      if (toSeq.takeSeek(&utick))
+            setPos(utick);
+
       for (;;) {
             if (toSeq.empty())
                   break;
             SeqMsg msg = toSeq.dequeue();
             switch(msg.id) {
-                  case SeqMsgId::TEMPO_CHANGE:
-                        {
-                        if (!cs)
-                              continue;
-                        if (playFrame != 0) {
-                              int utick = cs->utime2utick(qreal(playFrame) / qreal(MScore::sampleRate));
-                              cs->tempomap()->setRelTempo(msg.realVal);
-                              playFrame = cs->utick2utime(utick) * MScore::sampleRate;
-                              if (preferences.getBool(PREF_IO_JACK_TIMEBASEMASTER) && preferences.getBool(PREF_IO_JACK_USEJACKTRANSPORT))
-                                    _driver->seekTransport(utick + 2 * cs->utime2utick(qreal((_driver->bufferSize()) + 1) / qreal(MScore::sampleRate)));
-                              }
-                        else
-                              cs->tempomap()->setRelTempo(msg.realVal);
-                        cs->repeatList()->update();
-                        prevTempo = curTempo();
-                        emit tempoChanged();
-                        }
-                        break;
                   case SeqMsgId::PLAY:
                         putEvent(msg.event);
                         break;
-                  case SeqMsgId::SEEK:
-                        setPos(msg.intVal);
-                        break;
                   default:
                         break;
                   }
             }
+      // wake up the gui thread only if it waits for room, see guiToSeq()
+      if (toSeqWaiting.exchange(false, std::memory_order_acq_rel))
+            toSeqDrained.release();
       }
 
 //---------------------------------------------------------
@@ -747,6 +753,7 @@ void Seq::process(unsigned framesPerPeriod, float* buffer)
       memset(buffer, 0, sizeof(float) * framesPerPeriod * 2); // assume two channels
       float* p = buffer;
 
+      _synti->setPlaying(state == Transport::PLAY);
       processMessages();
 
       if (state == Transport::PLAY) {
@@ -888,7 +895,9 @@ void Seq::process(unsigned framesPerPeriod, float* buffer)
                               }
                         }
                   }
-            if (*pPlayPos == pEvents->cend()) {
+            // running out of events before the whole playlist is rendered
+            // means the gui thread has not caught up yet, keep playing
+            if (*pPlayPos == pEvents->cend() && (inCountIn || allRendered)) {
                   if (inCountIn) {
                         inCountIn = false;
                         // Connecting to JACK Transport if MuseScore was temporarily disconnected from it
@@ -999,6 +1008,9 @@ void Seq::initInstruments(bool realTime)
 
 //---------------------------------------------------------
 //   collectEvents
+//    split the playlist into chunks and render the chunks
+//    at the play position; the remaining chunks are
+//    rendered by renderChunks() while playing
 //---------------------------------------------------------
 
 void Seq::collectEvents()
@@ -1009,18 +1021,150 @@ void Seq::collectEvents()
       mutex.lock();
       events.clear();
 
-      cs->renderMidi(&events);
-      endUTick = 0;
-
-      if (!events.empty()) {
-            auto e = events.cend();
-            --e;
-            endUTick = e->first;
-            }
       playPos  = events.cbegin();
+      guiPos   = events.cbegin();
+
+      cs->prepareMidi(MScore::playRepeats);
+      midiChunks = cs->midiChunks(MIDI_CHUNK_MEASURES);
+      renderedChunks.assign(midiChunks.size(), false);
+      chunkEvents.assign(midiChunks.size(), std::vector<EventMap::const_iterator>());
+      keptEvents.clear();
+      keptRange   = std::make_pair(0, 0);
+      allRendered = midiChunks.empty();
+      endUTick    = midiChunks.empty() ? 0 : midiChunks.back().utick2();
+      controllerEvents.clear();
+      cs->renderMidiControllers(&controllerEvents);
       mutex.unlock();
 
       playlistChanged = false;
+      renderChunks(cs->repeatList()->tick2utick(cs->playPos()));
+      }
+
+//---------------------------------------------------------
+//   renderChunks
+//    make sure the chunk containing utick and the
+//    MIDI_CHUNKS_AHEAD following chunks are in events
+//---------------------------------------------------------
+
+void Seq::renderChunks(int utick)
+      {
+      if (playlistChanged && state == Transport::PLAY)
+            updateChunks();
+      if (allRendered)
+            return;
+      size_t idx = 0;
+      while (idx + 1 < midiChunks.size() && midiChunks[idx + 1].utick1() <= utick)
+            ++idx;
+      size_t last = qMin(idx + MIDI_CHUNKS_AHEAD, midiChunks.size() - 1);
+      for (size_t i = idx; i <= last; ++i) {
+            if (renderedChunks[i])
+                  continue;
+            EventMap ce;
+            cs->renderMidiChunk(&ce, midiChunks[i], true);
+
+            // inserting into the multimap keeps the iterators of the
+            // realtime thread valid; only an iterator at the end has
+            // to be moved to the first new event after it
+            mutex.lock();
+            bool playPosAtEnd = playPos == events.cend();
+            bool guiPosAtEnd  = guiPos == events.cend();
+            std::vector<EventMap::const_iterator>& il = chunkEvents[i];
+            il.clear();
+            il.reserve(ce.size());
+            for (const auto& e : ce) {
+                  // the events kept from before the last edit are still there
+                  if (e.first >= keptRange.first && e.first < keptRange.second)
+                        continue;
+                  il.push_back(events.insert(e));
+                  }
+            if (playPosAtEnd || guiPosAtEnd) {
+                  auto pos = events.lower_bound(state == Transport::PLAY ? getCurTick() : 0);
+                  if (playPosAtEnd)
+                        playPos = pos;
+                  if (guiPosAtEnd)
+                        guiPos = pos;
+                  }
+            mutex.unlock();
+            renderedChunks[i] = true;
+            }
+      allRendered = std::find(renderedChunks.begin(), renderedChunks.end(), false) == renderedChunks.end();
+      }
+
+//---------------------------------------------------------
+//   updateChunks
+//    the score was edited while playing: split the new
+//    playlist into chunks and drop the events of all
+//    chunks except the one being played, whose notes may
+//    be sounding. The dropped chunks are rendered again
+//    when renderChunks() reaches them, the edited measures
+//    included
+//---------------------------------------------------------
+
+void Seq::updateChunks()
+      {
+      playlistChanged = false;
+      cs->prepareMidi(MScore::playRepeats);
+      std::vector<MidiChunk> chunks = cs->midiChunks(MIDI_CHUNK_MEASURES);
+      EventMap controllers;
+      cs->renderMidiControllers(&controllers);
+
+      mutex.lock();
+      allRendered = false;
+      int utick = playPos == events.cend() ? getCurTick() : playPos->first;
+      int guiUTick = guiPos == events.cend() ? -1 : guiPos->first;
+
+      // the groups of events: the rendered chunks and the events kept
+      // at the last edit
+      std::vector<std::pair<std::pair<int, int>, std::vector<EventMap::const_iterator>*>> groups;
+      for (size_t i = 0; i < midiChunks.size(); ++i) {
+            if (renderedChunks[i])
+                  groups.push_back(std::make_pair(std::make_pair(midiChunks[i].utick1(), midiChunks[i].utick2()), &chunkEvents[i]));
+            }
+      groups.push_back(std::make_pair(keptRange, &keptEvents));
+
+      std::vector<EventMap::const_iterator> kept;
+      std::pair<int, int> range(0, 0);
+      for (auto& g : groups) {
+            const std::pair<int, int>& r = g.first;
+            std::vector<EventMap::const_iterator>& il = *g.second;
+            bool current = r.first <= utick && utick < r.second;
+            if (!current) {
+                  // an event at the play position must stay valid
+                  for (const EventMap::const_iterator& i : il) {
+                        if (i == playPos) {
+                              current = true;
+                              break;
+                              }
+                        }
+                  }
+            if (current) {
+                  kept.insert(kept.end(), il.begin(), il.end());
+                  range = range.first == range.second ? r : std::make_pair(qMin(range.first, r.first), qMax(range.second, r.second));
+                  continue;
+                  }
+            for (const EventMap::const_iterator& i : il) {
+                  // notes started before the play position need their note off
+                  const NPlayEvent& e = i->second;
+                  bool noteOff = e.type() == ME_NOTEOFF || (e.type() == ME_NOTEON && e.velo() == 0);
+                  if (noteOff && i->first > utick && r.second <= utick)
+                        continue;
+                  events.erase(i);
+                  }
+            }
+      keptEvents.swap(kept);
+      keptRange = range;
+
+      midiChunks = chunks;
+      renderedChunks.assign(midiChunks.size(), false);
+      chunkEvents.assign(midiChunks.size(), std::vector<EventMap::const_iterator>());
+      for (size_t i = 0; i < midiChunks.size(); ++i)
+            renderedChunks[i] = midiChunks[i].utick1() >= keptRange.first && midiChunks[i].utick2() <= keptRange.second;
+      allRendered = std::find(renderedChunks.begin(), renderedChunks.end(), false) == renderedChunks.end();
+      endUTick    = midiChunks.empty() ? 0 : midiChunks.back().utick2();
+      controllerEvents.swap(controllers);
+      if (guiUTick >= 0)
+            guiPos = events.lower_bound(guiUTick);
+      mutex.unlock();
       }
 
 //---------------------------------------------------------
@@ -1082,6 +1226,7 @@ void Seq::seekCommon(int utick)
 
       if (playlistChanged)
             collectEvents();
+      renderChunks(utick);
 
       if (cs->playMode() == PlayMode::AUDIO) {
             ogg_int64_t sp = cs->utick2utime(utick) * MScore::sampleRate;
@@ -1343,7 +1488,22 @@ void Seq::guiToSeq(const SeqMsg& msg)
       {
       if (!_driver || !running)
             return;
-      toSeq.enqueue(msg);
+      // seek and tempo changes never overflow; other messages sleep
+      // until the audio thread has emptied the fifo, see processMessages(),
+      // unless they can be dropped
+      QElapsedTimer t;
+      t.start();
+      while (!toSeq.enqueue(msg)) {
+            int timeout = GUI_TO_SEQ_TIMEOUT - int(t.elapsed());
+            if (SeqMsgFifo::droppable(msg) || timeout <= 0) {
+                  qDebug("Seq::guiToSeq: fifo overflow, message %d dropped (%d rejected writes so far)", int(msg.id), toSeq.overflowCount());
+                  break;
+                  }
+            // if the fifo was emptied after the failed write, the
+            // next period of the audio thread wakes us up
+            toSeqWaiting.store(true, std::memory_order_release);
+            toSeqDrained.tryAcquire(1, timeout);
+            }
       }
 
 //---------------------------------------------------------
@@ -1352,7 +1512,9 @@ void Seq::guiToSeq(const SeqMsg& msg)
 
 void Seq::eventToGui(NPlayEvent e)
       {
-      fromSeq.enqueue(SeqMsg(SeqMsgId::MIDI_INPUT_EVENT, e));
+      // realtime thread: the drop is reported by heartBeatTimeout()
+      if (!fromSeq.enqueue(SeqMsg(SeqMsgId::MIDI_INPUT_EVENT, e)))
+            midiInputDropped.fetch_add(1, std::memory_order_relaxed);
       }
 
 //---------------------------------------------------------
@@ -1365,53 +1527,6 @@ void Seq::midiInputReady()
             _driver->midiRead();
       }
 
-//---------------------------------------------------------
-//   SeqMsgFifo
-//---------------------------------------------------------
-
-SeqMsgFifo::SeqMsgFifo()
-      {
-      maxCount = SEQ_MSG_FIFO_SIZE;
-      clear();
-      }
-
-//---------------------------------------------------------
-//   enqueue
-//---------------------------------------------------------
-
-void SeqMsgFifo::enqueue(const SeqMsg& msg)
-      {
-      int i = 0;
-      int n = 50;
-
-      QMutex mutex;
-      QWaitCondition qwc;
-      mutex.lock();
-      for (; i < n; ++i) {
-            if (!isFull())
-                  break;
-            qwc.wait(&mutex,100);
-            }
-      mutex.unlock();
-      if (i == n) {
-            qDebug("===SeqMsgFifo: overflow");
-            return;
-            }
-      messages[widx] = msg;
-      push();
-      }
-
-//---------------------------------------------------------
-//   dequeue
-//---------------------------------------------------------
-
-SeqMsg SeqMsgFifo::dequeue()
-      {
-      SeqMsg msg = messages[ridx];
-      pop();
-      return msg;
-      }
-
 //---------------------------------------------------------
 //   putEvent
 //---------------------------------------------------------
@@ -1451,6 +1566,9 @@ void Seq::heartBeatTimeout()
             sc->setMeter(meterValue[0], meterValue[1], meterPeakValue[0], meterPeakValue[1]);
             }
 
+      int dropped = midiInputDropped.exchange(0, std::memory_order_relaxed);
+      if (dropped)
+            qDebug("Seq::eventToGui: fifo overflow, %d MIDI input events dropped (%d rejected writes so far)", dropped, fromSeq.overflowCount());
       while (!fromSeq.empty()) {
             SeqMsg msg = fromSeq.dequeue();
             if (msg.id == SeqMsgId::MIDI_INPUT_EVENT) {
@@ -1467,6 +1585,8 @@ void Seq::heartBeatTimeout()
       if (state != Transport::PLAY || inCountIn)
             return;
 
+      renderChunks(getCurTick());
+
       int endFrame = playFrame;
 
       mutex.lock();
@@ -1551,11 +1671,11 @@ void Seq::updateSynthesizerState(int tick1, int tick2)
       {
       if (tick1 > tick2)
             tick1 = 0;
-      // Making a local copy of events to avoid touching it
-      // from different threads at the same time
-      EventMap ev = events;
-      EventMap::const_iterator i1 = ev.lower_bound(tick1);
-      EventMap::const_iterator i2 = ev.upper_bound(tick2);
+      // controllerEvents holds the controllers of the chunks which
+      // are not rendered yet as well; it is changed by the gui
+      // thread only while the caller holds the mutex
+      EventMap::const_iterator i1 = controllerEvents.lower_bound(tick1);
+      EventMap::const_iterator i2 = controllerEvents.upper_bound(tick2);
 
       for (; i1 != i2; ++i1) {
             if (i1->second.type() == ME_CONTROLLER)
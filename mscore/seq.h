@@ -26,6 +26,7 @@
 #include "driver.h"
 #include "libmscore/fifo.h"
 #include "libmscore/tempo.h"
+#include "libmscore/repeatlist.h"
 
 class QTimer;
 
@@ -73,20 +74,112 @@ struct SeqMsg {
 
 //---------------------------------------------------------
 //   SeqMsgFifo
+//    Seek and tempo changes are not queued: only the
+//    latest of each is kept in a slot, so they are never
+//    lost to a full fifo and never pile up.
 //---------------------------------------------------------
 
 static const int SEQ_MSG_FIFO_SIZE = 1024*8;
 
 class SeqMsgFifo : public FifoBase {
       SeqMsg messages[SEQ_MSG_FIFO_SIZE];
+      std::atomic<bool> seekPending;
+      std::atomic<int> seekTick;
+      std::atomic<bool> tempoPending;
+      std::atomic<qreal> tempo;
 
    public:
-      SeqMsgFifo();
+      SeqMsgFifo() {
+            maxCount = SEQ_MSG_FIFO_SIZE;
+            clear();
+            seekPending.store(false);
+            tempoPending.store(false);
+            }
       virtual ~SeqMsgFifo()     {}
-      void enqueue(const SeqMsg&);        // put object on fifo
+      bool enqueue(const SeqMsg&);        // put object on fifo, false on overflow
       SeqMsg dequeue();                   // remove object from fifo
+      bool takeSeek(int* tick);           // latest seek since the last call
+      bool takeTempo(qreal* relTempo);    // latest tempo change since the last call
+      static bool droppable(const SeqMsg&);
       };
 
+//---------------------------------------------------------
+//   enqueue
+//---------------------------------------------------------
+
+inline bool SeqMsgFifo::enqueue(const SeqMsg& msg)
+      {
+      switch (msg.id) {
+            case SeqMsgId::SEEK:
+                  seekTick.store(msg.intVal, std::memory_order_relaxed);
+                  seekPending.store(true, std::memory_order_release);
+                  return true;
+            case SeqMsgId::TEMPO_CHANGE:
+                  tempo.store(msg.realVal, std::memory_order_relaxed);
+                  tempoPending.store(true, std::memory_order_release);
+                  return true;
+            default:
+                  break;
+            }
+      if (isFull()) {
+            overflow();
+            return false;
+            }
+      messages[widx] = msg;
+      push();
+      return true;
+      }
+
+//---------------------------------------------------------
+//   dequeue
+//---------------------------------------------------------
+
+inline SeqMsg SeqMsgFifo::dequeue()
+      {
+      SeqMsg msg = messages[ridx];
+      pop();
+      return msg;
+      }
+
+//---------------------------------------------------------
+//   takeSeek
+//    a seek written while this runs is returned again by
+//    the next call
+//---------------------------------------------------------
+
+inline bool SeqMsgFifo::takeSeek(int* tick)
+      {
+      if (!seekPending.exchange(false, std::memory_order_acquire))
+            return false;
+      *tick = seekTick.load(std::memory_order_relaxed);
+      return true;
+      }
+
+//---------------------------------------------------------
+//   takeTempo
+//---------------------------------------------------------
+
+inline bool SeqMsgFifo::takeTempo(qreal* relTempo)
+      {
+      if (!tempoPending.exchange(false, std::memory_order_acquire))
+            return false;
+      *relTempo = tempo.load(std::memory_order_relaxed);
+      return true;
+      }
+
+//---------------------------------------------------------
+//   droppable
+//    a note on can be dropped from a full fifo, it only
+//    silences a preview note; losing a note off, controller
+//    or program change would leave the synthesizer in a
+//    wrong state
+//---------------------------------------------------------
+
+inline bool SeqMsgFifo::droppable(const SeqMsg& msg)
+      {
+      return msg.id == SeqMsgId::PLAY && msg.event.type() == ME_NOTEON && msg.event.velo() > 0;
+      }
+
 // this are also the jack audio transport states:
 enum class Transport : char {
       STOP=0,
@@ -125,6 +218,9 @@ class Seq : public QObject, public Sequencer {
 
       SeqMsgFifo toSeq;
       SeqMsgFifo fromSeq;
+      std::atomic<bool> toSeqWaiting { false }; // gui thread waits for room in toSeq
+      QSemaphore toSeqDrained;                  // released by the sequencer after it emptied toSeq
+      std::atomic<int> midiInputDropped { 0 };  // MIDI input lost to a full fromSeq, not yet reported
       Driver* _driver;
       MasterSynthesizer* _synti;
 
@@ -138,7 +234,15 @@ class Seq : public QObject, public Sequencer {
 
       int playFrame;                      // current play position in samples, relative to the first frame of playback
       int countInPlayFrame;               // current play position in samples, relative to the first frame of countin
-      int endUTick;                       // the final tick of midi events collected by collectEvents()
+      int endUTick;                       // the end tick of the playlist collected by collectEvents()
+
+      std::vector<MidiChunk> midiChunks;  // playlist split into chunks, rendered on demand
+      std::vector<bool> renderedChunks;   // chunks already merged into events
+      std::vector<std::vector<EventMap::const_iterator>> chunkEvents;   // the events merged for each chunk
+      std::vector<EventMap::const_iterator> keptEvents;     // events of the chunk which played while the score was edited
+      std::pair<int, int> keptRange;      // utick range of keptEvents, not rendered again
+      std::atomic<bool> allRendered;      // events hold the complete playlist
+      EventMap controllerEvents;          // controllers of the whole playlist, replayed on seek
 
       EventMap::const_iterator playPos;   // moved in real time thread
       EventMap::const_iterator countInPlayPos;
@@ -167,6 +271,8 @@ class Seq : public QObject, public Sequencer {
       void unmarkNotes();
       void updateSynthesizerState(int tick1, int tick2);
       void addCountInClicks();
+      void renderChunks(int utick);
+      void updateChunks();
 
       inline QQueue<NPlayEvent>* liveEventQueue() { return &_liveEventQueue; }
 
@@ -0,0 +1,288 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2
+//  as published by the Free Software Foundation and appearing in
+//  the file LICENCE.GPL
+//=============================================================================
+
+#include "tilecache.h"
+#include "libmscore/page.h"
+
+namespace Ms {
+
+QCache<TileKey, QImage> TileCache::_tiles { TileCache::CACHE_KB };
+QHash<const Page*, int> TileCache::_versions;
+
+//---------------------------------------------------------
+//   TileCache
+//---------------------------------------------------------
+
+TileCache::TileCache(PaintFunction paint, UpdateFunction update)
+   : _paint(paint), _update(update)
+      {
+      _timer.setSingleShot(true);
+      _timer.setInterval(0);
+      QObject::connect(&_timer, &QTimer::timeout, [this]() { renderQueued(); });
+      }
+
+//---------------------------------------------------------
+//   tileRect
+//    area of the page covered by tile k
+//---------------------------------------------------------
+
+QRectF TileCache::tileRect(const TileKey& k) const
+      {
+      qreal size = TILE_SIZE / k.scale;
+      return QRectF(k.x * size, k.y * size, size, size);
+      }
+
+//---------------------------------------------------------
+//   tile
+//    return the cached tile or null
+//---------------------------------------------------------
+
+QImage* TileCache::tile(const TileKey& k)
+      {
+      return _tiles.object(k);
+      }
+
+//---------------------------------------------------------
+//   render
+//    rasterize tile k and put it into the cache
+//---------------------------------------------------------
+
+QImage* TileCache::render(const TileKey& k)
+      {
+      QImage* image = new QImage(TILE_SIZE, TILE_SIZE, QImage::Format_ARGB32_Premultiplied);
+      image->fill(0);
+
+      QRectF r(tileRect(k));
+      QPainter p(image);
+      p.setRenderHint(QPainter::Antialiasing, _antialias);
+      p.setRenderHint(QPainter::TextAntialiasing, true);
+      p.scale(k.scale, k.scale);
+      p.translate(-r.topLeft());
+      _paint(p, const_cast<Page*>(k.page), r);
+      p.end();
+
+      _tiles.insert(k, image, TILE_SIZE * TILE_SIZE * 4 / 1024);
+      return image;
+      }
+
+//---------------------------------------------------------
+//   paintStandIn
+//    paint the area of tile k with the tiles of another
+//    scale, return false if no scale has all of them
+//---------------------------------------------------------
+
+bool TileCache::paintStandIn(QPainter& p, const TileKey& k)
+      {
+      QRectF r(tileRect(k));
+      for (qreal scale : _scales) {
+            if (scale == k.scale)
+                  continue;
+            int x1 = int(floor(r.left() * scale / TILE_SIZE));
+            int x2 = int(ceil(r.right() * scale / TILE_SIZE));
+            int y1 = int(floor(r.top() * scale / TILE_SIZE));
+            int y2 = int(ceil(r.bottom() * scale / TILE_SIZE));
+            QList<TileKey> keys;
+            for (int y = y1; y < y2; ++y) {
+                  for (int x = x1; x < x2; ++x) {
+                        TileKey sk { k.page, scale, x, y };
+                        if (!_tiles.contains(sk))
+                              break;
+                        keys.append(sk);
+                        }
+                  }
+            if (keys.size() != (x2 - x1) * (y2 - y1))
+                  continue;
+            p.save();
+            p.setClipRect(r, Qt::IntersectClip);
+            p.setRenderHint(QPainter::SmoothPixmapTransform, true);
+            for (const TileKey& sk : keys)
+                  p.drawImage(tileRect(sk), *_tiles.object(sk));
+            p.restore();
+            return true;
+            }
+      return false;
+      }
+
+//---------------------------------------------------------
+//   paint
+//    paint the part r (page coordinates) of page; the painter
+//    maps page coordinates to the view
+//---------------------------------------------------------
+
+void TileCache::paint(QPainter& p, Page* page, const QRectF& r)
+      {
+      if (r.isEmpty())
+            return;
+      checkVersion(page);
+      const QTransform& dt = p.deviceTransform();
+      qreal scale = dt.m11();
+      qreal dpr   = p.device()->devicePixelRatioF();
+
+      _scales.removeOne(scale);
+      _scales.prepend(scale);
+      while (_scales.size() > MAX_SCALES)
+            _scales.removeLast();
+      // tiles queued for another scale are of no use anymore
+      if (!_queue.empty() && _queue.front().scale != scale)
+            _queue.clear();
+
+      // tiles of the current scale are placed at whole device pixels
+      QPointF origin = dt.map(QPointF());
+      QPoint o(qRound(origin.x()), qRound(origin.y()));
+
+      int x1 = int(floor(r.left() * scale / TILE_SIZE));
+      int x2 = int(ceil(r.right() * scale / TILE_SIZE));
+      int y1 = int(floor(r.top() * scale / TILE_SIZE));
+      int y2 = int(ceil(r.bottom() * scale / TILE_SIZE));
+      for (int y = y1; y < y2; ++y) {
+            for (int x = x1; x < x2; ++x) {
+                  TileKey k { page, scale, x, y };
+                  QImage* image = tile(k);
+                  if (!image) {
+                        if (paintStandIn(p, k)) {
+                              if (!_queue.contains(k))
+                                    _queue.append(k);
+                              continue;
+                              }
+                        image = render(k);
+                        }
+                  QPointF pos(o.x() + x * TILE_SIZE, o.y() + y * TILE_SIZE);
+                  p.save();
+                  p.resetTransform();
+                  image->setDevicePixelRatio(dpr);
+                  p.drawImage(pos / dpr, *image);
+                  p.restore();
+                  }
+            }
+      if (!_queue.empty() && !_timer.isActive())
+            _timer.start();
+      }
+
+//---------------------------------------------------------
+//   renderQueued
+//    render queued tiles for IDLE_MS, then let the events in
+//---------------------------------------------------------
+
+void TileCache::renderQueued()
+      {
+      QElapsedTimer t;
+      t.start();
+      while (!_queue.empty() && t.elapsed() < IDLE_MS) {
+            TileKey k = _queue.takeFirst();
+            if (_tiles.contains(k))
+                  continue;
+            render(k);
+            _update(const_cast<Page*>(k.page), tileRect(k));
+            }
+      if (!_queue.empty())
+            _timer.start();
+      }
+
+//---------------------------------------------------------
+//   flush
+//    render all queued tiles now
+//---------------------------------------------------------
+
+void TileCache::flush()
+      {
+      _timer.stop();
+      while (!_queue.empty()) {
+            TileKey k = _queue.takeFirst();
+            if (!_tiles.contains(k))
+                  render(k);
+            }
+      }
+
+//---------------------------------------------------------
+//   clear
+//    drop all tiles of all views, called when the scores
+//    may have changed anywhere
+//---------------------------------------------------------
+
+void TileCache::clear()
+      {
+      _tiles.clear();
+      _versions.clear();
+      cancel();
+      }
+
+//---------------------------------------------------------
+//   cancel
+//    forget the tiles queued by this view
+//---------------------------------------------------------
+
+void TileCache::cancel()
+      {
+      _queue.clear();
+      _timer.stop();
+      }
+
+//---------------------------------------------------------
+//   checkVersion
+//    drop the tiles of page if it was laid out again since
+//    they were rendered
+//---------------------------------------------------------
+
+void TileCache::checkVersion(const Page* page)
+      {
+      auto i = _versions.find(page);
+      if (i == _versions.end())
+            _versions.insert(page, page->layoutVersion());
+      else if (i.value() != page->layoutVersion()) {
+            drop(page, QRectF());
+            i.value() = page->layoutVersion();
+            }
+      }
+
+//---------------------------------------------------------
+//   drop
+//    drop the tiles of page which intersect r, or all of
+//    them for a null r
+//---------------------------------------------------------
+
+void TileCache::drop(const Page* page, const QRectF& r)
+      {
+      for (const TileKey& k : _tiles.keys()) {
+            if (k.page == page && (r.isNull() || tileRect(k).intersects(r)))
+                  _tiles.remove(k);
+            }
+      for (auto i = _queue.begin(); i != _queue.end();) {
+            if (i->page == page && (r.isNull() || tileRect(*i).intersects(r)))
+                  i = _queue.erase(i);
+            else
+                  ++i;
+            }
+      }
+
+//---------------------------------------------------------
+//   invalidate
+//    drop the tiles of page which intersect r (page
+//    coordinates)
+//---------------------------------------------------------
+
+void TileCache::invalidate(const Page* page, const QRectF& r)
+      {
+      if (!r.isNull())
+            drop(page, r);
+      }
+
+//---------------------------------------------------------
+//   setAntialias
+//---------------------------------------------------------
+
+void TileCache::setAntialias(bool val)
+      {
+      if (val != _antialias) {
+            clear();
+            _antialias = val;
+            }
+      }
+
+}     // namespace Ms
@@ -0,0 +1,100 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2
+//  as published by the Free Software Foundation and appearing in
+//  the file LICENCE.GPL
+//=============================================================================
+
+#ifndef __TILECACHE_H__
+#define __TILECACHE_H__
+
+namespace Ms {
+
+class Page;
+
+//---------------------------------------------------------
+//   TileKey
+//---------------------------------------------------------
+
+struct TileKey {
+      const Page* page;
+      qreal scale;            // device pixels per page unit the tile is rendered at
+      int x;                  // column and row of the tile at this scale
+      int y;
+
+      bool operator==(const TileKey& k) const {
+            return page == k.page && scale == k.scale && x == k.x && y == k.y;
+            }
+      };
+
+inline uint qHash(const TileKey& k)
+      {
+      uint h = ::qHash(quintptr(k.page));
+      h = h * 31 + ::qHash(k.scale);
+      h = h * 31 + uint(k.x);
+      return h * 31 + uint(k.y);
+      }
+
+//---------------------------------------------------------
+//   TileCache
+//    Pages rasterized into square tiles of TILE_SIZE device
+//    pixels, kept for the scales the view was recently
+//    painted at.
+//    paint() composites the tiles of the current scale.
+//    Missing tiles are covered by scaled tiles of another
+//    scale and rendered between events; a tile with no such
+//    stand-in is rendered at once.
+//    The tiles are shared by all views within one memory
+//    budget. The tiles of a page are dropped when it is
+//    painted next after it was laid out again.
+//---------------------------------------------------------
+
+class TileCache {
+   public:
+      // draw the elements of page which intersect the rect (page coordinates)
+      typedef std::function<void(QPainter&, Page*, const QRectF&)> PaintFunction;
+      // the part of page in the rect (page coordinates) has a new tile
+      typedef std::function<void(Page*, const QRectF&)> UpdateFunction;
+
+      static const int TILE_SIZE   = 256;
+      static const int CACHE_KB    = 192 * 1024;
+      static const int MAX_SCALES  = 4;         // scales searched for stand-ins
+      static const int IDLE_MS     = 8;         // time to render tiles in one go
+
+   private:
+      static QCache<TileKey, QImage> _tiles;          // cost in KB
+      static QHash<const Page*, int> _versions;       // layout version of the pages in _tiles
+      QList<qreal> _scales;                           // recently painted scales, latest first
+      QList<TileKey> _queue;                          // tiles of the latest scale to render
+      QTimer _timer;
+      PaintFunction _paint;
+      UpdateFunction _update;
+      bool _antialias { true };
+
+      QRectF tileRect(const TileKey&) const;
+      QImage* tile(const TileKey&);
+      QImage* render(const TileKey&);
+      bool paintStandIn(QPainter&, const TileKey&);
+      void renderQueued();
+      void checkVersion(const Page*);
+      void drop(const Page*, const QRectF&);
+
+   public:
+      TileCache(PaintFunction paint, UpdateFunction update);
+
+      void paint(QPainter&, Page*, const QRectF&);
+      void clear();
+      void cancel();
+      void invalidate(const Page*, const QRectF&);
+      void setAntialias(bool val);
+
+      static int tiles()   { return _tiles.count(); }
+      int queued() const   { return _queue.size();  }
+      void flush();
+      };
+
+}     // namespace Ms
+#endif
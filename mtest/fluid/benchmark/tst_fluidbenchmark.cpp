@@ -0,0 +1,97 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2
+//  as published by the Free Software Foundation and appearing in
+//  the file LICENCE.GPL
+//=============================================================================
+
+#include <QtTest/QtTest>
+
+#include "mtest/testutils.h"
+#include "mtest/fluid/sinefont.h"
+#include "fluid/fluid.h"
+#include "synthesizer/event.h"
+
+using namespace Ms;
+
+static const int PERIOD   = 256;        // frames
+static const int CHANNELS = 16;
+
+//---------------------------------------------------------
+//   TestFluidBenchmark
+//    time to render one period with a number of voices
+//---------------------------------------------------------
+
+class TestFluidBenchmark : public QObject, public MTest
+      {
+      Q_OBJECT
+      QTemporaryDir dir;
+
+   private slots:
+      void initTestCase();
+      void voices_data();
+      void voices();
+      };
+
+//---------------------------------------------------------
+//   initTestCase
+//---------------------------------------------------------
+
+void TestFluidBenchmark::initTestCase()
+      {
+      initMTest();
+      QVERIFY(dir.isValid());
+      QVERIFY(SineFont().write(dir.path() + "/sine.sf2"));
+      }
+
+//---------------------------------------------------------
+//   voices
+//---------------------------------------------------------
+
+void TestFluidBenchmark::voices_data()
+      {
+      QTest::addColumn<int>("voices");
+      QTest::addColumn<int>("interpolation");
+      QTest::newRow("1 voice")             << 1   << int(FluidS::FLUID_INTERP_4THORDER);
+      QTest::newRow("16 voices")           << 16  << int(FluidS::FLUID_INTERP_4THORDER);
+      QTest::newRow("64 voices")           << 64  << int(FluidS::FLUID_INTERP_4THORDER);
+      QTest::newRow("256 voices")          << 256 << int(FluidS::FLUID_INTERP_4THORDER);
+      QTest::newRow("256 voices, linear")  << 256 << int(FluidS::FLUID_INTERP_LINEAR);
+      QTest::newRow("256 voices, 7th")     << 256 << int(FluidS::FLUID_INTERP_7THORDER);
+      }
+
+void TestFluidBenchmark::voices()
+      {
+      QFETCH(int, voices);
+      QFETCH(int, interpolation);
+
+      FluidS::Fluid fluid;
+      fluid.init(44100);
+      QVERIFY(fluid.addSoundFont(dir.path() + "/sine.sf2"));
+      for (int ch = 0; ch < CHANNELS; ++ch)
+            fluid.play(PlayEvent(ME_CONTROLLER, ch, CTRL_PROGRAM, 0));
+      fluid.set_interp_method(-1, interpolation);
+      // the sample loops, so the notes sound until the end
+      for (int i = 0; i < voices; ++i)
+            fluid.play(PlayEvent(ME_NOTEON, i % CHANNELS, 24 + i / CHANNELS, 100));
+
+      float out[PERIOD * 2];
+      float effect1[PERIOD * 2];
+      float effect2[PERIOD * 2];
+      QBENCHMARK {
+            memset(out, 0, sizeof(out));
+            memset(effect1, 0, sizeof(effect1));
+            memset(effect2, 0, sizeof(effect2));
+            fluid.process(PERIOD, out, effect1, effect2);
+            }
+      float peak = 0.0;
+      for (float v : out)
+            peak = qMax(peak, qAbs(v));
+      QVERIFY(peak > 0.0);
+      }
+
+QTEST_MAIN(TestFluidBenchmark)
+#include "tst_fluidbenchmark.moc"
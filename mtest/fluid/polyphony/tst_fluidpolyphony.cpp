@@ -0,0 +1,129 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2
+//  as published by the Free Software Foundation and appearing in
+//  the file LICENCE.GPL
+//=============================================================================
+
+#include <QtTest/QtTest>
+
+#include "mtest/testutils.h"
+#include "mtest/fluid/sinefont.h"
+#include "fluid/fluid.h"
+#include "synthesizer/event.h"
+
+using namespace Ms;
+
+//---------------------------------------------------------
+//   counted allocations
+//    operator new counts while counting is set
+//---------------------------------------------------------
+
+static std::atomic<bool> counting { false };
+static std::atomic<int> allocations { 0 };
+
+void* operator new(std::size_t size)
+      {
+      if (counting.load(std::memory_order_relaxed))
+            ++allocations;
+      void* p = malloc(size ? size : 1);
+      if (!p)
+            throw std::bad_alloc();
+      return p;
+      }
+
+void* operator new[](std::size_t size)
+      {
+      return operator new(size);
+      }
+
+void operator delete(void* p) noexcept
+      {
+      free(p);
+      }
+
+void operator delete[](void* p) noexcept
+      {
+      free(p);
+      }
+
+static const int PERIOD   = 256;        // frames
+static const int CHANNELS = 16;
+
+//---------------------------------------------------------
+//   TestFluidPolyphony
+//---------------------------------------------------------
+
+class TestFluidPolyphony : public QObject, public MTest
+      {
+      Q_OBJECT
+      QTemporaryDir dir;
+
+   private slots:
+      void initTestCase();
+      void noAllocations();
+      };
+
+//---------------------------------------------------------
+//   initTestCase
+//---------------------------------------------------------
+
+void TestFluidPolyphony::initTestCase()
+      {
+      initMTest();
+      QVERIFY(dir.isValid());
+      QVERIFY(SineFont().write(dir.path() + "/sine.sf2"));
+      }
+
+//---------------------------------------------------------
+//   noAllocations
+//    playing more notes than there are voices, with notes
+//    ending, starting and stolen in every period, does not
+//    allocate once the channels have their presets
+//---------------------------------------------------------
+
+void TestFluidPolyphony::noAllocations()
+      {
+      FluidS::Fluid fluid;
+      fluid.init(44100);
+      QVERIFY(fluid.addSoundFont(dir.path() + "/sine.sf2"));
+      for (int ch = 0; ch < CHANNELS; ++ch)
+            fluid.play(PlayEvent(ME_CONTROLLER, ch, CTRL_PROGRAM, 0));
+      QVERIFY(fluid.get_channel_preset(0));
+
+      float out[PERIOD * 2];
+      float effect1[PERIOD * 2];
+      float effect2[PERIOD * 2];
+      float peak = 0.0;
+
+      counting = true;
+      for (int period = 0; period < 2000; ++period) {
+            for (int i = 0; i < 4; ++i) {
+                  int n   = period * 4 + i;
+                  int ch  = n % CHANNELS;
+                  int key = 24 + (n * 7) % 80;
+                  fluid.play(PlayEvent(ME_NOTEON, ch, key, 40 + n % 80));
+                  // a note lasts about 150 periods, so the voices run out
+                  if (n >= 600) {
+                        int m = n - 600;
+                        fluid.play(PlayEvent(ME_NOTEON, m % CHANNELS, 24 + (m * 7) % 80, 0));
+                        }
+                  }
+            memset(out, 0, sizeof(out));
+            memset(effect1, 0, sizeof(effect1));
+            memset(effect2, 0, sizeof(effect2));
+            fluid.process(PERIOD, out, effect1, effect2);
+            for (float v : out)
+                  peak = qMax(peak, qAbs(v));
+            }
+      counting = false;
+
+      QCOMPARE(allocations.load(), 0);
+      QVERIFY(peak > 0.0);
+      }
+
+QTEST_MAIN(TestFluidPolyphony)
+#include "tst_fluidpolyphony.moc"
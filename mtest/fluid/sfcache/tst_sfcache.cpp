@@ -0,0 +1,137 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2
+//  as published by the Free Software Foundation and appearing in
+//  the file LICENCE.GPL
+//=============================================================================
+
+#include <QtTest/QtTest>
+
+#include "mtest/testutils.h"
+#include "fluid/sfont.h"
+
+using namespace Ms;
+using namespace FluidS;
+
+static const unsigned OFFSET     = 4096;      // of the compressed sample in the font
+static const unsigned COMPRESSED = 1234;      // size of the compressed sample
+static const int FRAMES          = 500;
+
+//---------------------------------------------------------
+//   TestSfCache
+//    the cache of decoded SF3 samples
+//---------------------------------------------------------
+
+class TestSfCache : public QObject, public MTest
+      {
+      Q_OBJECT
+      QTemporaryDir dir;
+
+      void writeSample(SFont*);
+
+   private slots:
+      void initTestCase();
+      void hit();
+      void stale();
+      void truncated();
+      };
+
+//---------------------------------------------------------
+//   initTestCase
+//---------------------------------------------------------
+
+void TestSfCache::initTestCase()
+      {
+      initMTest();
+      QVERIFY(dir.isValid());
+      }
+
+//---------------------------------------------------------
+//   writeSample
+//    store a decoded sample of FRAMES frames at OFFSET
+//---------------------------------------------------------
+
+void TestSfCache::writeSample(SFont* sf)
+      {
+      Sample s(sf);
+      s.setValid(true);
+      s.data = new short[FRAMES];
+      for (int i = 0; i < FRAMES; ++i)
+            s.data[i] = short(i * 37);
+      s.setDecodedFrames(FRAMES);
+      s.writeCache(OFFSET, COMPRESSED);
+      }
+
+//---------------------------------------------------------
+//   hit
+//    a sample is read back as it was written
+//---------------------------------------------------------
+
+void TestSfCache::hit()
+      {
+      SFont sf(0);
+      sf.setCacheDir(dir.path() + "/hit");
+      writeSample(&sf);
+      QVERIFY(QFile::exists(dir.path() + "/hit/source"));
+
+      Sample s(&sf);
+      s.setValid(true);
+      QVERIFY(s.readCache(OFFSET, COMPRESSED));
+      QVERIFY(s.data);
+      QCOMPARE(int(s.end), FRAMES - 1);
+      QVERIFY(s.loopstart < s.loopend && s.loopend <= s.end);
+      for (int i = 0; i < FRAMES; ++i)
+            QCOMPARE(s.data[i], short(i * 37));
+
+      Sample other(&sf);
+      QVERIFY(!other.readCache(OFFSET + 1, COMPRESSED));
+      QVERIFY(!other.data);
+      }
+
+//---------------------------------------------------------
+//   stale
+//    an entry written for other compressed data is ignored
+//---------------------------------------------------------
+
+void TestSfCache::stale()
+      {
+      SFont sf(0);
+      sf.setCacheDir(dir.path() + "/stale");
+      writeSample(&sf);
+
+      Sample s(&sf);
+      s.setValid(true);
+      QVERIFY(!s.readCache(OFFSET, COMPRESSED + 1));
+      QVERIFY(!s.data);
+      }
+
+//---------------------------------------------------------
+//   truncated
+//    an entry shorter than its header says is ignored
+//---------------------------------------------------------
+
+void TestSfCache::truncated()
+      {
+      SFont sf(0);
+      sf.setCacheDir(dir.path() + "/truncated");
+      writeSample(&sf);
+
+      QString fn = QString("%1/truncated/%2.pcm").arg(dir.path()).arg(OFFSET);
+      QFile f(fn);
+      QVERIFY(f.resize(f.size() - 2));
+
+      Sample s(&sf);
+      s.setValid(true);
+      QVERIFY(!s.readCache(OFFSET, COMPRESSED));
+      QVERIFY(!s.data);
+
+      QVERIFY(f.resize(8));                     // not even a header
+      QVERIFY(!s.readCache(OFFSET, COMPRESSED));
+      QVERIFY(!s.data);
+      }
+
+QTEST_MAIN(TestSfCache)
+#include "tst_sfcache.moc"
@@ -0,0 +1,158 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2
+//  as published by the Free Software Foundation and appearing in
+//  the file LICENCE.GPL
+//=============================================================================
+
+#ifndef __SINEFONT_H__
+#define __SINEFONT_H__
+
+#include "fluid/sfont.h"
+
+//---------------------------------------------------------
+//   SineFont
+//    a SoundFont 2 file built in memory, with one preset
+//    (bank 0, program 0) which plays a looped sine on all
+//    keys, see data()
+//---------------------------------------------------------
+
+class SineFont {
+      QByteArray _data;
+
+      static void word(QByteArray& ba, quint16 val)
+            {
+            ba.append(char(val & 0xff));
+            ba.append(char(val >> 8));
+            }
+      static void dword(QByteArray& ba, quint32 val)
+            {
+            word(ba, val & 0xffff);
+            word(ba, val >> 16);
+            }
+      static void name(QByteArray& ba, const char* s)
+            {
+            QByteArray n(s);
+            n.resize(20);
+            ba.append(n);
+            }
+      static QByteArray chunk(const char* id, const QByteArray& data)
+            {
+            QByteArray ba(id, 4);
+            dword(ba, data.size());
+            ba.append(data);
+            if (data.size() & 1)
+                  ba.append('\0');
+            return ba;
+            }
+      static QByteArray list(const char* type, const QByteArray& data)
+            {
+            return chunk("LIST", QByteArray(type, 4) + data);
+            }
+
+   public:
+      SineFont(int frames = 4410, int sampleRate = 44100)
+            {
+            QByteArray ifil;
+            word(ifil, 2);
+            word(ifil, 1);
+            QByteArray info = chunk("ifil", ifil)
+               + chunk("isng", QByteArray("EMU8000", 8))
+               + chunk("INAM", QByteArray("Sine", 6));
+
+            // 441 Hz at 44100 Hz: the loop holds whole periods
+            QByteArray smpl;
+            for (int i = 0; i < frames; ++i)
+                  word(smpl, quint16(qint16(16000 * sin(2.0 * M_PI * i / 100.0))));
+            for (int i = 0; i < 46; ++i)        // the zeros the spec asks for after a sample
+                  word(smpl, 0);
+
+            QByteArray phdr;
+            name(phdr, "Sine");
+            word(phdr, 0);                      // preset
+            word(phdr, 0);                      // bank
+            word(phdr, 0);                      // first bag
+            dword(phdr, 0);
+            dword(phdr, 0);
+            dword(phdr, 0);
+            name(phdr, "EOP");
+            word(phdr, 0);
+            word(phdr, 0);
+            word(phdr, 1);
+            dword(phdr, 0);
+            dword(phdr, 0);
+            dword(phdr, 0);
+
+            QByteArray pbag;
+            word(pbag, 0);
+            word(pbag, 0);
+            word(pbag, 1);
+            word(pbag, 0);
+
+            QByteArray pgen;
+            word(pgen, FluidS::Gen_Instrument);
+            word(pgen, 0);
+            word(pgen, 0);
+            word(pgen, 0);
+
+            QByteArray inst;
+            name(inst, "Sine");
+            word(inst, 0);
+            name(inst, "EOI");
+            word(inst, 1);
+
+            QByteArray ibag;
+            word(ibag, 0);
+            word(ibag, 0);
+            word(ibag, 2);
+            word(ibag, 0);
+
+            QByteArray igen;
+            word(igen, FluidS::Gen_SampleModes);
+            word(igen, 1);                      // loop
+            word(igen, FluidS::Gen_SampleId);
+            word(igen, 0);
+            word(igen, 0);
+            word(igen, 0);
+
+            QByteArray shdr;
+            name(shdr, "Sine");
+            dword(shdr, 0);                     // start
+            dword(shdr, frames);                // end
+            dword(shdr, 100);                   // loop start
+            dword(shdr, 100 * (frames / 100 - 1));    // loop end
+            dword(shdr, sampleRate);
+            shdr.append(char(69));              // original pitch
+            shdr.append(char(0));               // pitch correction
+            word(shdr, 0);                      // sample link
+            word(shdr, FluidS::FLUID_SAMPLETYPE_MONO);
+            name(shdr, "EOS");
+            shdr.append(QByteArray(26, '\0'));
+
+            QByteArray mod(10, '\0');           // terminal modulator
+            QByteArray pdta = chunk("phdr", phdr) + chunk("pbag", pbag) + chunk("pmod", mod)
+               + chunk("pgen", pgen) + chunk("inst", inst) + chunk("ibag", ibag)
+               + chunk("imod", mod) + chunk("igen", igen) + chunk("shdr", shdr);
+
+            _data = chunk("RIFF", QByteArray("sfbk", 4) + list("INFO", info)
+               + list("sdta", chunk("smpl", smpl)) + list("pdta", pdta));
+            }
+
+      const QByteArray& data() const { return _data; }
+
+      //---------------------------------------------------------
+      //   write
+      //    the font is read from a file only
+      //---------------------------------------------------------
+
+      bool write(const QString& path) const
+            {
+            QFile f(path);
+            return f.open(QIODevice::WriteOnly) && f.write(_data) == _data.size();
+            }
+      };
+
+#endif
@@ -0,0 +1,106 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2
+//  as published by the Free Software Foundation and appearing in
+//  the file LICENCE.GPL
+//=============================================================================
+
+#include <QtTest/QtTest>
+#include "mtest/testutils.h"
+
+static const QString SCORE("libmscore/concertpitch/concertpitchbenchmark.mscx");
+
+using namespace Ms;
+
+//---------------------------------------------------------
+//   TestJobFile
+//---------------------------------------------------------
+
+class TestJobFile : public QObject, public MTest
+      {
+      Q_OBJECT
+
+      QStringList outputs(const QString& dir) const;
+
+   private slots:
+      void initTestCase();
+      void grouped();
+      };
+
+//---------------------------------------------------------
+//   initTestCase
+//---------------------------------------------------------
+
+void TestJobFile::initTestCase()
+      {
+      initMTest();
+      if (!QFileInfo(MSCORE_EXECUTABLE).exists())
+            qFatal("Cannot find executable: %s", MSCORE_EXECUTABLE);
+      }
+
+//---------------------------------------------------------
+//   outputs
+//    the files a conversion of SCORE writes to dir; the
+//    score is reused for all of them in a job file
+//---------------------------------------------------------
+
+QStringList TestJobFile::outputs(const QString& dir) const
+      {
+      QStringList files;
+      for (const char* suffix : { "mscx", "png", "mid", "svg", "mpos", "spos", "mscx" })
+            files.append(QString("%1/out%2.%3").arg(dir).arg(files.size()).arg(suffix));
+      return files;
+      }
+
+//---------------------------------------------------------
+//   grouped
+//    the entries of a job file converted from one score
+//    must be the same as converting every entry on its own
+//---------------------------------------------------------
+
+void TestJobFile::grouped()
+      {
+      QTemporaryDir single;
+      QTemporaryDir job;
+      QVERIFY(single.isValid() && job.isValid());
+      QString in = root + "/" + SCORE;
+
+      QStringList singleFiles = outputs(single.path());
+      for (const QString& out : singleFiles)
+            QCOMPARE(QProcess::execute(MSCORE_EXECUTABLE, { "-o", out, in }), 0);
+
+      QStringList jobFiles = outputs(job.path());
+      QJsonArray a;
+      for (const QString& out : jobFiles) {
+            QJsonObject obj;
+            obj["in"]  = in;
+            obj["out"] = out;
+            a.append(obj);
+            }
+      QString jobFile = job.path() + "/job.json";
+      QFile f(jobFile);
+      QVERIFY(f.open(QIODevice::WriteOnly));
+      f.write(QJsonDocument(a).toJson());
+      f.close();
+      QCOMPARE(QProcess::execute(MSCORE_EXECUTABLE, { "-j", jobFile, "--job-workers", "1" }), 0);
+
+      for (int i = 0; i < singleFiles.size(); ++i) {
+            // png pages are written with a page number suffix
+            QFileInfo fi(singleFiles[i]);
+            QStringList names = QDir(single.path()).entryList({ fi.completeBaseName() + "*." + fi.suffix() }, QDir::Files, QDir::Name);
+            QVERIFY2(!names.isEmpty(), qPrintable(singleFiles[i]));
+            for (const QString& name : names) {
+                  QFile sf(single.path() + "/" + name);
+                  QFile jf(job.path() + "/" + name);
+                  QVERIFY2(sf.open(QIODevice::ReadOnly), qPrintable(sf.fileName()));
+                  QVERIFY2(jf.open(QIODevice::ReadOnly), qPrintable(jf.fileName()));
+                  QVERIFY2(sf.readAll() == jf.readAll(), qPrintable(name));
+                  }
+            }
+      }
+
+QTEST_MAIN(TestJobFile)
+#include "tst_jobfile.moc"
@@ -0,0 +1,192 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2
+//  as published by the Free Software Foundation and appearing in
+//  the file LICENCE.GPL
+//=============================================================================
+
+#include <QtTest/QtTest>
+#include <thread>
+
+#include "mscore/seq.h"
+#include "mtest/testutils.h"
+
+using namespace Ms;
+
+//---------------------------------------------------------
+//   playMsg
+//    a gui -> sequencer event numbered by its originating
+//    staff
+//---------------------------------------------------------
+
+static SeqMsg playMsg(int n, int type = ME_CONTROLLER, int velo = 64)
+      {
+      NPlayEvent e(type, 0, 60, velo);
+      e.setOriginatingStaff(n);
+      return SeqMsg(SeqMsgId::PLAY, e);
+      }
+
+//---------------------------------------------------------
+//   TestFifo
+//---------------------------------------------------------
+
+class TestFifo : public QObject, public MTest
+      {
+      Q_OBJECT
+
+   private slots:
+      void initTestCase();
+      void overflow();
+      void coalesce();
+      void droppable();
+      void stress();
+      };
+
+//---------------------------------------------------------
+//   initTestCase
+//---------------------------------------------------------
+
+void TestFifo::initTestCase()
+      {
+      initMTest();
+      }
+
+//---------------------------------------------------------
+//   overflow
+//    writing a message to a full fifo must fail
+//    immediately, seek and tempo changes still get through
+//---------------------------------------------------------
+
+void TestFifo::overflow()
+      {
+      std::unique_ptr<SeqMsgFifo> fifo(new SeqMsgFifo);
+      for (int i = 0; i < SEQ_MSG_FIFO_SIZE; ++i)
+            QVERIFY(fifo->enqueue(playMsg(i)));
+      QVERIFY(fifo->isFull());
+      QVERIFY(!fifo->enqueue(playMsg(SEQ_MSG_FIFO_SIZE)));
+      QVERIFY(!fifo->enqueue(playMsg(SEQ_MSG_FIFO_SIZE)));
+      QCOMPARE(fifo->overflowCount(), 2);
+
+      QVERIFY(fifo->enqueue(SeqMsg(SeqMsgId::SEEK, 480)));
+      QVERIFY(fifo->enqueue(SeqMsg(SeqMsgId::TEMPO_CHANGE, qreal(1.5))));
+      QCOMPARE(fifo->overflowCount(), 2);
+
+      QCOMPARE(fifo->dequeue().event.getOriginatingStaff(), 0);
+      QVERIFY(fifo->enqueue(playMsg(SEQ_MSG_FIFO_SIZE)));
+      for (int i = 1; i <= SEQ_MSG_FIFO_SIZE; ++i)
+            QCOMPARE(fifo->dequeue().event.getOriginatingStaff(), i);
+      QVERIFY(fifo->empty());
+
+      int tick;
+      qreal tempo;
+      QVERIFY(fifo->takeSeek(&tick));
+      QCOMPARE(tick, 480);
+      QVERIFY(fifo->takeTempo(&tempo));
+      QCOMPARE(tempo, qreal(1.5));
+      }
+
+//---------------------------------------------------------
+//   coalesce
+//    only the latest seek and tempo change are delivered,
+//    and each only once
+//---------------------------------------------------------
+
+void TestFifo::coalesce()
+      {
+      std::unique_ptr<SeqMsgFifo> fifo(new SeqMsgFifo);
+      int tick;
+      qreal tempo;
+      QVERIFY(!fifo->takeSeek(&tick));
+      QVERIFY(!fifo->takeTempo(&tempo));
+      for (int i = 0; i < 3 * SEQ_MSG_FIFO_SIZE; ++i) {
+            QVERIFY(fifo->enqueue(SeqMsg(SeqMsgId::SEEK, i)));
+            QVERIFY(fifo->enqueue(SeqMsg(SeqMsgId::TEMPO_CHANGE, qreal(i) / 100)));
+            }
+      QVERIFY(fifo->empty());
+      QVERIFY(fifo->takeSeek(&tick));
+      QCOMPARE(tick, 3 * SEQ_MSG_FIFO_SIZE - 1);
+      QVERIFY(!fifo->takeSeek(&tick));
+      QVERIFY(fifo->takeTempo(&tempo));
+      QCOMPARE(tempo, qreal(3 * SEQ_MSG_FIFO_SIZE - 1) / 100);
+      QVERIFY(!fifo->takeTempo(&tempo));
+      }
+
+//---------------------------------------------------------
+//   droppable
+//    only a note on may be dropped from a full fifo
+//---------------------------------------------------------
+
+void TestFifo::droppable()
+      {
+      QVERIFY(SeqMsgFifo::droppable(playMsg(0, ME_NOTEON, 80)));
+      QVERIFY(!SeqMsgFifo::droppable(playMsg(0, ME_NOTEON, 0)));
+      QVERIFY(!SeqMsgFifo::droppable(playMsg(0, ME_NOTEOFF, 0)));
+      QVERIFY(!SeqMsgFifo::droppable(playMsg(0, ME_CONTROLLER, 7)));
+      QVERIFY(!SeqMsgFifo::droppable(playMsg(0, ME_PROGRAM, 1)));
+      }
+
+//---------------------------------------------------------
+//   stress
+//    the gui thread floods the fifo with events, seeks and
+//    tempo changes while the audio thread is slowed down by
+//    rendering. Every event must arrive once and in order,
+//    seeks and tempo changes only move forward and the
+//    last ones must arrive.
+//---------------------------------------------------------
+
+void TestFifo::stress()
+      {
+      const int n = 200000;
+      std::unique_ptr<SeqMsgFifo> fifo(new SeqMsgFifo);
+      std::thread writer([&fifo]() {
+            for (int i = 0; i < n; ) {
+                  fifo->enqueue(SeqMsg(SeqMsgId::SEEK, i));
+                  fifo->enqueue(SeqMsg(SeqMsgId::TEMPO_CHANGE, qreal(i)));
+                  if (fifo->enqueue(playMsg(i)))
+                        ++i;
+                  else
+                        std::this_thread::yield();
+                  }
+            });
+      int expected = 0;
+      int errors   = 0;
+      int lastTick = -1;
+      qreal lastTempo = -1.0;
+      int cycles   = 0;
+      while (expected < n || lastTick < n - 1 || lastTempo < n - 1) {
+            int tick;
+            if (fifo->takeSeek(&tick)) {
+                  if (tick < lastTick)
+                        ++errors;
+                  lastTick = tick;
+                  }
+            qreal tempo;
+            if (fifo->takeTempo(&tempo)) {
+                  if (tempo < lastTempo)
+                        ++errors;
+                  lastTempo = tempo;
+                  }
+            while (!fifo->empty()) {
+                  if (fifo->dequeue().event.getOriginatingStaff() != expected)
+                        ++errors;
+                  ++expected;
+                  }
+            // rendering a period
+            if (++cycles % 16 == 0)
+                  std::this_thread::sleep_for(std::chrono::microseconds(100));
+            else
+                  std::this_thread::yield();
+            }
+      writer.join();
+      QCOMPARE(errors, 0);
+      QCOMPARE(expected, n);
+      QCOMPARE(lastTick, n - 1);
+      QCOMPARE(lastTempo, qreal(n - 1));
+      QVERIFY(fifo->empty());
+      }
+
+QTEST_MAIN(TestFifo)
+#include "tst_fifo.moc"
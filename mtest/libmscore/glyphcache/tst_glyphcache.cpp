@@ -0,0 +1,146 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2
+//  as published by the Free Software Foundation and appearing in
+//  the file LICENCE.GPL
+//=============================================================================
+
+#include <QtTest/QtTest>
+
+#include "libmscore/sym.h"
+#include "mtest/testutils.h"
+
+using namespace Ms;
+
+//---------------------------------------------------------
+//   TestGlyphCache
+//---------------------------------------------------------
+
+class TestGlyphCache : public QObject, public MTest
+      {
+      Q_OBJECT
+
+      QImage draw(ScoreFont* f, SymId id, const QColor& color, qreal scale);
+
+   private slots:
+      void initTestCase();
+      void keys();
+      void scroll();
+      void threads();
+      };
+
+//---------------------------------------------------------
+//   initTestCase
+//---------------------------------------------------------
+
+void TestGlyphCache::initTestCase()
+      {
+      initMTest();
+      }
+
+//---------------------------------------------------------
+//   draw
+//---------------------------------------------------------
+
+QImage TestGlyphCache::draw(ScoreFont* f, SymId id, const QColor& color, qreal scale)
+      {
+      QImage img(200, 200, QImage::Format_ARGB32_Premultiplied);
+      img.fill(Qt::white);
+      QPainter p(&img);
+      p.scale(scale, scale);
+      p.setPen(color);
+      f->draw(id, &p, 1.0, QPointF(20.0, 40.0));
+      return img;
+      }
+
+//---------------------------------------------------------
+//   keys
+//    a glyph is rendered once per size; other colors are
+//    made from the cached mask
+//---------------------------------------------------------
+
+void TestGlyphCache::keys()
+      {
+      ScoreFont* f = ScoreFont::fontFactory("Bravura");
+      const GlyphCache* c = f->glyphCache();
+      QVERIFY(c);
+
+      quint64 rasterized = c->rasterized;
+      quint64 tinted     = c->tinted;
+      quint64 hits       = c->hits;
+
+      QImage black = draw(f, SymId::gClef, Qt::black, 1.0);
+      QCOMPARE(c->rasterized, rasterized + 1);
+      QImage black2 = draw(f, SymId::gClef, Qt::black, 1.0);
+      QCOMPARE(c->hits, hits + 1);
+      QCOMPARE(black, black2);
+
+      QImage red = draw(f, SymId::gClef, Qt::red, 1.0);
+      QCOMPARE(c->tinted, tinted + 1);
+      QCOMPARE(c->rasterized, rasterized + 1);
+      QVERIFY(red != black);
+
+      draw(f, SymId::gClef, Qt::black, 2.0);
+      QCOMPARE(c->rasterized, rasterized + 2);
+      draw(f, SymId::gClef, Qt::black, 1.0);
+      QCOMPARE(c->hits, hits + 2);
+      }
+
+//---------------------------------------------------------
+//   scroll
+//    redrawing the glyphs of a page must not render any
+//    glyph again
+//---------------------------------------------------------
+
+void TestGlyphCache::scroll()
+      {
+      ScoreFont* f = ScoreFont::fontFactory("Bravura");
+      const GlyphCache* c = f->glyphCache();
+      const SymId ids[] = { SymId::noteheadBlack, SymId::noteheadHalf, SymId::noteheadWhole,
+                            SymId::accidentalSharp, SymId::accidentalFlat, SymId::accidentalNatural,
+                            SymId::restQuarter, SymId::rest8th, SymId::flag8thUp, SymId::fClef };
+      for (SymId id : ids) {
+            draw(f, id, Qt::black, 1.5);
+            draw(f, id, Qt::blue, 1.5);
+            }
+      quint64 rasterized = c->rasterized;
+      quint64 tinted     = c->tinted;
+      for (int i = 0; i < 10; ++i) {
+            for (SymId id : ids) {
+                  draw(f, id, Qt::black, 1.5);
+                  draw(f, id, Qt::blue, 1.5);
+                  }
+            }
+      QCOMPARE(c->rasterized, rasterized);
+      QCOMPARE(c->tinted, tinted);
+      }
+
+//---------------------------------------------------------
+//   threads
+//    worker threads cache the tinted glyphs too and paint
+//    them like the gui thread does
+//---------------------------------------------------------
+
+void TestGlyphCache::threads()
+      {
+      ScoreFont* f = ScoreFont::fontFactory("Bravura");
+      const GlyphCache* c = f->glyphCache();
+      QImage gui = draw(f, SymId::cClef, Qt::darkGreen, 1.25);
+
+      quint64 tinted = c->tinted;
+      quint64 hits   = c->hits;
+      auto worker = [this, f]() { return draw(f, SymId::cClef, Qt::darkGreen, 1.25); };
+      QImage w1 = QtConcurrent::run(worker).result();
+      QCOMPARE(c->tinted, tinted + 1);
+      QImage w2 = QtConcurrent::run(worker).result();
+      QCOMPARE(c->tinted, tinted + 1);
+      QCOMPARE(c->hits, hits + 1);
+      QCOMPARE(w1, gui);
+      QCOMPARE(w2, gui);
+      }
+
+QTEST_MAIN(TestGlyphCache)
+#include "tst_glyphcache.moc"
@@ -13,6 +13,15 @@
 #include <QtTest/QtTest>
 #include "mtest/testutils.h"
 #include "libmscore/score.h"
+#include "libmscore/measure.h"
+#include "libmscore/chord.h"
+#include "libmscore/note.h"
+#include "libmscore/system.h"
+#include "libmscore/skyline.h"
+#include "libmscore/page.h"
+#include "libmscore/bsp.h"
+#include "libmscore/segment.h"
+#include "libmscore/shape.h"
 
 #define DIR QString("libmscore/layout/")
 
@@ -39,6 +48,11 @@ class TestBenchmark : public QObject, public MTest
       void benchmark1();
       void benchmark2();
       void benchmark4();            // incremental layout (one page)
+      void benchmark5();            // edit in first measure, relayout
+      void benchmark6();            // skyline distances between staves
+      void benchmark7_data();
+      void benchmark7();            // bsp tree after systems moved
+      void benchmark8();            // skylines of all system staves
       };
 
 //---------------------------------------------------------
@@ -89,6 +103,173 @@ void TestBenchmark::benchmark4()
             }
       }
 
+//---------------------------------------------------------
+//   benchmark5
+//    flip the stem of the first chord: only the first
+//    page(s) should be laid out again
+//---------------------------------------------------------
+
+void TestBenchmark::benchmark5()
+      {
+      score->doLayout();
+      Measure* m = score->firstMeasure();
+      ChordRest* cr = m->findChordRest(m->tick(), 0);
+      QVERIFY(cr && cr->isChord());
+      score->select(toChord(cr)->upNote());
+      int pages = score->npages();
+      QBENCHMARK {
+            score->startCmd();
+            score->cmdFlip();
+            score->endCmd();
+            }
+      QCOMPARE(score->npages(), pages);
+      }
+
+//---------------------------------------------------------
+//   benchmark6
+//    vertical distance of all neighbouring staves of
+//    all systems, as computed when stacking systems
+//---------------------------------------------------------
+
+void TestBenchmark::benchmark6()
+      {
+      score->doLayout();
+      qreal d = 0.0;
+      QBENCHMARK {
+            for (System* system : score->systems()) {
+                  for (int staffIdx = 0; staffIdx < score->nstaves() - 1; ++staffIdx) {
+                        const Skyline& sk1 = system->staff(staffIdx)->skyline();
+                        const Skyline& sk2 = system->staff(staffIdx + 1)->skyline();
+                        d += sk1.minDistance(sk2);
+                        }
+                  }
+            }
+      Q_UNUSED(d);
+      }
+
+//---------------------------------------------------------
+//   benchmark7
+//    bring the bsp tree of the first page up to date after
+//    one or all of its systems moved, as after an edit
+//    which changes the height of one system: update the
+//    tree or build a new one; "new tree" times the full
+//    build that update() does for a page laid out the
+//    first time
+//---------------------------------------------------------
+
+void TestBenchmark::benchmark7_data()
+      {
+      QTest::addColumn<bool>("allSystems");
+      QTest::addColumn<bool>("incremental");
+      QTest::addColumn<bool>("newTree");
+      QTest::newRow("one system, update")   << false << true  << false;
+      QTest::newRow("one system, rebuild")  << false << false << false;
+      QTest::newRow("all systems, update")  << true  << true  << false;
+      QTest::newRow("all systems, rebuild") << true  << false << false;
+      QTest::newRow("new tree")             << true  << true  << true;
+      }
+
+void TestBenchmark::benchmark7()
+      {
+      QFETCH(bool, allSystems);
+      QFETCH(bool, incremental);
+      QFETCH(bool, newTree);
+      score->doLayout();
+      Page* page = score->pages().front();
+      QVERIFY(page->systems().size() > 1);
+      QList<System*> systems;
+      if (allSystems)
+            systems = page->systems();
+      else
+            systems.append(page->systems().back());
+      QList<Element*> el = page->elements();
+      QRectF r(page->abbox());
+      BspTree tree;
+      tree.update(r, el);
+
+      qreal dy     = score->spatium();
+      qreal offset = 0.0;
+      QBENCHMARK {
+            for (System* s : systems)
+                  s->rypos() += dy;
+            offset += dy;
+            dy = -dy;
+            if (newTree) {
+                  // as on the first layout of a page
+                  BspTree t;
+                  t.update(r, el);
+                  }
+            else if (incremental)
+                  tree.update(r, el);
+            else {
+                  tree.initialize(r, el.size());
+                  for (Element* e : el)
+                        tree.insert(e);
+                  }
+            }
+      for (System* s : systems)
+            s->rypos() -= offset;
+      tree.update(r, el);
+
+      // the updated tree must find what a new one finds
+      BspTree fresh;
+      fresh.update(r, el);
+      QList<QRectF> rects { r, page->systems().front()->pageBoundingRect(), page->systems().back()->pageBoundingRect() };
+      for (const QRectF& rr : rects) {
+            QList<Element*> a = tree.items(rr);
+            QList<Element*> b = fresh.items(rr);
+            QCOMPARE(a.toSet(), b.toSet());
+            }
+      }
+
+//---------------------------------------------------------
+//   benchmark8
+//    build the skylines of all system staves from the
+//    shapes of their segments, as Score::layoutSystemElements()
+//    does
+//---------------------------------------------------------
+
+void TestBenchmark::benchmark8()
+      {
+      score->doLayout();
+      QList<QList<QRectF>> staves;
+      for (System* system : score->systems()) {
+            for (int staffIdx = 0; staffIdx < score->nstaves(); ++staffIdx) {
+                  QList<QRectF> rl;
+                  for (MeasureBase* mb : system->measures()) {
+                        if (!mb->isMeasure())
+                              continue;
+                        Measure* m = toMeasure(mb);
+                        for (Segment& s : m->segments()) {
+                              for (const ShapeElement& r : s.staffShape(staffIdx))
+                                    rl.append(r.translated(s.pos() + m->pos()));
+                              }
+                        }
+                  staves.append(rl);
+                  }
+            }
+
+      std::vector<Skyline> skylines(staves.size());
+      QBENCHMARK {
+            for (int i = 0; i < staves.size(); ++i) {
+                  skylines[i].clear();
+                  for (const QRectF& r : staves[i])
+                        skylines[i].add(r);
+                  }
+            }
+
+      // segment start positions are kept up to date by add()
+      for (const Skyline& sk : skylines) {
+            for (const SkylineLine* sl : { &sk.north(), &sk.south() }) {
+                  qreal x = 0.0;
+                  for (size_t i = 0; i < sl->size(); ++i) {
+                        QCOMPARE(sl->x(i), x);
+                        x += sl->w(i);
+                        }
+                  }
+            }
+      }
+
 QTEST_MAIN(TestBenchmark)
 #include "tst_benchmark.moc"
 
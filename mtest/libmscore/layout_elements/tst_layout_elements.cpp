@@ -34,12 +34,14 @@ class TestLayoutElements : public QObject, public MTest
       MasterScore* score;
       void beam(const char* path);
       void tstLayoutAll(QString file);
+      QList<QPair<QString, QRectF>> layoutParallel(QString file, bool parallel);
 
    private slots:
       void initTestCase();
       void tstLayoutElements()  { tstLayoutAll("layout_elements.mscx"); }
       void tstLayoutTablature() { tstLayoutAll("layout_elements_tab.mscx"); }
       void tstLayoutMoonlight() { tstLayoutAll("moonlight.mscx");       }
+      void tstLayoutParallelTablature();
       // FIXME goldberg.mscx does not pass the test because of some
       // TimeSig and Clef elements. Need to check it later!
 //       void tstLayoutGoldberg()  { tstLayoutAll("goldberg.mscx");        }
@@ -113,6 +115,57 @@ void TestLayoutElements::tstLayoutAll(QString file)
             }
       }
 
+//---------------------------------------------------------
+//   collectElements
+//    For use with Score::scanElements in layoutParallel
+//---------------------------------------------------------
+
+static void collectElements(void* data, Element* e)
+      {
+      QList<QPair<QString, QRectF>>* list = static_cast<QList<QPair<QString, QRectF>>*>(data);
+      list->append(qMakePair(QString(e->name()), e->pageBoundingRect()));
+      }
+
+//---------------------------------------------------------
+//   layoutParallel
+//    read and lay out a score with or without the parallel
+//    chord layout, return the name and position of all
+//    elements
+//---------------------------------------------------------
+
+QList<QPair<QString, QRectF>> TestLayoutElements::layoutParallel(QString file, bool parallel)
+      {
+      QList<QPair<QString, QRectF>> list;
+      MScore::parallelLayout = parallel;
+      MasterScore* score = readScore(DIR + file);
+      if (score) {
+            score->doLayout();
+            score->scanElements(&list, collectElements, /* all */ true);
+            delete score;
+            }
+      MScore::parallelLayout = false;
+      return list;
+      }
+
+//---------------------------------------------------------
+//   tstLayoutParallelTablature
+//    tablature chords add and remove stems and hooks with
+//    undo while they are laid out; the parallel layout
+//    must give the same result as the serial one
+//---------------------------------------------------------
+
+void TestLayoutElements::tstLayoutParallelTablature()
+      {
+      QList<QPair<QString, QRectF>> serial   = layoutParallel("layout_elements_tab.mscx", false);
+      QList<QPair<QString, QRectF>> parallel = layoutParallel("layout_elements_tab.mscx", true);
+      QVERIFY(!serial.isEmpty());
+      QCOMPARE(parallel.size(), serial.size());
+      for (int i = 0; i < serial.size(); ++i) {
+            QCOMPARE(parallel[i].first, serial[i].first);
+            QCOMPARE(parallel[i].second, serial[i].second);
+            }
+      }
+
 QTEST_MAIN(TestLayoutElements)
 #include "tst_layout_elements.moc"
 
@@ -22,6 +22,7 @@
 #include "libmscore/chord.h"
 #include "libmscore/note.h"
 #include "libmscore/keysig.h"
+#include "libmscore/repeatlist.h"
 #include "mscore/exportmidi.h"
 #include <QIODevice>
 
@@ -51,6 +52,9 @@ class TestMidi : public QObject, public MTest
       void midi03();
       void events_data();
       void events();
+      void midiChunks();
+      void midiControllers();
+      void midiCachedMeasureEvents();
       void midiBendsExport1() { midiExportTestRef("testBends1"); }
       void midiBendsExport2() { midiExportTestRef("testBends2"); }      // Play property test
       void midiPortExport()   { midiExportTestRef("testMidiPort"); }
@@ -406,6 +410,112 @@ void TestMidi::events()
      // QVERIFY(saveCompareScore(score, writeFile, reference));
       }
 
+//---------------------------------------------------------
+//   midiChunks
+//    rendering a score chunk by chunk must give the same
+//    events as rendering it as a whole
+//---------------------------------------------------------
+
+void TestMidi::midiChunks()
+      {
+      for (const char* file : { "testPausesRepeats", "testVoltaDynamic", "testMetronomeAnacrusis" }) {
+            MasterScore* score = readScore(DIR + file + ".mscx");
+            QVERIFY(score);
+            EventMap events;
+            score->renderMidi(&events, true, true);
+
+            for (int minMeasures : { 1, 3 }) {
+                  EventMap chunkEvents;
+                  score->prepareMidi(true);
+                  for (const MidiChunk& chunk : score->midiChunks(minMeasures))
+                        score->renderMidiChunk(&chunkEvents, chunk, true);
+
+                  auto eventList = [](const EventMap& em) {
+                        QStringList l;
+                        for (const auto& e : em) {
+                              if (!e.second.discard())
+                                    l.append(QString("%1 %2 %3 %4 %5").arg(e.first).arg(e.second.type())
+                                       .arg(e.second.dataA()).arg(e.second.dataB()).arg(e.second.channel()));
+                              }
+                        l.sort();
+                        return l;
+                        };
+                  QCOMPARE(eventList(chunkEvents), eventList(events));
+                  }
+            delete score;
+            }
+      }
+
+//---------------------------------------------------------
+//   midiCachedMeasureEvents
+//    an edit must be reflected in the next rendering
+//    although the measure events are cached
+//---------------------------------------------------------
+
+void TestMidi::midiCachedMeasureEvents()
+      {
+      MasterScore* score = readScore(DIR + "testPausesRepeats.mscx");
+      QVERIFY(score);
+      score->doLayout();
+      EventMap events1;
+      score->renderMidi(&events1);
+
+      Chord* chord = score->firstMeasure()->findChord(0, 0);
+      QVERIFY(chord);
+      score->startCmd();
+      chord->upNote()->undoChangeProperty(Pid::VELO_OFFSET, 20);
+      score->endCmd();
+
+      EventMap events2;
+      score->renderMidi(&events2);
+      score->setPlayEventsDirty();
+      EventMap events3;
+      score->renderMidi(&events3);
+
+      auto eventList = [](const EventMap& em) {
+            QStringList l;
+            for (const auto& e : em)
+                  l.append(QString("%1 %2 %3 %4").arg(e.first).arg(e.second.type()).arg(e.second.dataA()).arg(e.second.dataB()));
+            return l;
+            };
+      QVERIFY(eventList(events2) != eventList(events1));
+      QCOMPARE(eventList(events2), eventList(events3));
+      delete score;
+      }
+
+//---------------------------------------------------------
+//   midiControllers
+//    the controllers rendered up front for seeking must be
+//    the controllers of the full render
+//---------------------------------------------------------
+
+void TestMidi::midiControllers()
+      {
+      for (const char* file : { "testPedal", "testVoltaStaffText", "testPausesRepeats" }) {
+            MasterScore* score = readScore(DIR + file + ".mscx");
+            QVERIFY(score);
+            EventMap events;
+            score->renderMidi(&events, true, true);
+            EventMap controllers;
+            score->prepareMidi(true);
+            score->renderMidiControllers(&controllers);
+
+            auto eventList = [](const EventMap& em) {
+                  QStringList l;
+                  for (const auto& e : em) {
+                        if (e.second.type() == ME_CONTROLLER)
+                              l.append(QString("%1 %2 %3 %4").arg(e.first).arg(e.second.dataA())
+                                 .arg(e.second.dataB()).arg(e.second.channel()));
+                        }
+                  l.sort();
+                  return l;
+                  };
+            QCOMPARE(eventList(controllers), eventList(events));
+            QVERIFY(QString(file) != "testPedal" || !eventList(controllers).empty());
+            delete score;
+            }
+      }
+
 //---------------------------------------------------------
 //   midiExportTest
 //   read a MuseScore mscx file, write to a MIDI file and verify against reference
@@ -0,0 +1,483 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2
+//  as published by the Free Software Foundation and appearing in
+//  the file LICENCE.GPL
+//=============================================================================
+
+#include <QtTest/QtTest>
+
+#include "libmscore/score.h"
+#include "libmscore/measure.h"
+#include "libmscore/page.h"
+#include "mtest/testutils.h"
+#include "mscore/tilecache.h"
+
+static const QString BENCHMARK_SCORE("libmscore/concertpitch/concertpitchbenchmark.mscx");
+static const qreal DPI_PNG = 150.0;
+static const qreal VIEW_SCALE = 0.5;      // device pixels per page unit, about 180% on a laptop
+
+using namespace Ms;
+
+//---------------------------------------------------------
+//   TestRenderPage
+//---------------------------------------------------------
+
+class TestRenderPage : public QObject, public MTest
+      {
+      Q_OBJECT
+
+      QList<QByteArray> renderPngs(Score* score, int pages, int threads);
+
+   private slots:
+      void initTestCase();
+      void context();
+      void parallel();
+      void benchmark();
+      void displayList();
+      void paintBenchmark_data();
+      void paintBenchmark();
+      void tiles();
+      void tileBenchmark();
+      };
+
+//---------------------------------------------------------
+//   initTestCase
+//---------------------------------------------------------
+
+void TestRenderPage::initTestCase()
+      {
+      initMTest();
+      }
+
+//---------------------------------------------------------
+//   renderPngs
+//    rasterize and encode the first pages of score on at
+//    most threads worker threads, as the png export does
+//---------------------------------------------------------
+
+QList<QByteArray> TestRenderPage::renderPngs(Score* score, int pages, int threads)
+      {
+      QList<int> pageNumbers;
+      for (int i = 0; i < pages; ++i)
+            pageNumbers.append(i);
+      std::function<QByteArray(int)> render = [score](int pageNumber) {
+            QImage image = score->renderPage(pageNumber, DPI_PNG);
+            QByteArray png;
+            QBuffer buffer(&png);
+            buffer.open(QIODevice::WriteOnly);
+            image.save(&buffer, "png");
+            return png;
+            };
+      QThreadPool* pool = QThreadPool::globalInstance();
+      int maxThreads    = pool->maxThreadCount();
+      pool->setMaxThreadCount(threads);
+      QList<QByteArray> pngs = QtConcurrent::blockingMapped<QList<QByteArray>>(pageNumbers, render);
+      pool->setMaxThreadCount(maxThreads);
+      return pngs;
+      }
+
+//---------------------------------------------------------
+//   context
+//    rendering a page must not change the global render
+//    state
+//---------------------------------------------------------
+
+void TestRenderPage::context()
+      {
+      MasterScore* score = readScore(BENCHMARK_SCORE);
+      QVERIFY(score);
+      double pixelRatio = MScore::pixelRatio();
+
+      QImage image = score->renderPage(0, DPI_PNG);
+      QVERIFY(!image.isNull());
+      QCOMPARE(MScore::pixelRatio(), pixelRatio);
+      QVERIFY(!score->printing());
+      QVERIFY(!RenderContext::current());
+
+      {
+      RenderContext rc(0.5);
+      QCOMPARE(MScore::pixelRatio(), 0.5);
+      QVERIFY(score->printing());
+      {
+      RenderContext rc2(2.0, false);
+      QCOMPARE(MScore::pixelRatio(), 2.0);
+      QVERIFY(!score->printing());
+      }
+      QCOMPARE(MScore::pixelRatio(), 0.5);
+      }
+      QCOMPARE(MScore::pixelRatio(), pixelRatio);
+      delete score;
+      }
+
+//---------------------------------------------------------
+//   parallel
+//    pages rendered concurrently must be the same as pages
+//    rendered one after the other
+//---------------------------------------------------------
+
+void TestRenderPage::parallel()
+      {
+      MasterScore* score = readScore(BENCHMARK_SCORE);
+      QVERIFY(score);
+      int pages = qMin(score->npages(), 8);
+
+      QList<QByteArray> sequential = renderPngs(score, pages, 1);
+      QList<QByteArray> concurrent = renderPngs(score, pages, qMax(QThread::idealThreadCount(), 4));
+      QCOMPARE(concurrent.size(), pages);
+      for (int i = 0; i < pages; ++i) {
+            QVERIFY(!sequential[i].isEmpty());
+            QVERIFY(sequential[i] == concurrent[i]);
+            }
+      delete score;
+      }
+
+//---------------------------------------------------------
+//   benchmark
+//    print the pages per second of the png export of a
+//    100 page score, one page per measure
+//---------------------------------------------------------
+
+void TestRenderPage::benchmark()
+      {
+      MasterScore* score = readScore(BENCHMARK_SCORE);
+      QVERIFY(score);
+      score->startCmd();
+      for (Measure* m = score->firstMeasure(); m; m = m->nextMeasure())
+            m->undoSetPageBreak(true);
+      score->endCmd();
+      QVERIFY(score->npages() >= 100);
+
+      const int pages = 100;
+      QElapsedTimer t;
+      t.start();
+      renderPngs(score, pages, 1);
+      qint64 sequential = t.restart();
+      renderPngs(score, pages, QThread::idealThreadCount());
+      qint64 concurrent = t.elapsed();
+
+      qDebug("%d pages: 1 thread %.1f pages/s, %d threads %.1f pages/s",
+         pages, pages * 1000.0 / qMax(sequential, qint64(1)),
+         QThread::idealThreadCount(), pages * 1000.0 / qMax(concurrent, qint64(1)));
+      delete score;
+      }
+
+//---------------------------------------------------------
+//   checkDisplayList
+//    the display list must hold the elements of the page in
+//    z order at their current positions
+//---------------------------------------------------------
+
+static void checkDisplayList(Page* page)
+      {
+      const std::vector<DisplayItem>& dl = page->displayList();
+      QCOMPARE(int(dl.size()), page->elements().size());
+      for (size_t i = 0; i < dl.size(); ++i) {
+            const Element* e = dl[i].element;
+            if (i > 0)
+                  QVERIFY(dl[i - 1].element->z() <= e->z());
+            QCOMPARE(dl[i].pos, e->pagePos());
+            QCOMPARE(dl[i].bbox, e->pageBoundingRect());
+            }
+      }
+
+//---------------------------------------------------------
+//   displayList
+//---------------------------------------------------------
+
+void TestRenderPage::displayList()
+      {
+      MasterScore* score = readScore(BENCHMARK_SCORE);
+      QVERIFY(score);
+      Page* page = score->pages().front();
+      checkDisplayList(page);
+
+      // a page break moves the measures after it
+      score->startCmd();
+      score->firstMeasure()->undoSetPageBreak(true);
+      score->endCmd();
+      checkDisplayList(score->pages().front());
+      checkDisplayList(score->pages().at(1));
+      delete score;
+      }
+
+//---------------------------------------------------------
+//   paintBenchmark_data
+//---------------------------------------------------------
+
+void TestRenderPage::paintBenchmark_data()
+      {
+      QTest::addColumn<bool>("retained");
+      QTest::newRow("bsp") << false;
+      QTest::newRow("displaylist") << true;
+      }
+
+//---------------------------------------------------------
+//   paintBenchmark
+//    scroll a view over the densest page of a score: query
+//    the bsp tree, sort and draw as ScoreView did before,
+//    or replay the display list of the page. Both must
+//    draw the same elements.
+//---------------------------------------------------------
+
+void TestRenderPage::paintBenchmark()
+      {
+      QFETCH(bool, retained);
+      MasterScore* score = readScore(BENCHMARK_SCORE);
+      QVERIFY(score);
+      Page* page = 0;
+      int n      = 0;
+      for (Page* p : score->pages()) {
+            int pn = p->elements().size();
+            if (pn > n) {
+                  page = p;
+                  n    = pn;
+                  }
+            }
+      QVERIFY(page);
+
+      const int frames = 40;
+      QRectF pr(page->bbox());
+      QSizeF vs(pr.width(), pr.height() / 3);
+      QImage image(vs.toSize(), QImage::Format_ARGB32_Premultiplied);
+      QList<QRectF> rects;
+      for (int i = 0; i < frames; ++i)
+            rects.append(QRectF(QPointF(0.0, (pr.height() - vs.height()) * i / (frames - 1)), vs));
+
+      auto paint = [&image, page](const QRectF& r, bool retained) {
+            image.fill(Qt::white);
+            QPainter p(&image);
+            p.translate(-r.topLeft());
+            if (retained) {
+                  for (const DisplayItem& di : page->displayList()) {
+                        if (!di.bbox.intersects(r) || !di.element->visible())
+                              continue;
+                        p.translate(di.pos);
+                        di.element->draw(&p);
+                        p.translate(-di.pos);
+                        }
+                  }
+            else {
+                  QList<Element*> el = page->items(r);
+                  qStableSort(el.begin(), el.end(), elementLessThan);
+                  for (const Element* e : el) {
+                        if (!e->visible())
+                              continue;
+                        QPointF pos(e->pagePos());
+                        p.translate(pos);
+                        e->draw(&p);
+                        p.translate(-pos);
+                        }
+                  }
+            };
+      // both paths must draw the same elements
+      for (const QRectF& r : rects) {
+            QSet<const Element*> immediate;
+            for (const Element* e : page->items(r))
+                  immediate.insert(e);
+            QSet<const Element*> replayed;
+            for (const DisplayItem& di : page->displayList()) {
+                  if (di.bbox.intersects(r))
+                        replayed.insert(di.element);
+                  }
+            QCOMPARE(replayed, immediate);
+            }
+      for (const QRectF& r : rects)       // warm up the glyph cache
+            paint(r, retained);
+
+      QBENCHMARK {
+            for (const QRectF& r : rects)
+                  paint(r, retained);
+            }
+      delete score;
+      }
+
+//---------------------------------------------------------
+//   drawPage
+//    draw the visible elements of page which intersect r,
+//    as ScoreView does
+//---------------------------------------------------------
+
+static void drawPage(QPainter& p, Page* page, const QRectF& r)
+      {
+      for (const DisplayItem& di : page->displayList()) {
+            if (!di.bbox.intersects(r) || !di.element->visible())
+                  continue;
+            p.translate(di.pos);
+            di.element->draw(&p);
+            p.translate(-di.pos);
+            }
+      }
+
+//---------------------------------------------------------
+//   tiles
+//    a page composited from tiles must look like the page
+//    drawn directly; other scales are served by stand-ins
+//    until their tiles are rendered. The tiles are shared
+//    by all caches and dropped per page after layout.
+//---------------------------------------------------------
+
+void TestRenderPage::tiles()
+      {
+      MasterScore* score = readScore(BENCHMARK_SCORE);
+      QVERIFY(score);
+      Page* page = score->pages().front();
+      QRectF pr(page->bbox());
+      const qreal scale = VIEW_SCALE / 2;
+      TileCache cache(drawPage, [](Page*, const QRectF&) {});
+
+      QImage direct((pr.size() * scale).toSize(), QImage::Format_ARGB32_Premultiplied);
+      direct.fill(0);
+      QImage tiled(direct.size(), QImage::Format_ARGB32_Premultiplied);
+      tiled.fill(0);
+      {
+      QPainter p(&direct);
+      p.setRenderHint(QPainter::Antialiasing, true);
+      p.setRenderHint(QPainter::TextAntialiasing, true);
+      p.scale(scale, scale);
+      drawPage(p, page, pr);
+      }
+      {
+      QPainter p(&tiled);
+      p.scale(scale, scale);
+      cache.paint(p, page, pr);
+      }
+      const int T = TileCache::TILE_SIZE;
+      int columns = qCeil(pr.width() * scale / T);
+      int rows    = qCeil(pr.height() * scale / T);
+      QCOMPARE(cache.tiles(), columns * rows);
+      QCOMPARE(cache.queued(), 0);
+
+      // antialiasing may differ where elements cross tile borders
+      int diffs = 0;
+      for (int y = 0; y < direct.height(); ++y) {
+            const QRgb* a = reinterpret_cast<const QRgb*>(direct.constScanLine(y));
+            const QRgb* b = reinterpret_cast<const QRgb*>(tiled.constScanLine(y));
+            for (int x = 0; x < direct.width(); ++x) {
+                  if (qAbs(qAlpha(a[x]) - qAlpha(b[x])) > 32)
+                        ++diffs;
+                  }
+            }
+      QVERIFY(diffs < direct.width() * direct.height() / 1000);
+
+      // zoom in: the tiles drawn so far stand in, new tiles are queued
+      QImage zoomed(direct.size() * 2, QImage::Format_ARGB32_Premultiplied);
+      zoomed.fill(0);
+      {
+      QPainter p(&zoomed);
+      p.scale(scale * 2, scale * 2);
+      cache.paint(p, page, pr);
+      }
+      QVERIFY(cache.queued() > 0);
+      cache.flush();
+      QCOMPARE(cache.queued(), 0);
+      int n = cache.tiles();
+      {
+      QPainter p(&zoomed);
+      p.scale(scale * 2, scale * 2);
+      cache.paint(p, page, pr);
+      }
+      QCOMPARE(cache.tiles(), n);
+      QCOMPARE(cache.queued(), 0);
+
+      // an edit drops the tiles of both scales under it
+      cache.invalidate(page, QRectF(1.0, 1.0, 10.0, 10.0));
+      QCOMPARE(cache.tiles(), n - 2);
+
+      // another view shares the tiles and renders only the dropped one
+      TileCache other(drawPage, [](Page*, const QRectF&) {});
+      {
+      QPainter p(&tiled);
+      p.scale(scale, scale);
+      other.paint(p, page, pr);
+      }
+      QCOMPARE(TileCache::tiles(), n - 1);
+
+      // laying out the page again drops its tiles when it is painted
+      // next, the tiles of other pages stay
+      QVERIFY(score->npages() > 1);
+      Page* page2 = score->pages().at(1);
+      {
+      QPainter p(&tiled);
+      p.scale(scale, scale);
+      cache.paint(p, page2, page2->bbox());
+      }
+      int n2 = TileCache::tiles();
+      page->rebuildBspTree();
+      {
+      QPainter p(&tiled);
+      p.scale(scale, scale);
+      cache.paint(p, page, pr);
+      }
+      QCOMPARE(TileCache::tiles(), n2 - (n - 1) + columns * rows);
+      cache.clear();
+      QCOMPARE(cache.tiles(), 0);
+      delete score;
+      }
+
+//---------------------------------------------------------
+//   tileBenchmark
+//    scroll a view over the first pages of a score: draw
+//    the display lists, then composite the tiles, first
+//    rendering them and then from the cache
+//---------------------------------------------------------
+
+void TestRenderPage::tileBenchmark()
+      {
+      MasterScore* score = readScore(BENCHMARK_SCORE);
+      QVERIFY(score);
+      const int pages = qMin(score->npages(), 4);
+      QVERIFY(pages > 0);
+
+      // the pages one below the other, as in a scrolling view
+      QSizeF ps(score->pages().front()->bbox().size());
+      QSizeF vs(ps.width(), ps.height() / 3);
+      const int frames = 40;
+      QList<QRectF> rects;
+      for (int i = 0; i < frames; ++i)
+            rects.append(QRectF(QPointF(0.0, (ps.height() * pages - vs.height()) * i / (frames - 1)), vs));
+      QImage image((vs * VIEW_SCALE).toSize(), QImage::Format_ARGB32_Premultiplied);
+      TileCache cache(drawPage, [](Page*, const QRectF&) {});
+
+      auto paint = [&](bool tiled) {
+            for (const QRectF& r : rects) {
+                  image.fill(Qt::white);
+                  QPainter p(&image);
+                  p.setRenderHint(QPainter::Antialiasing, true);
+                  p.scale(VIEW_SCALE, VIEW_SCALE);
+                  p.translate(-r.topLeft());
+                  for (int i = 0; i < pages; ++i) {
+                        Page* page = score->pages().at(i);
+                        QPointF pos(0.0, ps.height() * i);
+                        QRectF pr(r.translated(-pos) & page->bbox());
+                        if (pr.isEmpty())
+                              continue;
+                        p.translate(pos);
+                        if (tiled)
+                              cache.paint(p, page, pr);
+                        else
+                              drawPage(p, page, pr);
+                        p.translate(-pos);
+                        }
+                  }
+            };
+      paint(false);                 // warm up the display lists and glyph cache
+
+      QElapsedTimer t;
+      t.start();
+      paint(false);
+      qint64 direct = t.restart();
+      paint(true);
+      qint64 cold = t.restart();
+      paint(true);
+      qint64 warm = t.elapsed();
+      qDebug("%d pages, %d frames: display list %.2f ms/frame, new tiles %.2f ms/frame, cached tiles %.2f ms/frame",
+         pages, frames, double(direct) / frames, double(cold) / frames, double(warm) / frames);
+      delete score;
+      }
+
+QTEST_MAIN(TestRenderPage)
+#include "tst_renderpage.moc"
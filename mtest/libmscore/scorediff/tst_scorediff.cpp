@@ -0,0 +1,158 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2
+//  as published by the Free Software Foundation and appearing in
+//  the file LICENCE.GPL
+//=============================================================================
+
+#include <QtTest/QtTest>
+
+#include "libmscore/chord.h"
+#include "libmscore/note.h"
+#include "libmscore/score.h"
+#include "libmscore/scorediff.h"
+#include "libmscore/segment.h"
+#include "mtest/testutils.h"
+
+static const QString BENCHMARK_SCORE("libmscore/concertpitch/concertpitchbenchmark.mscx");
+
+using namespace Ms;
+
+//---------------------------------------------------------
+//   TestScoreDiff
+//---------------------------------------------------------
+
+class TestScoreDiff : public QObject, public MTest
+      {
+      Q_OBJECT
+
+      Note* noteAt(Score* score, int n);
+      void editNote(Score* score, int n, int velocity);
+
+   private slots:
+      void initTestCase();
+      void equal();
+      void smallEdit();
+      void benchmark();
+      };
+
+//---------------------------------------------------------
+//   initTestCase
+//---------------------------------------------------------
+
+void TestScoreDiff::initTestCase()
+      {
+      initMTest();
+      }
+
+//---------------------------------------------------------
+//   noteAt
+//    return the upper note of the first chord in the n-th
+//    chord rest segment or later
+//---------------------------------------------------------
+
+Note* TestScoreDiff::noteAt(Score* score, int n)
+      {
+      for (Segment* s = score->firstSegment(SegmentType::ChordRest); s; s = s->next1(SegmentType::ChordRest)) {
+            if (n-- > 0)
+                  continue;
+            for (Element* e : s->elist()) {
+                  if (e->isChord())
+                        return toChord(e)->upNote();
+                  }
+            }
+      return 0;
+      }
+
+//---------------------------------------------------------
+//   editNote
+//---------------------------------------------------------
+
+void TestScoreDiff::editNote(Score* score, int n, int velocity)
+      {
+      Note* note = noteAt(score, n);
+      QVERIFY(note);
+      score->startCmd();
+      note->undoSetVeloOffset(velocity);
+      score->endCmd();
+      }
+
+//---------------------------------------------------------
+//   equal
+//---------------------------------------------------------
+
+void TestScoreDiff::equal()
+      {
+      MasterScore* s1 = readScore(BENCHMARK_SCORE);
+      MasterScore* s2 = readScore(BENCHMARK_SCORE);
+      QVERIFY(s1 && s2);
+
+      ScoreDiff d(s1, s2);
+      QVERIFY(d.equal());
+      QVERIFY(d.diffs().empty());
+      QCOMPARE(int(d.textDiffs().size()), 1);
+
+      delete s1;
+      delete s2;
+      }
+
+//---------------------------------------------------------
+//   smallEdit
+//    only the edited measures may show up in the diff
+//---------------------------------------------------------
+
+void TestScoreDiff::smallEdit()
+      {
+      MasterScore* s1 = readScore(BENCHMARK_SCORE);
+      MasterScore* s2 = readScore(BENCHMARK_SCORE);
+      QVERIFY(s1 && s2);
+      editNote(s2, 100, 10);
+      editNote(s2, 1000, -10);
+
+      ScoreDiff d(s1, s2);
+      QVERIFY(!d.equal());
+      int changes = 0;
+      for (const TextDiff& td : d.textDiffs()) {
+            if (td.type == DiffType::EQUAL)
+                  continue;
+            ++changes;
+            QVERIFY(td.text[0].contains("<velocity>") || td.text[1].contains("<velocity>"));
+            }
+      QVERIFY(changes >= 2);
+      QVERIFY(!d.diffs().empty());
+
+      // a change in the other direction is found as well
+      ScoreDiff r(s2, s1);
+      QVERIFY(!r.diffs().empty());
+
+      delete s1;
+      delete s2;
+      }
+
+//---------------------------------------------------------
+//   benchmark
+//    diff a large score against a copy with a few edits
+//---------------------------------------------------------
+
+void TestScoreDiff::benchmark()
+      {
+      MasterScore* s1 = readScore(BENCHMARK_SCORE);
+      MasterScore* s2 = readScore(BENCHMARK_SCORE);
+      QVERIFY(s1 && s2);
+      for (int i = 1; i <= 5; ++i)
+            editNote(s2, i * 400, i);
+
+      QBENCHMARK {
+            ScoreDiff d(s1, s2);
+            QVERIFY(!d.equal());
+            }
+
+      delete s1;
+      delete s2;
+      }
+
+QTEST_MAIN(TestScoreDiff)
+#include "tst_scorediff.moc"
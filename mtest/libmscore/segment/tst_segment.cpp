@@ -0,0 +1,224 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2
+//  as published by the Free Software Foundation and appearing in
+//  the file LICENCE.GPL
+//=============================================================================
+
+#include <QtTest/QtTest>
+
+#include "libmscore/chord.h"
+#include "libmscore/note.h"
+#include "libmscore/notedot.h"
+#include "libmscore/score.h"
+#include "libmscore/measure.h"
+#include "libmscore/segment.h"
+#include "libmscore/sparsearray.h"
+#include "mtest/testutils.h"
+
+static const QString BENCHMARK_SCORE("libmscore/concertpitch/concertpitchbenchmark.mscx");
+
+using namespace Ms;
+
+//---------------------------------------------------------
+//   TestSegment
+//---------------------------------------------------------
+
+class TestSegment : public QObject, public MTest
+      {
+      Q_OBJECT
+
+      MasterScore* dottedScore(bool parallel);
+
+   private slots:
+      void initTestCase();
+      void sparseArray();
+      void storage();
+      void parallelDots();
+      };
+
+//---------------------------------------------------------
+//   initTestCase
+//---------------------------------------------------------
+
+void TestSegment::initTestCase()
+      {
+      initMTest();
+      }
+
+//---------------------------------------------------------
+//   sparseArray
+//---------------------------------------------------------
+
+void TestSegment::sparseArray()
+      {
+      SparseArray<int> a;
+      a.assign(200);
+      QVERIFY(a.empty());
+      a.set(130, 3);
+      a.set(2, 1);
+      a.set(64, 2);
+      QCOMPARE(a.size(), 200);
+      QCOMPARE(a.count(), 3);
+      QCOMPARE(a.values(), std::vector<int>({ 1, 2, 3 }));
+      QCOMPARE(a.value(64), 2);
+      QCOMPARE(a.value(63, -1), -1);
+      QCOMPARE(a.value(500, -1), -1);
+
+      a.insert(4, 100);             // 64 -> 164, 130 -> 230
+      QCOMPARE(a.size(), 300);
+      QCOMPARE(a.value(2), 1);
+      QCOMPARE(a.value(164), 2);
+      QCOMPARE(a.value(230), 3);
+      QVERIFY(!a.contains(64));
+
+      a.erase(100, 100);            // 164 falls out, 230 -> 130
+      QCOMPARE(a.size(), 200);
+      QCOMPARE(a.values(), std::vector<int>({ 1, 3 }));
+      QCOMPARE(a.value(130), 3);
+
+      std::vector<int> idx;
+      a.forEach([&idx](int i, int) { idx.push_back(i); });
+      QCOMPARE(idx, std::vector<int>({ 2, 130 }));
+
+      a.remove(2);
+      a.remove(3);
+      QCOMPARE(a.count(), 1);
+      QVERIFY(!a.contains(2));
+      }
+
+//---------------------------------------------------------
+//   storage
+//    element(track) and elist() must agree; print the
+//    memory used by the sparse storage and by the dense
+//    staves * VOICES vectors it replaces
+//---------------------------------------------------------
+
+void TestSegment::storage()
+      {
+      MasterScore* score = readScore(BENCHMARK_SCORE);
+      QVERIFY(score);
+      score->doLayout();
+
+      const int staves = score->nstaves();
+      const int tracks = staves * VOICES;
+      size_t sparse   = 0;
+      size_t dense    = 0;
+      int segments    = 0;
+      int elements    = 0;
+      for (Segment* s = score->firstSegment(SegmentType::All); s; s = s->next1()) {
+            QCOMPARE(s->tracks(), tracks);
+            std::vector<Element*> el;
+            for (int track = 0; track < tracks; ++track) {
+                  if (s->element(track))
+                        el.push_back(s->element(track));
+                  }
+            QVERIFY(el == s->elist());
+
+            size_t shapes = 0;
+            for (const Shape& sh : s->shapes())
+                  shapes += sh.capacity() * sizeof(ShapeElement);
+            sparse += s->storageBytes();
+            dense  += 3 * sizeof(std::vector<int>) + tracks * sizeof(Element*)
+                      + staves * (sizeof(Shape) + sizeof(qreal)) + shapes;
+            elements += int(el.size());
+            ++segments;
+            }
+      qDebug("%d staves, %d segments, %d elements: dense %zu bytes, sparse %zu bytes (%.0f%%)",
+         staves, segments, elements, dense, sparse, 100.0 * sparse / dense);
+      QVERIFY(sparse < dense);
+      delete score;
+      }
+
+//---------------------------------------------------------
+//   dottedScore
+//    read the benchmark score and dot the first chord of
+//    every staff in its first measures, so that the staves
+//    set the dot positions of the same segments
+//---------------------------------------------------------
+
+MasterScore* TestSegment::dottedScore(bool parallel)
+      {
+      MScore::parallelLayout = parallel;
+      MasterScore* score = readScore(BENCHMARK_SCORE);
+      if (!score)
+            return 0;
+      QList<ChordRest*> crl;
+      int n = 0;
+      for (Measure* m = score->firstMeasure(); m && n < 16; m = m->nextMeasure(), ++n) {
+            for (int staffIdx = 0; staffIdx < score->nstaves(); ++staffIdx) {
+                  Segment* s = m->first(SegmentType::ChordRest);
+                  ChordRest* cr = s ? s->cr(staffIdx * VOICES) : 0;
+                  if (!cr || !cr->isChord() || cr->tuplet() || cr->durationType().dots())
+                        continue;
+                  TDuration d(cr->durationType());
+                  d.setDots(1);
+                  if (d.isValid() && cr->rtick() + d.ticks() <= m->ticks())
+                        crl.append(cr);
+                  }
+            }
+      score->startCmd();
+      for (ChordRest* cr : crl) {
+            TDuration d(cr->durationType());
+            d.setDots(1);
+            score->changeCRlen(cr, d);
+            }
+      score->endCmd();
+      MScore::parallelLayout = false;
+      return score;
+      }
+
+//---------------------------------------------------------
+//   parallelDots
+//    the staves of a measure set the dot positions of the
+//    same segments; the parallel layout must give the same
+//    dots as the serial one
+//---------------------------------------------------------
+
+void TestSegment::parallelDots()
+      {
+      MasterScore* serial   = dottedScore(false);
+      MasterScore* parallel = dottedScore(true);
+      QVERIFY(serial && parallel);
+
+      int shared = 0;         // segments with dotted chords on several staves
+      Segment* s1 = serial->firstSegment(SegmentType::ChordRest);
+      Segment* s2 = parallel->firstSegment(SegmentType::ChordRest);
+      for (; s1 && s2; s1 = s1->next1(SegmentType::ChordRest), s2 = s2->next1(SegmentType::ChordRest)) {
+            QCOMPARE(s2->tick(), s1->tick());
+            int dotted = 0;
+            for (int staffIdx = 0; staffIdx < serial->nstaves(); ++staffIdx) {
+                  QCOMPARE(s2->dotPosX(staffIdx), s1->dotPosX(staffIdx));
+                  for (int voice = 0; voice < VOICES; ++voice) {
+                        int track = staffIdx * VOICES + voice;
+                        ChordRest* cr1 = s1->cr(track);
+                        ChordRest* cr2 = s2->cr(track);
+                        QCOMPARE(!cr2, !cr1);
+                        if (!cr1 || !cr1->isChord())
+                              continue;
+                        const std::vector<Note*>& nl1 = toChord(cr1)->notes();
+                        const std::vector<Note*>& nl2 = toChord(cr2)->notes();
+                        QCOMPARE(nl2.size(), nl1.size());
+                        for (size_t i = 0; i < nl1.size(); ++i) {
+                              QCOMPARE(nl2[i]->dots().size(), nl1[i]->dots().size());
+                              for (int k = 0; k < nl1[i]->dots().size(); ++k)
+                                    QCOMPARE(nl2[i]->dots()[k]->pos(), nl1[i]->dots()[k]->pos());
+                              }
+                        if (cr1->dots() && voice == 0)
+                              ++dotted;
+                        }
+                  }
+            if (dotted > 1)
+                  ++shared;
+            }
+      QVERIFY(!s1 && !s2);
+      QVERIFY(shared > 0);
+      delete serial;
+      delete parallel;
+      }
+
+QTEST_MAIN(TestSegment)
+#include "tst_segment.moc"
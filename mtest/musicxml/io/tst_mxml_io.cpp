@@ -22,6 +22,7 @@
 
 namespace Ms {
       extern bool saveMxl(Score*, const QString&);
+      extern bool setMusicXmlValidation(const QString&);
       }
 
 #define DIR QString("musicxml/io/")
@@ -41,6 +42,7 @@ class TestMxmlIO : public QObject, public MTest
       void mxmlMscxExportTestRef(const char* file);
       void mxmlReadTestCompr(const char* file);
       void mxmlReadWriteTestCompr(const char* file);
+      void mxmlValidationTest(const char* file, const char* mode);
 
 
       // The list of MusicXML regression tests
@@ -98,6 +100,8 @@ private slots:
       void hello() { mxmlIoTest("testHello"); }
       void helloReadCompr() { mxmlReadTestCompr("testHello"); }
       void helloReadWriteCompr() { mxmlReadWriteTestCompr("testHello"); }
+      void helloValidateParallel() { mxmlValidationTest("testHello", "parallel"); }
+      void helloValidateOnError() { mxmlValidationTest("testHello", "on-error"); }
       void implicitMeasure1() { mxmlIoTest("testImplicitMeasure1"); }
       void incorrectStaffNumber1() { mxmlIoTestRef("testIncorrectStaffNumber1"); }
       void incorrectStaffNumber2() { mxmlIoTestRef("testIncorrectStaffNumber2"); }
@@ -347,5 +351,17 @@ void TestMxmlIO::mxmlReadWriteTestCompr(const char* file)
       delete score;
       }
 
+//---------------------------------------------------------
+//   mxmlValidationTest
+//   as mxmlIoTest, but validate in the given mode instead of before the import
+//---------------------------------------------------------
+
+void TestMxmlIO::mxmlValidationTest(const char* file, const char* mode)
+      {
+      QVERIFY(setMusicXmlValidation(mode));
+      mxmlIoTest(file);
+      setMusicXmlValidation("before");
+      }
+
 QTEST_MAIN(TestMxmlIO)
 #include "tst_mxml_io.moc"
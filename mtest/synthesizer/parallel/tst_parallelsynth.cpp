@@ -0,0 +1,149 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2
+//  as published by the Free Software Foundation and appearing in
+//  the file LICENCE.GPL
+//=============================================================================
+
+#include <QtTest/QtTest>
+
+#include "synthesizer/event.h"
+#include "synthesizer/msynthesizer.h"
+#include "synthesizer/synthesizer.h"
+
+using namespace Ms;
+
+static const int PERIOD  = 256;         // frames
+static const int SYNTHS  = 8;
+static const int PARTIALS = 32;
+
+//---------------------------------------------------------
+//   SineSynth
+//    adds up a number of sine partials; the output only
+//    depends on the frames rendered before
+//---------------------------------------------------------
+
+class SineSynth : public Synthesizer {
+      int _partials;
+      double _freq;
+      double _phase { 0.0 };
+      QList<MidiPatch*> _patches;
+
+   public:
+      SineSynth(int partials, double freq) : _partials(partials), _freq(freq) { setActive(true); }
+      virtual const char* name() const override                  { return "Sine"; }
+      virtual bool loadSoundFonts(const QStringList&) override   { return true; }
+      virtual QStringList soundFonts() const override            { return QStringList(); }
+      virtual void play(const PlayEvent&) override               {}
+      virtual const QList<MidiPatch*>& getPatchInfo() const override { return _patches; }
+      virtual SynthesizerGroup state() const override            { return SynthesizerGroup(); }
+      virtual bool setState(const SynthesizerGroup&) override    { return true; }
+
+      virtual void process(unsigned n, float* p, float*, float*) override
+            {
+            double step = 2.0 * M_PI * _freq / sampleRate();
+            for (unsigned i = 0; i < n; ++i) {
+                  float v = 0.0;
+                  for (int k = 1; k <= _partials; ++k)
+                        v += sin(_phase * k) / (k * SYNTHS);
+                  _phase += step;
+                  *p++ += v;
+                  *p++ += v;
+                  }
+            }
+      };
+
+//---------------------------------------------------------
+//   TestParallelSynth
+//---------------------------------------------------------
+
+class TestParallelSynth : public QObject
+      {
+      Q_OBJECT
+
+      MasterSynthesizer* master(bool parallel);
+
+   private slots:
+      void matchesSerial();
+      void render_data();
+      void render();
+      };
+
+//---------------------------------------------------------
+//   master
+//    a master synthesizer with SYNTHS sine synthesizers
+//    in the transport state PLAY
+//---------------------------------------------------------
+
+MasterSynthesizer* TestParallelSynth::master(bool parallel)
+      {
+      MasterSynthesizer* m = new MasterSynthesizer();
+      for (int i = 0; i < SYNTHS; ++i)
+            m->registerSynthesizer(new SineSynth(PARTIALS, 110.0 * (i + 1)));
+      m->setSampleRate(44100);
+      m->setParallel(parallel);
+      m->setPlaying(true);
+      return m;
+      }
+
+//---------------------------------------------------------
+//   matchesSerial
+//    the parallel path mixes the synthesizers in the same
+//    order as the serial one and must give the same samples
+//---------------------------------------------------------
+
+void TestParallelSynth::matchesSerial()
+      {
+      QScopedPointer<MasterSynthesizer> serial(master(false));
+      QScopedPointer<MasterSynthesizer> parallel(master(true));
+      if (!parallel->parallel())
+            QSKIP("the parallel path needs more than one core");
+
+      float out1[PERIOD * 2];
+      float out2[PERIOD * 2];
+      for (int period = 0; period < 500; ++period) {
+            memset(out1, 0, sizeof(out1));
+            memset(out2, 0, sizeof(out2));
+            serial->process(PERIOD, out1);
+            parallel->process(PERIOD, out2);
+            for (int i = 0; i < PERIOD * 2; ++i)
+                  QCOMPARE(out2[i], out1[i]);
+            }
+      }
+
+//---------------------------------------------------------
+//   render
+//    time to render one period serially and in parallel
+//---------------------------------------------------------
+
+void TestParallelSynth::render_data()
+      {
+      QTest::addColumn<bool>("parallel");
+      QTest::newRow("serial")   << false;
+      QTest::newRow("parallel") << true;
+      }
+
+void TestParallelSynth::render()
+      {
+      QFETCH(bool, parallel);
+
+      QScopedPointer<MasterSynthesizer> m(master(parallel));
+      if (parallel && !m->parallel())
+            QSKIP("the parallel path needs more than one core");
+
+      float out[PERIOD * 2];
+      QBENCHMARK {
+            memset(out, 0, sizeof(out));
+            m->process(PERIOD, out);
+            }
+      float peak = 0.0;
+      for (float v : out)
+            peak = qMax(peak, qAbs(v));
+      QVERIFY(peak > 0.0);
+      }
+
+QTEST_MAIN(TestParallelSynth)
+#include "tst_parallelsynth.moc"
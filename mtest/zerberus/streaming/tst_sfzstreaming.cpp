@@ -0,0 +1,125 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2
+//  as published by the Free Software Foundation and appearing in
+//  the file LICENCE.GPL
+//=============================================================================
+
+#include <QtTest/QtTest>
+
+#include "mtest/testutils.h"
+
+#include "zerberus/instrument.h"
+#include "zerberus/zerberus.h"
+#include "zerberus/zone.h"
+#include "zerberus/sample.h"
+#include "zerberus/stream.h"
+#include "mscore/preferences.h"
+#include "synthesizer/event.h"
+
+using namespace Ms;
+
+static const int FRAMES = 300;      // length of sample.wav
+static const int COMPARE_FRAMES = FRAMES - 4;   // the in memory copy pads the last frames
+
+//---------------------------------------------------------
+//   TestSfzStreaming
+//---------------------------------------------------------
+
+class TestSfzStreaming : public QObject, public MTest
+      {
+      Q_OBJECT
+      float samplerate = 44100;
+
+      void render(float* data, bool streaming, unsigned& underruns);
+
+   private slots:
+      void initTestCase();
+      void testBusyStream();
+      void testStreamedAudio();
+      };
+
+//---------------------------------------------------------
+//   initTestCase
+//---------------------------------------------------------
+
+void TestSfzStreaming::initTestCase()
+      {
+      initMTest();
+      preferences.setPreference(PREF_APP_PATHS_MYSOUNDFONTS, root);
+      }
+
+//---------------------------------------------------------
+//   testBusyStream
+//    a stream can not be started again before the disk
+//    thread has closed it; runs before any streamed sample
+//    is loaded, so the disk thread is not running yet
+//---------------------------------------------------------
+
+void TestSfzStreaming::testBusyStream()
+      {
+      SampleStream stream;
+      QVERIFY(stream.idle());
+      QVERIFY(stream.start(nullptr, 0));
+      QVERIFY(!stream.idle());
+      QVERIFY(!stream.start(nullptr, 0));
+      stream.stop();
+      QVERIFY(!stream.idle());
+      QVERIFY(!stream.start(nullptr, 0));
+      }
+
+//---------------------------------------------------------
+//   render
+//    play the whole sample once and get the stream underruns
+//---------------------------------------------------------
+
+void TestSfzStreaming::render(float* data, bool streaming, unsigned& underruns)
+      {
+      SampleStreamer::setEnabled(streaming);
+      SampleStreamer::setPreloadFrames(16);
+      Zerberus* synth = new Zerberus();
+      synth->init(samplerate);
+      synth->loadInstrument("streamingTest.sfz");
+      SampleStreamer::setEnabled(false);
+
+      Sample* sample = synth->instrument(0)->zones().front()->sample;
+      QCOMPARE(sample->streamed(), streaming);
+      QCOMPARE(sample->frames(), (long long) FRAMES);
+
+      synth->play(Ms::PlayEvent(ME_PROGRAM, 0, 0, 0));
+      synth->play(Ms::PlayEvent(ME_NOTEON, 0, 60, 127));
+      if (streaming)
+            SampleStreamer::instance()->flush();      // wait for the disk thread to fill the stream
+      synth->process(FRAMES, data, nullptr, nullptr);
+      underruns = Zerberus::streamUnderruns();
+      delete synth;
+      }
+
+//---------------------------------------------------------
+//   testStreamedAudio
+//    a streamed sample must sound like the one in memory
+//---------------------------------------------------------
+
+void TestSfzStreaming::testStreamedAudio()
+      {
+      float memory[FRAMES * 2];
+      float streamed[FRAMES * 2];
+      memset(memory, 0, sizeof(memory));
+      memset(streamed, 0, sizeof(streamed));
+
+      unsigned underruns;
+      render(memory, false, underruns);
+      render(streamed, true, underruns);
+      QCOMPARE(underruns, 0u);
+
+      QVERIFY(memory[102 * 2] != 0.0f);
+      for (int i = 0; i < COMPARE_FRAMES * 2; ++i)
+            QCOMPARE(streamed[i], memory[i]);
+      }
+
+QTEST_MAIN(TestSfzStreaming)
+
+#include "tst_sfzstreaming.moc"
@@ -0,0 +1,136 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2
+//  as published by the Free Software Foundation and appearing in
+//  the file LICENCE.GPL
+//=============================================================================
+
+#include <QtTest/QtTest>
+
+#include "mtest/testutils.h"
+
+#include "zerberus/instrument.h"
+#include "zerberus/zerberus.h"
+#include "zerberus/zone.h"
+#include "mscore/preferences.h"
+#include "synthesizer/event.h"
+
+using namespace Ms;
+
+static const int VELOCITY_LAYERS = 16;
+
+//---------------------------------------------------------
+//   TestSfzZoneIndex
+//---------------------------------------------------------
+
+class TestSfzZoneIndex : public QObject, public MTest
+      {
+      Q_OBJECT
+      float samplerate = 44100;
+      QTemporaryDir dir;
+      Zerberus* synth;
+
+   private slots:
+      void initTestCase();
+      void testZoneIndex();
+      void benchmarkTrigger();
+   public:
+      ~TestSfzZoneIndex();
+      };
+
+//---------------------------------------------------------
+//   initTestCase
+//    write an instrument with one region per key and
+//    velocity layer, some regions spanning several keys
+//    and a controller triggered region
+//---------------------------------------------------------
+
+void TestSfzZoneIndex::initTestCase()
+      {
+      initMTest();
+      QVERIFY(dir.isValid());
+      QVERIFY(QFile::copy(root + "/zerberus/sample.wav", dir.path() + "/sample.wav"));
+
+      QFile f(dir.path() + "/zoneIndexTest.sfz");
+      QVERIFY(f.open(QIODevice::WriteOnly));
+      QTextStream s(&f);
+      s << "<global>\nsample=sample.wav\nampeg_release=0\n";
+      for (int key = 0; key < 128; ++key) {
+            for (int layer = 0; layer < VELOCITY_LAYERS; ++layer) {
+                  int lo = layer * 128 / VELOCITY_LAYERS;
+                  int hi = (layer + 1) * 128 / VELOCITY_LAYERS - 1;
+                  s << "<region> key=" << key << " lovel=" << lo << " hivel=" << hi << "\n";
+                  }
+            }
+      for (int key = 0; key < 128; key += 12)
+            s << "<region> lokey=" << key << " hikey=" << qMin(key + 11, 127) << " lovel=100 hivel=127\n";
+      s << "<region> key=60 trigger=release\n";
+      s << "<region> on_locc64=64 on_hicc64=127\n";
+      f.close();
+
+      synth = new Zerberus();
+      synth->init(samplerate);
+      preferences.setPreference(PREF_APP_PATHS_MYSOUNDFONTS, dir.path());
+      QVERIFY(synth->loadInstrument("zoneIndexTest.sfz"));
+      }
+
+//---------------------------------------------------------
+//   testZoneIndex
+//    the index must list the same zones as a scan of all
+//    zones, in the same order
+//---------------------------------------------------------
+
+void TestSfzZoneIndex::testZoneIndex()
+      {
+      ZInstrument* instr = synth->instrument(0);
+      QCOMPARE(instr->zones().size(), size_t(128 * VELOCITY_LAYERS + 11 + 2));
+
+      for (Trigger t : { Trigger::ATTACK, Trigger::RELEASE }) {
+            for (int key = 0; key < 128; ++key) {
+                  for (int velo = 0; velo < 128; ++velo) {
+                        std::vector<Zone*> expected;
+                        for (Zone* z : instr->zones()) {
+                              if (z->trigger != Trigger::CC && key >= z->keyLo && key <= z->keyHi
+                                 && velo >= z->veloLo && velo <= z->veloHi)
+                                    expected.push_back(z);
+                              }
+                        QVERIFY(instr->zones(key, velo, t) == expected);
+                        }
+                  }
+            }
+      QCOMPARE(instr->zones(60, 64, Trigger::CC).size(), size_t(1));
+      QVERIFY(instr->zones(-1, 64, Trigger::ATTACK).empty());
+      }
+
+//---------------------------------------------------------
+//   benchmarkTrigger
+//    note on and off for every key at several velocities
+//---------------------------------------------------------
+
+void TestSfzZoneIndex::benchmarkTrigger()
+      {
+      float data[2 * 8];
+      synth->play(Ms::PlayEvent(ME_PROGRAM, 0, 0, 0));
+      QBENCHMARK {
+            for (int velo = 1; velo < 128; velo += 18) {
+                  for (int key = 0; key < 128; ++key) {
+                        synth->play(Ms::PlayEvent(ME_NOTEON, 0, key, velo));
+                        synth->play(Ms::PlayEvent(ME_NOTEON, 0, key, 0));
+                        }
+                  memset(data, 0, sizeof(data));
+                  synth->process(8, data, nullptr, nullptr);
+                  }
+            }
+      }
+
+TestSfzZoneIndex::~TestSfzZoneIndex()
+      {
+      delete synth;
+      }
+
+QTEST_MAIN(TestSfzZoneIndex)
+
+#include "tst_sfzzoneindex.moc"
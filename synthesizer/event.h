@@ -324,6 +324,7 @@ class EventMap : public std::multimap<int, NPlayEvent> {
    public:
       void fixupMIDI();
       void registerChannel(int c) { if (c > _highestChannel) _highestChannel = c; }
+      int highestChannel() const  { return _highestChannel; }
       };
 
 typedef EventList::iterator iEvent;
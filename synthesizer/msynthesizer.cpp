@@ -10,6 +10,10 @@
 //  the file LICENCE.GPL
 //=============================================================================
 
+#ifndef Q_OS_WIN
+#include <pthread.h>
+#endif
+
 #include "config.h"
 #include "event.h"
 #include "synthesizer.h"
@@ -64,6 +68,11 @@ void MasterSynthesizer::init()
 
 MasterSynthesizer::~MasterSynthesizer()
       {
+      _quitWorkers = true;
+      _work.release(int(_workers.size()));
+      for (std::thread& t : _workers)
+            t.join();
+      qDeleteAll(_jobs);
       for (Synthesizer* s : _synthesizer)
             delete s;
       for (int i = 0; i < MAX_EFFECTS; ++i) {
@@ -213,15 +222,9 @@ void MasterSynthesizer::setEffect(int ab, int idx)
             qDebug("MasterSynthesizer::setEffect: bad idx %d %d", ab, idx);
             return;
             }
-      lock2 = true;
-      while(lock1)
-#if (!defined (_MSCVER) && !defined (_MSC_VER))
-         sleep(1);
-#else
-         Sleep(1000);      // MS-equivalent function, time in ms instead of seconds.
-#endif
+      // effects are owned by _effectList, so the audio thread
+      // can finish a period with the old one
       _effect[ab] = _effectList[ab][idx];
-      lock2 = false;
       }
 
 //---------------------------------------------------------
@@ -248,8 +251,7 @@ void MasterSynthesizer::setSampleRate(float val)
             e->init(_sampleRate);
       for (Effect* e : _effectList[1])
             e->init(_sampleRate);
-      lock2 = false;
-      lock1 = false;
+      _ready = true;
       }
 
 //---------------------------------------------------------
@@ -258,37 +260,168 @@ void MasterSynthesizer::setSampleRate(float val)
 
 void MasterSynthesizer::process(unsigned n, float* p)
       {
-      if (lock2)
-            return;
-      lock1 = true;
-      if (lock2) {
-            lock1 = false;
+      if (!_ready)
             return;
-            }
       // avoid overflow
       if (n > MAX_BUFFERSIZE / 2)
             return;
-      for (Synthesizer* s : _synthesizer) {
-            if (s->active())
-                  s->process(n, p, effect1Buffer, effect2Buffer);
+      if (_parallel && _playing.load(std::memory_order_relaxed))
+            processParallel(n, p);
+      else {
+            for (Synthesizer* s : _synthesizer) {
+                  if (s->active())
+                        s->process(n, p, effect1Buffer, effect2Buffer);
+                  }
             }
 
-      if (_effect[0] && _effect[1]) {
+      Effect* e1 = _effect[0];
+      Effect* e2 = _effect[1];
+      if (e1 && e2) {
             memset(effect1Buffer, 0, n * sizeof(float) * 2);
-            _effect[0]->process(n, p, effect1Buffer);
-            _effect[1]->process(n, effect1Buffer, p);
+            e1->process(n, p, effect1Buffer);
+            e2->process(n, effect1Buffer, p);
             }
-      else if (_effect[0] || _effect[1]) {
+      else if (e1 || e2) {
             memcpy(effect1Buffer, p, n * sizeof(float) * 2);
-            if (_effect[0])
-                  _effect[0]->process(n, effect1Buffer, p);
+            if (e1)
+                  e1->process(n, effect1Buffer, p);
             else
-                  _effect[1]->process(n, effect1Buffer, p);
+                  e2->process(n, effect1Buffer, p);
             }
       float g = _gain * _boost;
-      for (unsigned i = 0; i < n * 2; ++i)
-            *p++ *= g;
-      lock1 = false;
+      unsigned samples = n * 2;
+      for (unsigned i = 0; i < samples; ++i)
+            p[i] *= g;
+      }
+
+//---------------------------------------------------------
+//   setParallel
+//    render the synthesizers on worker threads while the
+//    transport runs, see setPlaying(); must be called after
+//    all synthesizers are registered and before process()
+//    runs
+//---------------------------------------------------------
+
+void MasterSynthesizer::setParallel(bool val)
+      {
+      if (val == _parallel || !_workers.empty())
+            return;
+      int nworkers = qMin(int(_synthesizer.size()), int(std::thread::hardware_concurrency())) - 1;
+      if (!val || nworkers < 1)
+            return;
+      for (Synthesizer* s : _synthesizer)
+            _jobs.push_back(new SynthesizerJob(s));
+      for (int i = 0; i < nworkers; ++i)
+            _workers.emplace_back(&MasterSynthesizer::workerLoop, this);
+      _parallel = true;
+      }
+
+//---------------------------------------------------------
+//   setPlaying
+//    called by the audio thread; when the transport starts
+//    the workers take over its scheduling policy and
+//    priority, so that a job the audio thread waits for is
+//    not held up by threads of lower priority
+//---------------------------------------------------------
+
+void MasterSynthesizer::setPlaying(bool val)
+      {
+#ifndef Q_OS_WIN
+      if (val && _parallel && !_playing.load(std::memory_order_relaxed)) {
+            int policy;
+            struct sched_param param;
+            if (pthread_getschedparam(pthread_self(), &policy, &param) == 0)
+                  _sched.store(policy << 8 | (param.sched_priority & 0xff), std::memory_order_relaxed);
+            }
+#endif
+      _playing.store(val, std::memory_order_relaxed);
+      }
+
+//---------------------------------------------------------
+//   SynthesizerJob::tryRun
+//    render the synthesizer if the job is pending and
+//    not claimed by another thread
+//---------------------------------------------------------
+
+bool MasterSynthesizer::SynthesizerJob::tryRun()
+      {
+      int expected = PENDING;
+      if (!state.compare_exchange_strong(expected, RUNNING, std::memory_order_acquire))
+            return false;
+      memset(buffer, 0, frames * sizeof(float) * 2);
+      synthesizer->process(frames, buffer, effect1, effect2);
+      state.store(DONE, std::memory_order_release);
+      return true;
+      }
+
+//---------------------------------------------------------
+//   workerLoop
+//    sleep until jobs are posted, then claim them; the
+//    audio thread renders unclaimed jobs itself
+//---------------------------------------------------------
+
+void MasterSynthesizer::workerLoop()
+      {
+      int sched = -1;
+      for (;;) {
+            _work.acquire();
+            if (_quitWorkers.load(std::memory_order_relaxed))
+                  break;
+#ifndef Q_OS_WIN
+            if (sched != _sched.load(std::memory_order_relaxed)) {
+                  sched = _sched.load(std::memory_order_relaxed);
+                  struct sched_param param;
+                  memset(&param, 0, sizeof(param));
+                  param.sched_priority = sched & 0xff;
+                  if (pthread_setschedparam(pthread_self(), sched >> 8, &param) != 0)
+                        qDebug("MasterSynthesizer: cannot set the scheduling of a worker");
+                  }
+#endif
+            for (SynthesizerJob* j : _jobs)
+                  j->tryRun();
+            }
+      }
+
+//---------------------------------------------------------
+//   processParallel
+//    realtime thread; never waits for a worker to wake
+//    up: jobs which no worker has claimed yet are rendered
+//    here, only jobs already running are waited for. The
+//    workers run with the scheduling of the audio thread
+//    (see setPlaying()), so yielding lets a worker which
+//    shares the core finish its job.
+//---------------------------------------------------------
+
+void MasterSynthesizer::processParallel(unsigned n, float* p)
+      {
+      int posted = 0;
+      for (SynthesizerJob* j : _jobs) {
+            if (!j->synthesizer->active())
+                  continue;
+            j->frames = n;
+            j->state.store(SynthesizerJob::PENDING, std::memory_order_release);
+            ++posted;
+            }
+      // the audio thread takes one job itself; wakeups left over
+      // from earlier periods only cause an empty scan
+      int wake = qMin(posted - 1, int(_workers.size())) - _work.available();
+      if (wake > 0)
+            _work.release(wake);
+      // workers scan from the front, start at the back
+      for (auto i = _jobs.rbegin(); i != _jobs.rend(); ++i)
+            (*i)->tryRun();
+
+      unsigned samples = n * 2;
+      for (SynthesizerJob* j : _jobs) {
+            while (j->state.load(std::memory_order_acquire) == SynthesizerJob::RUNNING)
+                  std::this_thread::yield();
+            if (j->state.load(std::memory_order_relaxed) != SynthesizerJob::DONE)
+                  continue;
+            const float* src = j->buffer;
+            for (unsigned i = 0; i < samples; ++i)
+                  p[i] += src[i];
+            j->state.store(SynthesizerJob::IDLE, std::memory_order_relaxed);
+            }
       }
 
 //---------------------------------------------------------
@@ -309,9 +442,10 @@ int MasterSynthesizer::indexOfEffect(int ab, const QString& name)
 
 int MasterSynthesizer::indexOfEffect(int ab)
       {
-      if (!_effect[ab])
+      Effect* e = _effect[ab];
+      if (!e)
             return 0;
-      return indexOfEffect(ab, _effect[ab]->name());
+      return indexOfEffect(ab, e->name());
       }
 
 //---------------------------------------------------------
@@ -372,17 +506,19 @@ SynthesizerState MasterSynthesizer::state() const
       SynthesizerState ss;
       SynthesizerGroup g;
       g.setName("master");
-      g.push_back(IdValue(0, QString("%1").arg(_effect[0] ? _effect[0]->name() : "NoEffect")));
-      g.push_back(IdValue(1, QString("%1").arg(_effect[1] ? _effect[1]->name() : "NoEffect")));
+      Effect* e1 = _effect[0];
+      Effect* e2 = _effect[1];
+      g.push_back(IdValue(0, QString("%1").arg(e1 ? e1->name() : "NoEffect")));
+      g.push_back(IdValue(1, QString("%1").arg(e2 ? e2->name() : "NoEffect")));
       g.push_back(IdValue(2, QString("%1").arg(gain())));
       g.push_back(IdValue(3, QString("%1").arg(masterTuning())));
       ss.push_back(g);
       for (Synthesizer* s : _synthesizer)
             ss.push_back(s->state());
-      if (_effect[0])
-            ss.push_back(_effect[0]->state());
-      if (_effect[1])
-            ss.push_back(_effect[1]->state());
+      if (e1)
+            ss.push_back(e1->state());
+      if (e2)
+            ss.push_back(e2->state());
       return ss;
       }
 
@@ -426,5 +562,16 @@ void MasterSynthesizer::setMasterTuning(double val)
       for (Synthesizer* s : _synthesizer)
             s->setMasterTuning(_masterTuning);
       }
+
+//---------------------------------------------------------
+//   setRealtime
+//    the synthesizers are played by the audio driver
+//---------------------------------------------------------
+
+void MasterSynthesizer::setRealtime(bool val)
+      {
+      for (Synthesizer* s : _synthesizer)
+            s->setRealtime(val);
+      }
 }
 
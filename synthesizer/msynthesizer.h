@@ -14,6 +14,7 @@
 #define __MSYNTHESIZER_H__
 
 #include <atomic>
+#include <thread>
 #include "effects/effect.h"
 #include "libmscore/synthesizerstate.h"
 
@@ -42,11 +43,10 @@ class MasterSynthesizer : public QObject {
       static const int MAX_EFFECTS = 2;
 
    private:
-      std::atomic<bool> lock1      { false };
-      std::atomic<bool> lock2      { true  };
+      std::atomic<bool> _ready     { false };     // process() runs only after setSampleRate()
       std::vector<Synthesizer*> _synthesizer;
       std::vector<Effect*> _effectList[MAX_EFFECTS];
-      Effect* _effect[MAX_EFFECTS]  { nullptr, nullptr };
+      std::atomic<Effect*> _effect[MAX_EFFECTS]  { {nullptr}, {nullptr} };   // point into _effectList
 
       float _sampleRate;
 
@@ -54,6 +54,37 @@ class MasterSynthesizer : public QObject {
       float effect2Buffer[MAX_BUFFERSIZE];
       int indexOfEffect(int ab, const QString& name);
 
+      //---------------------------------------------------------
+      //   SynthesizerJob
+      //    renders one synthesizer into a private buffer,
+      //    run by whichever thread claims it first
+      //---------------------------------------------------------
+
+      struct SynthesizerJob {
+            enum { IDLE, PENDING, RUNNING, DONE };
+            Synthesizer* synthesizer;
+            std::atomic<int> state { IDLE };
+            unsigned frames        { 0 };
+            float buffer[MAX_BUFFERSIZE];
+            float effect1[MAX_BUFFERSIZE];
+            float effect2[MAX_BUFFERSIZE];
+
+            SynthesizerJob(Synthesizer* s) : synthesizer(s) {}
+            bool tryRun();
+            };
+
+      bool _parallel { false };
+      std::atomic<bool> _playing { false };     // workers only help while the transport runs
+      std::vector<SynthesizerJob*> _jobs;
+      std::vector<std::thread> _workers;
+      QSemaphore _work;                         // workers sleep on it until jobs are posted
+      std::atomic<bool> _quitWorkers { false };
+      std::atomic<int> _sched { -1 };           // policy << 8 | priority of the audio thread,
+                                                // adopted by the workers
+
+      void processParallel(unsigned, float*);
+      void workerLoop();
+
    public slots:
       void sfChanged() { emit soundFontChanged(); }
       void setGain(float f);
@@ -75,6 +106,11 @@ class MasterSynthesizer : public QObject {
       void process(unsigned, float*);
       void play(const NPlayEvent&, unsigned);
 
+      void setParallel(bool val);
+      bool parallel() const         { return _parallel; }
+      void setPlaying(bool val);
+      void setRealtime(bool val);
+
       void setMasterTuning(double val);
       double masterTuning() const      { return _masterTuning; }
 
@@ -41,6 +41,9 @@ class Synthesizer {
 
       virtual const char* name() const = 0;
 
+      // play() and process() are called by the audio driver
+      virtual void setRealtime(bool) {}
+
       virtual void setMasterTuning(double) {}
       virtual double masterTuning() const { return 440.0; }
 
@@ -23,6 +23,7 @@
 #include "instrument.h"
 #include "zone.h"
 #include "sample.h"
+#include "stream.h"
 
 QByteArray ZInstrument::buf;
 int ZInstrument::idx;
@@ -36,12 +37,78 @@ Sample::~Sample()
       delete[] _data;
       }
 
+//---------------------------------------------------------
+//   readStreamedSample
+//    read only the head of a sample file and leave the rest
+//    to the SampleStreamer; the head includes the loop if
+//    the zone loops. Return 0 if the sample is better
+//    kept in memory.
+//---------------------------------------------------------
+
+static Sample* readStreamedSample(const QString& path, bool looping, long long loopEnd)
+      {
+      SF_INFO info;
+      memset(&info, 0, sizeof(info));
+      SNDFILE* sf = sf_open(qPrintable(path), SFM_READ, &info);
+      if (!sf)
+            return 0;
+      SF_INSTRUMENT inst;
+      bool hasInstrument = sf_command(sf, SFC_GET_INSTRUMENT, &inst, sizeof(inst)) == SF_TRUE;
+      if (loopEnd == -1)
+            loopEnd = hasInstrument ? inst.loops[0].end : -1;
+
+      long long frames     = info.frames;
+      long long headFrames = SampleStreamer::preloadFrames();
+      if (looping && loopEnd > 0 && loopEnd < frames)
+            headFrames = std::max(headFrames, loopEnd + 3);
+
+      // ogg data may need normalization over the whole sample, see AudioFile::readData()
+      if ((info.format & SF_FORMAT_OGG) || headFrames >= frames) {
+            sf_close(sf);
+            return 0;
+            }
+
+      int channel = info.channels;
+      short* data = new short[(headFrames + 3) * channel];
+      Sample* sa  = new Sample(channel, data, frames, info.samplerate);
+      sa->setLoopStart(hasInstrument ? inst.loops[0].start : -1);
+      sa->setLoopEnd(hasInstrument ? inst.loops[0].end : -1);
+      sa->setLoopMode(hasInstrument ? inst.loops[0].mode : -1);
+      sa->setStreamed(path, headFrames);
+
+      // two more frames pad the head for the interpolation of a
+      // voice which plays only the head, see Voice::start()
+      long long padFrames = std::min(headFrames + 2, frames);
+      if (padFrames != sf_readf_short(sf, data + channel, padFrames)) {
+            qDebug("Sample read failed: %s\n", sf_strerror(sf));
+            delete sa;
+            sa = 0;
+            }
+      else {
+            for (int i = 0; i < channel; ++i) {
+                  data[i] = data[channel + i];
+                  for (long long f = padFrames; f < headFrames + 2; ++f)
+                        data[(f + 1) * channel + i] = data[padFrames * channel + i];
+                  }
+            SampleStreamer::instance()->start();
+            }
+      sf_close(sf);
+      return sa;
+      }
+
 //---------------------------------------------------------
 //   readSample
+//    looping and loopEnd describe the zone using the
+//    sample, they are only needed for streamed samples
 //---------------------------------------------------------
 
-Sample* ZInstrument::readSample(const QString& s, MQZipReader* uz)
+Sample* ZInstrument::readSample(const QString& s, MQZipReader* uz, bool looping, long long loopEnd)
       {
+      if (!uz && SampleStreamer::enabled()) {
+            Sample* sa = readStreamedSample(s, looping, loopEnd);
+            if (sa)
+                  return sa;
+            }
       if (uz) {
             QVector<MQZipReader::FileInfo> fi = uz->fileInfoList();
 
@@ -122,12 +189,89 @@ bool ZInstrument::load(const QString& path)
       instrumentPath = path;
       QFileInfo fi(path);
       _name = fi.completeBaseName();
+      bool ok;
       if (fi.isFile())
-            return loadFromFile(path);
-      if (fi.isDir())
-            return loadFromDir(path);
-      qDebug("not file nor dir %s", qPrintable(path));
-      return false;
+            ok = loadFromFile(path);
+      else if (fi.isDir())
+            ok = loadFromDir(path);
+      else {
+            qDebug("not file nor dir %s", qPrintable(path));
+            return false;
+            }
+      updateZoneIndex();
+      return ok;
+      }
+
+//---------------------------------------------------------
+//   updateZoneIndex
+//    For every key and velocity collect the zones whose
+//    key and velocity ranges contain it, so that a note
+//    event only has to look at the candidate zones.
+//    Equal candidate sets are shared between neighboring
+//    velocities and keys.
+//---------------------------------------------------------
+
+void ZInstrument::updateZoneIndex()
+      {
+      _zoneSets.clear();
+      _zoneSets.emplace_back();           // empty set
+      _zoneIndex.assign(128 * 128, 0);
+      _ccZones.clear();
+
+      std::vector<Zone*> keyZones;
+      std::vector<Zone*> set;
+      for (int key = 0; key < 128; ++key) {
+            keyZones.clear();
+            std::vector<bool> breakpoint(129, false);
+            for (Zone* z : _zones) {
+                  if (z->trigger == Trigger::CC || key < z->keyLo || key > z->keyHi)
+                        continue;
+                  keyZones.push_back(z);
+                  breakpoint[qBound(0, int(z->veloLo), 128)]    = true;
+                  breakpoint[qBound(0, z->veloHi + 1, 128)]     = true;
+                  }
+            if (keyZones.empty())
+                  continue;
+            int idx = 0;
+            for (int velo = 0; velo < 128; ++velo) {
+                  if (velo == 0 || breakpoint[velo]) {
+                        set.clear();
+                        for (Zone* z : keyZones) {
+                              if (velo >= z->veloLo && velo <= z->veloHi)
+                                    set.push_back(z);
+                              }
+                        if (set.empty())
+                              idx = 0;
+                        else if (key > 0 && _zoneSets[_zoneIndex[(key - 1) * 128 + velo]] == set)
+                              idx = _zoneIndex[(key - 1) * 128 + velo];
+                        else {
+                              _zoneSets.push_back(set);
+                              idx = _zoneSets.size() - 1;
+                              }
+                        }
+                  _zoneIndex[key * 128 + velo] = idx;
+                  }
+            }
+      for (Zone* z : _zones) {
+            if (z->trigger == Trigger::CC)
+                  _ccZones.push_back(z);
+            }
+      }
+
+//---------------------------------------------------------
+//   zones
+//    return the zones which may match a note event,
+//    in zone order
+//---------------------------------------------------------
+
+const std::vector<Zone*>& ZInstrument::zones(int key, int velo, Trigger trigger) const
+      {
+      static const std::vector<Zone*> noZones;
+      if (trigger == Trigger::CC)
+            return _ccZones;
+      if (key < 0 || key > 127 || velo < 0 || velo > 127 || _zoneIndex.empty())
+            return noZones;
+      return _zoneSets[_zoneIndex[key * 128 + velo]];
       }
 
 //---------------------------------------------------------
@@ -14,6 +14,7 @@
 #define __MINSTRUMENT_H__
 
 #include <list>
+#include <vector>
 #include <QString>
 
 class Zerberus;
@@ -22,6 +23,7 @@ class MQZipReader;
 struct Zone;
 struct SfzRegion;
 class Sample;
+enum class Trigger : char;
 
 //---------------------------------------------------------
 //   ZInstrument
@@ -36,6 +38,11 @@ class ZInstrument {
       std::list<Zone*> _zones;
       int _setcc[128];
 
+      // zone index, built after loading
+      std::vector<std::vector<Zone*>> _zoneSets;      // candidate zones in zone order
+      std::vector<int> _zoneIndex;                    // key * 128 + velocity -> _zoneSets index
+      std::vector<Zone*> _ccZones;                    // zones triggered by controllers
+
       bool loadFromFile(const QString&);
       bool loadSfz(const QString&);
       bool loadFromDir(const QString&);
@@ -53,9 +60,11 @@ class ZInstrument {
       QString path() const                  { return instrumentPath; }
       const std::list<Zone*>& zones() const { return _zones;  }
       std::list<Zone*>& zones()             { return _zones;  }
-      Sample* readSample(const QString& s, MQZipReader* uz);
+      Sample* readSample(const QString& s, MQZipReader* uz, bool looping = false, long long loopEnd = -1);
       void addZone(Zone* z)                 { _zones.push_back(z); }
       void addRegion(SfzRegion&);
+      void updateZoneIndex();
+      const std::vector<Zone*>& zones(int key, int velo, Trigger) const;
       int getSetCC(int v)                   { return _setcc[v]; }
 
       static QByteArray buf;  // used during read of Sample
@@ -25,10 +25,12 @@ class Sample {
       long long _loopStart;
       long long _loopEnd;
       int _loopMode;
+      QString _path;             // set if the sample is streamed from disk
+      long long _headFrames;     // frames held in memory
 
    public:
       Sample(int ch, short* val, int f, int sr)
-         : _channel(ch), _data(val), _frames(f), _sampleRate(sr) {}
+         : _channel(ch), _data(val), _frames(f), _sampleRate(sr), _headFrames(f) {}
       ~Sample();
       bool read(const QString&);
       long long frames() const     { return _frames;          }
@@ -42,6 +44,11 @@ class Sample {
       long long loopStart()           { return _loopStart; }
       long long loopEnd()             { return _loopEnd; }
       int loopMode()            { return _loopMode; }
+
+      void setStreamed(const QString& path, long long headFrames) { _path = path; _headFrames = headFrames; }
+      bool streamed() const           { return _headFrames < _frames; }
+      long long headFrames() const    { return _headFrames; }
+      const QString& path() const     { return _path; }
       };
 
 #endif
@@ -0,0 +1,331 @@
+//=============================================================================
+//  Zerberus
+//  Zample player
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2
+//  as published by the Free Software Foundation and appearing in
+//  the file LICENCE.GPL
+//=============================================================================
+
+#include "stream.h"
+#include "sample.h"
+
+bool SampleStreamer::_enabled            = false;
+long long SampleStreamer::_preloadFrames = 32768;
+
+//---------------------------------------------------------
+//   SampleStream
+//---------------------------------------------------------
+
+SampleStream::SampleStream()
+      {
+      SampleStreamer::instance()->add(this);
+      }
+
+SampleStream::~SampleStream()
+      {
+      SampleStreamer::instance()->remove(this);
+      close();
+      }
+
+//---------------------------------------------------------
+//   start
+//    realtime, request the sample data from index start
+//    on; return false if the stream is still in use by
+//    a previous request
+//---------------------------------------------------------
+
+bool SampleStream::start(const Sample* s, long long start)
+      {
+      if (_state.load(std::memory_order_acquire) != State::IDLE)
+            return false;
+      _sample  = s;
+      _start   = start;
+      _starved = false;
+      _state.store(State::REQUESTED, std::memory_order_release);
+      SampleStreamer::instance()->wake();
+      return true;
+      }
+
+//---------------------------------------------------------
+//   stop
+//    realtime
+//---------------------------------------------------------
+
+void SampleStream::stop()
+      {
+      State s = State::REQUESTED;
+      if (!_state.compare_exchange_strong(s, State::RELEASED)) {
+            s = State::ACTIVE;
+            if (!_state.compare_exchange_strong(s, State::RELEASED))
+                  return;
+            }
+      SampleStreamer::instance()->wake();
+      }
+
+//---------------------------------------------------------
+//   setReadPos
+//    realtime, called once per processed block with the
+//    lowest index the voice may read from now on
+//---------------------------------------------------------
+
+void SampleStream::setReadPos(long long idx)
+      {
+      if (_starved) {
+            ++_underruns;
+            _starved = false;
+            }
+      if (_state.load(std::memory_order_acquire) != State::ACTIVE)
+            return;
+      if (idx > _readPos.load(std::memory_order_relaxed)) {
+            _readPos.store(idx, std::memory_order_release);
+            SampleStreamer::instance()->wake();     // there is room in the ring
+            }
+      }
+
+//---------------------------------------------------------
+//   open
+//    disk thread
+//---------------------------------------------------------
+
+void SampleStream::open()
+      {
+      if (_ring.empty()) {
+            _ring.resize(RING_SIZE);
+            _chunk.resize(FILL_SIZE);
+            }
+      _channels = _sample->channel();
+      _tail.resize(_channels);
+      _end      = _sample->frames() * _channels;
+      _fileEnd  = _end;
+      _readPos.store(_start, std::memory_order_relaxed);
+      _writePos.store(_start, std::memory_order_relaxed);
+
+      SF_INFO info;
+      memset(&info, 0, sizeof(info));
+      _sf = sf_open(qPrintable(_sample->path()), SFM_READ, &info);
+      if (!_sf || sf_seek(_sf, _start / _channels, SEEK_SET) < 0) {
+            qDebug("SampleStream: cannot stream <%s>", qPrintable(_sample->path()));
+            _fileEnd = _start;
+            }
+      }
+
+//---------------------------------------------------------
+//   close
+//    disk thread
+//---------------------------------------------------------
+
+void SampleStream::close()
+      {
+      if (_sf) {
+            sf_close(_sf);
+            _sf = 0;
+            }
+      }
+
+//---------------------------------------------------------
+//   fill
+//    disk thread, read the next chunk into the ring
+//    return true if data was read
+//---------------------------------------------------------
+
+bool SampleStream::fill()
+      {
+      long long w = _writePos.load(std::memory_order_relaxed);
+      long long r = _readPos.load(std::memory_order_acquire);
+      if (r > w && w < _fileEnd) {
+            // the voice ran ahead of the disk, skip what it missed
+            if (sf_seek(_sf, r / _channels, SEEK_SET) < 0) {
+                  _fileEnd = w;
+                  return false;
+                  }
+            w = r;
+            }
+      long long n = std::min(std::min(RING_SIZE - (w - r), (long long)FILL_SIZE), _fileEnd - w);
+      int frames  = n / _channels;
+      if (frames <= 0)
+            return false;
+      sf_count_t rframes = sf_readf_short(_sf, _chunk.data(), frames);
+      if (rframes <= 0) {
+            _fileEnd = w;
+            return false;
+            }
+      n = rframes * _channels;
+      for (long long i = 0; i < n; ++i)
+            _ring[(w + i) & (RING_SIZE - 1)] = _chunk[i];
+      if (w + n == _end) {
+            for (int i = 0; i < _channels; ++i)
+                  _tail[i] = _chunk[n - _channels + i];
+            }
+      _writePos.store(w + n, std::memory_order_release);
+      return true;
+      }
+
+//---------------------------------------------------------
+//   service
+//    disk thread, return true if there was work to do
+//---------------------------------------------------------
+
+bool SampleStream::service()
+      {
+      switch (_state.load(std::memory_order_acquire)) {
+            case State::IDLE:
+                  return false;
+            case State::REQUESTED: {
+                  open();
+                  State s = State::REQUESTED;
+                  if (!_state.compare_exchange_strong(s, State::ACTIVE)) {
+                        // released before it was opened
+                        close();
+                        _state.store(State::IDLE, std::memory_order_release);
+                        }
+                  return true;
+                  }
+            case State::ACTIVE:
+                  return fill();
+            case State::RELEASED:
+                  close();
+                  _state.store(State::IDLE, std::memory_order_release);
+                  return false;
+            }
+      return false;
+      }
+
+//---------------------------------------------------------
+//   SampleStreamer
+//---------------------------------------------------------
+
+SampleStreamer::~SampleStreamer()
+      {
+      _quit = true;
+      _wake.release();
+      if (_thread.joinable())
+            _thread.join();
+      }
+
+//---------------------------------------------------------
+//   instance
+//---------------------------------------------------------
+
+SampleStreamer* SampleStreamer::instance()
+      {
+      static SampleStreamer streamer;
+      return &streamer;
+      }
+
+//---------------------------------------------------------
+//   add
+//---------------------------------------------------------
+
+void SampleStreamer::add(SampleStream* s)
+      {
+      std::lock_guard<std::mutex> lock(_mutex);
+      _streams.push_back(s);
+      }
+
+//---------------------------------------------------------
+//   remove
+//    wait until the disk thread is done with s
+//---------------------------------------------------------
+
+void SampleStreamer::remove(SampleStream* s)
+      {
+      std::unique_lock<std::mutex> lock(_mutex);
+      _serviced.wait(lock, [this, s]() { return _current != s; });
+      _streams.erase(std::remove(_streams.begin(), _streams.end(), s), _streams.end());
+      }
+
+//---------------------------------------------------------
+//   start
+//    start the disk thread; called when the first
+//    streamed sample is loaded
+//---------------------------------------------------------
+
+void SampleStreamer::start()
+      {
+      std::lock_guard<std::mutex> lock(_mutex);
+      if (!_thread.joinable())
+            _thread = std::thread(&SampleStreamer::run, this);
+      }
+
+//---------------------------------------------------------
+//   wake
+//    realtime, a stream has work for the disk thread;
+//    the semaphore is released only once until the disk
+//    thread starts its next pass
+//---------------------------------------------------------
+
+void SampleStreamer::wake()
+      {
+      if (!_wakePending.exchange(true, std::memory_order_acq_rel))
+            _wake.release();
+      }
+
+//---------------------------------------------------------
+//   flush
+//    wait until the disk thread made a pass over all
+//    streams, started after this call, which found no
+//    work: all requested data is in the rings
+//---------------------------------------------------------
+
+void SampleStreamer::flush()
+      {
+      std::unique_lock<std::mutex> lock(_mutex);
+      if (!_thread.joinable())
+            return;
+      unsigned pass = _pass;
+      wake();
+      _serviced.wait(lock, [this, pass]() { return int(_idlePass - pass) > 0; });
+      }
+
+//---------------------------------------------------------
+//   underruns
+//    number of processed blocks in which a voice did not
+//    get its data from disk in time
+//---------------------------------------------------------
+
+unsigned SampleStreamer::underruns()
+      {
+      std::lock_guard<std::mutex> lock(_mutex);
+      unsigned n = 0;
+      for (SampleStream* s : _streams)
+            n += s->underruns();
+      return n;
+      }
+
+//---------------------------------------------------------
+//   run
+//    disk thread; the streams are serviced without the
+//    lock, remove() waits for the current one. Sleeps
+//    until a stream calls wake() when a pass found no
+//    work.
+//---------------------------------------------------------
+
+void SampleStreamer::run()
+      {
+      for (;;) {
+            _wakePending.store(false, std::memory_order_release);
+            std::unique_lock<std::mutex> lock(_mutex);
+            if (_quit)
+                  break;
+            unsigned pass = ++_pass;
+            bool busy = false;
+            for (size_t i = 0; i < _streams.size(); ++i) {
+                  SampleStream* s = _streams[i];
+                  _current = s;
+                  lock.unlock();
+                  busy |= s->service();
+                  lock.lock();
+                  _current = 0;
+                  _serviced.notify_all();
+                  }
+            if (!busy) {
+                  _idlePass = pass;
+                  _serviced.notify_all();
+                  }
+            lock.unlock();
+            if (!busy)
+                  _wake.acquire();
+            }
+      }
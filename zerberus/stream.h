@@ -0,0 +1,152 @@
+//=============================================================================
+//  Zerberus
+//  Zample player
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2
+//  as published by the Free Software Foundation and appearing in
+//  the file LICENCE.GPL
+//=============================================================================
+
+#ifndef __STREAM_H__
+#define __STREAM_H__
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <sndfile.h>
+
+class Sample;
+
+//---------------------------------------------------------
+//   SampleStream
+//    Ring buffer which feeds a voice with the part of a
+//    streamed sample behind the preloaded head.
+//
+//    The audio thread requests, reads and releases the
+//    stream without blocking; the disk thread of the
+//    SampleStreamer opens the sample file and fills the
+//    ring ahead of the read position.
+//    Indices are interleaved sample indices into the
+//    whole sample, as in Sample::data().
+//---------------------------------------------------------
+
+class SampleStream {
+      enum class State : char {
+            IDLE,             // free, may be requested by the audio thread
+            REQUESTED,        // waiting for the disk thread to open the file
+            ACTIVE,           // disk thread fills the ring
+            RELEASED          // voice is done, disk thread closes the file
+            };
+      static const int RING_SIZE = 1 << 17;     // shorts, must be a power of two
+      static const int FILL_SIZE = 8192;        // shorts read per disk access
+
+      std::atomic<State> _state { State::IDLE };
+
+      // written by the audio thread while IDLE
+      const Sample* _sample = 0;
+      long long _start      = 0;    // first index served by the ring
+
+      // written by the disk thread before the stream becomes ACTIVE
+      long long _end        = 0;    // index past the end of the sample
+      std::vector<short> _ring;
+
+      std::atomic<long long> _readPos  { 0 };   // lowest index the voice still needs
+      std::atomic<long long> _writePos { 0 };   // index past the last one in the ring
+
+      // audio thread only
+      bool _starved         = false;
+      std::atomic<unsigned> _underruns { 0 };
+
+      // disk thread only; _channels and _tail are read by the
+      // audio thread once the stream is ACTIVE and the last
+      // frame is in the ring
+      SNDFILE* _sf          = 0;
+      int _channels         = 1;
+      long long _fileEnd    = 0;
+      std::vector<short> _chunk;
+      std::vector<short> _tail;           // last frame, repeated past the end
+
+      void open();
+      void close();
+      bool fill();
+      bool service();
+
+      friend class SampleStreamer;
+
+   public:
+      SampleStream();
+      ~SampleStream();
+
+      bool start(const Sample*, long long start);
+      void stop();
+      bool idle() const { return _state.load(std::memory_order_acquire) == State::IDLE; }
+      void setReadPos(long long idx);
+      unsigned underruns() const { return _underruns; }
+
+      //---------------------------------------------------
+      //   value
+      //    realtime, return 0 if the disk thread did not
+      //    provide the data in time; past the end of the
+      //    sample the last frame is repeated for the
+      //    interpolation
+      //---------------------------------------------------
+
+      short value(long long idx) {
+            if (_state.load(std::memory_order_acquire) == State::ACTIVE) {
+                  long long w = _writePos.load(std::memory_order_acquire);
+                  if (idx >= _end)
+                        return w >= _end ? _tail[(idx - _end) % _channels] : 0;
+                  if (idx >= _start && idx < w)
+                        return _ring[idx & (RING_SIZE - 1)];
+                  }
+            _starved = true;
+            return 0;
+            }
+      };
+
+//---------------------------------------------------------
+//   SampleStreamer
+//    Disk reader thread serving the streams of all voices.
+//
+//    With streaming enabled, samples loaded from files
+//    keep only a head of preloadFrames() in memory.
+//---------------------------------------------------------
+
+class SampleStreamer {
+      static bool _enabled;
+      static long long _preloadFrames;
+
+      std::mutex _mutex;                  // protects the members up to _idlePass, never held during disk access
+      std::condition_variable _serviced;  // _current or _idlePass changed
+      std::vector<SampleStream*> _streams;
+      SampleStream* _current = 0;         // stream the disk thread works on
+      unsigned _pass         = 0;         // number of the current pass over _streams
+      unsigned _idlePass     = 0;         // last pass which found no work
+      std::thread _thread;
+      std::atomic<bool> _quit { false };
+      QSemaphore _wake;                   // the disk thread sleeps on it while there is no work
+      std::atomic<bool> _wakePending { false };
+
+      void run();
+
+   public:
+      ~SampleStreamer();
+      static SampleStreamer* instance();
+
+      void add(SampleStream*);
+      void remove(SampleStream*);
+      void start();
+      void wake();
+      void flush();
+      unsigned underruns();
+
+      static bool enabled()                      { return _enabled;       }
+      static void setEnabled(bool val)           { _enabled = val;        }
+      static long long preloadFrames()           { return _preloadFrames; }
+      static void setPreloadFrames(long long val) { _preloadFrames = val;  }
+      };
+
+#endif
@@ -97,9 +97,25 @@ void Voice::start(Channel* c, int key, int v, const Zone* zone, double durSinceN
       _velocity = v;
       Sample* s = z->sample;
       audioChan = s->channel();
-      data      = s->data() + z->offset * audioChan;
+      _dataOffset = z->offset * audioChan;
+      data      = s->data() + _dataOffset;
       //avoid processing sample if offset is bigger than sample length
       eidx      = std::max((s->frames() - z->offset - 1) * audioChan, 0ll);
+      _streamIdx = std::numeric_limits<long long>::max();
+      _streaming = false;
+      if (s->streamed()) {
+            long long head = s->headFrames() * audioChan;
+            // the stream may still be busy with the previous note if
+            // VoiceFifo::pop() found no free voice with an idle stream:
+            // end with the head, which is padded for the interpolation,
+            // instead of playing a silent tail
+            if (_stream.start(s, std::max(head, _dataOffset))) {
+                  _streamIdx = head - _dataOffset;
+                  _streaming = true;
+                  }
+            else
+                  eidx = std::max(std::min(eidx, head - _dataOffset - audioChan), 0ll);
+            }
       _loopMode = z->loopMode;
       _loopStart = z->loopStart;
       _loopEnd   = z->loopEnd;
@@ -288,6 +304,10 @@ void Voice::process(int frames, float* p)
                   _samplesSinceStart++;
                   }
             }
+      if (_streaming && !isOff()) {
+            // the interpolation reads one frame back
+            _stream.setReadPos(phase.index() * audioChan + _dataOffset - audioChan);
+            }
       }
 
 //---------------------------------------------------------
@@ -316,8 +336,11 @@ short Voice::getData(long long pos) {
       if (pos < 0 && !_looping)
             return 0;
 
-      if (!_looping)
+      if (!_looping) {
+            if (pos >= _streamIdx)
+                  return _stream.value(pos + _dataOffset);
             return data[pos];
+            }
 
       long long loopEnd = _loopEnd * audioChan;
       long long loopStart = _loopStart * audioChan;
@@ -16,6 +16,7 @@
 #include <cstdint>
 #include <math.h>
 #include "filter.h"
+#include "stream.h"
 
 // Disable warning C4201: nonstandard extension used: nameless struct/union in VS2017
 #if (defined (_MSCVER) || defined (_MSC_VER))
@@ -127,6 +128,10 @@ class Voice {
 
       short* data;
       long long eidx;
+      long long _streamIdx;         // first index of data() read from _stream
+      long long _dataOffset;        // index of data() in the sample
+      bool _streaming = false;
+      SampleStream _stream;
       LoopMode _loopMode;
       OffMode _offMode;
       int _offBy;
@@ -158,6 +163,8 @@ class Voice {
       void process(int frames, float*);
       void updateLoop();
       short getData(long long pos);
+      unsigned streamUnderruns() const { return _stream.underruns(); }
+      bool streamIdle() const          { return _stream.idle(); }
 
       Channel* channel() const    { return _channel; }
       int key() const             { return _key;     }
@@ -170,7 +177,7 @@ class Voice {
       void stop()                 { envelopes[currentEnvelope].step(); envelopes[V1Envelopes::RELEASE].max = envelopes[currentEnvelope].val; currentEnvelope = V1Envelopes::RELEASE; _state = VoiceState::STOP;      }
       void stop(float time);
       void sustained()            { _state = VoiceState::SUSTAINED; }
-      void off()                  { _state = VoiceState::OFF;       }
+      void off()                  { _state = VoiceState::OFF; if (_streaming) _stream.stop(); }
       const char* state() const;
       LoopMode loopMode() const   { return _loopMode; }
       int getSamplesSinceStart()  { return _samplesSinceStart;    }
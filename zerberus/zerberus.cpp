@@ -20,6 +20,7 @@
 #include "channel.h"
 #include "instrument.h"
 #include "zone.h"
+#include "sample.h"
 
 #include <stdio.h>
 
@@ -36,6 +37,25 @@ Ms::Synthesizer* createZerberus()
       return new Zerberus();
       }
 
+//---------------------------------------------------------
+//   setZerberusSampleStreaming
+//    must be called before instruments are loaded
+//---------------------------------------------------------
+
+void setZerberusSampleStreaming(bool val)
+      {
+      SampleStreamer::setEnabled(val);
+      }
+
+//---------------------------------------------------------
+//   streamUnderruns
+//---------------------------------------------------------
+
+unsigned Zerberus::streamUnderruns()
+      {
+      return SampleStreamer::instance()->underruns();
+      }
+
 //---------------------------------------------------------
 //   Zerberus
 //---------------------------------------------------------
@@ -96,7 +116,7 @@ void Zerberus::trigger(Channel* channel, int key, int velo, Trigger trigger, int
       {
       ZInstrument* i = channel->instrument();
       double random = (double) rand() / (double) RAND_MAX;
-      for (Zone* z : i->zones()) {
+      for (Zone* z : i->zones(key, velo, trigger)) {
             if (z->match(channel, key, velo, trigger, random, cc, ccVal)) {
                   //
                   // handle offBy voices
@@ -117,7 +137,7 @@ void Zerberus::trigger(Channel* channel, int key, int velo, Trigger trigger, int
                         return;
                         }
 
-                  Voice* voice = freeVoices.pop();
+                  Voice* voice = z->sample->streamed() ? freeVoices.popStreaming() : freeVoices.pop();
                   Q_ASSERT(voice->isOff());
                   voice->start(channel, key, velo, z, durSinceNoteOn);
                   voice->setNext(activeVoices);
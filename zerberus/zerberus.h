@@ -64,6 +64,17 @@ class VoiceFifo {
             return v;
             }
 
+      // a voice for a streamed sample: skip voices whose stream the disk
+      // thread has not closed yet, unless no other voice is free
+      Voice* popStreaming() {
+            for (size_t i = 1; i < buffer.size(); ++i) {
+                  if (buffer.front()->streamIdle())
+                        break;
+                  buffer.push(pop());
+                  }
+            return pop();
+            }
+
       bool empty() const { return buffer.empty(); }
       };
 
@@ -133,6 +144,7 @@ class Zerberus : public Ms::Synthesizer {
 
       virtual Ms::SynthesizerGui* gui();
       static QFileInfoList sfzFiles();
+      static unsigned streamUnderruns();
       };
 
 #endif